@@ -0,0 +1,278 @@
+/**
+ * Command line driver: colours a single graph and writes the colouring and a JSON summary.
+ *
+ * Usage: colour <graph file> [--algorithm hca|xrlf|dsatur] [--output <colouring file>] [--json <summary file>]
+ *               [--threads <n>] [--time-limit <ms>] [--seed <n>] [--deterministic] [--clique-time-limit <ms>]
+ *               [--no-reduction] [--no-components] [--k <n>] [--population <n>] [--iterations <n>] [--L <n>]
+ *               [--A <n>] [--alpha <x>] [--exactlim <n>] [--trialnum <n>] [--setlim <n>] [--candnum <n>]
+ *
+ * The graph is read in METIS format, as DIMACS file (.col, .col.gz, .col.zst) or as binary CSR file (.csr, see
+ * graph_io::writeGraphBinary). HCA starts with the given k or the number of colours of a DSatur colouring and
+ * returns the DSatur colouring if it does not find a better one. It stops as soon as it reaches the size of a
+ * clique found within the clique time limit (1000 ms by default, zero disables the clique search). The colouring
+ * file contains the colour of node i in line i + 1. The summary is written to standard output if no JSON file is
+ * given. Unless --no-reduction is given, HCA colours the kernel of the graph (see GraphReduction), and unless
+ * --no-components is given, it colours its connected components independently.
+ */
+
+#include "data_structure/io/graph_cache.h"
+#include "colouring/hca.h"
+#include "colouring/init/dsatur.h"
+#include "colouring/init/xrlf.h"
+#include "colouring/verification.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace graph_colouring;
+
+struct ColourParameters {
+    std::string graphFile;
+    std::string algorithm = "hca";
+    std::string output;
+    std::string json;
+    size_t threadCount = std::thread::hardware_concurrency();
+    std::chrono::milliseconds timeLimit = std::chrono::milliseconds(0);
+    uint64_t seed = 0;
+    bool deterministic = false;
+    //HCA
+    std::chrono::milliseconds cliqueTimeLimit = std::chrono::milliseconds(1000);
+    bool reduceGraph = true;
+    bool decomposeComponents = true;
+    ColorCount k = 0;
+    size_t populationSize = 0;
+    size_t maxItr = 1000;
+    size_t L = 100;
+    size_t A = 2;
+    double alpha = 0.6;
+    //XRLF
+    xrlf::XRLFParameters xrlf;
+};
+
+static bool hasSuffix(const std::string &name, const std::string &suffix) {
+    return name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+static bool parseArguments(int argc, const char *argv[], ColourParameters &parameters) {
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string argument = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (argument == "--algorithm" && hasValue) {
+                parameters.algorithm = argv[++i];
+            } else if (argument == "--output" && hasValue) {
+                parameters.output = argv[++i];
+            } else if (argument == "--json" && hasValue) {
+                parameters.json = argv[++i];
+            } else if (argument == "--threads" && hasValue) {
+                parameters.threadCount = std::stoul(argv[++i]);
+            } else if (argument == "--time-limit" && hasValue) {
+                parameters.timeLimit = std::chrono::milliseconds(std::stoul(argv[++i]));
+            } else if (argument == "--seed" && hasValue) {
+                parameters.seed = std::stoull(argv[++i]);
+            } else if (argument == "--deterministic") {
+                parameters.deterministic = true;
+            } else if (argument == "--clique-time-limit" && hasValue) {
+                parameters.cliqueTimeLimit = std::chrono::milliseconds(std::stoul(argv[++i]));
+            } else if (argument == "--no-reduction") {
+                parameters.reduceGraph = false;
+            } else if (argument == "--no-components") {
+                parameters.decomposeComponents = false;
+            } else if (argument == "--k" && hasValue) {
+                parameters.k = std::stoul(argv[++i]);
+            } else if (argument == "--population" && hasValue) {
+                parameters.populationSize = std::stoul(argv[++i]);
+            } else if (argument == "--iterations" && hasValue) {
+                parameters.maxItr = std::stoul(argv[++i]);
+            } else if (argument == "--L" && hasValue) {
+                parameters.L = std::stoul(argv[++i]);
+            } else if (argument == "--A" && hasValue) {
+                parameters.A = std::stoul(argv[++i]);
+            } else if (argument == "--alpha" && hasValue) {
+                parameters.alpha = std::stod(argv[++i]);
+            } else if (argument == "--exactlim" && hasValue) {
+                parameters.xrlf.EXACTLIM = std::stoul(argv[++i]);
+            } else if (argument == "--trialnum" && hasValue) {
+                parameters.xrlf.TRIALNUM = std::stoul(argv[++i]);
+            } else if (argument == "--setlim" && hasValue) {
+                parameters.xrlf.SETLIM = std::stoul(argv[++i]);
+            } else if (argument == "--candnum" && hasValue) {
+                parameters.xrlf.CANDNUM = std::stoul(argv[++i]);
+            } else if (parameters.graphFile.empty() && argument[0] != '-') {
+                parameters.graphFile = argument;
+            } else {
+                return false;
+            }
+        }
+    } catch (const std::exception &) {
+        return false;
+    }
+    parameters.threadCount = std::max<size_t>(1, parameters.threadCount);
+    //perform requires at least four colourings per worker thread
+    parameters.populationSize = std::max(parameters.populationSize, 4 * parameters.threadCount);
+    bool knownAlgorithm = parameters.algorithm == "hca" || parameters.algorithm == "xrlf"
+                          || parameters.algorithm == "dsatur";
+    return !parameters.graphFile.empty() && knownAlgorithm && parameters.maxItr > 0 && parameters.A > 0;
+}
+
+static int readGraph(graph_access &G, const std::string &filename) {
+    if (hasSuffix(filename, ".csr")) {
+        return graph_io::readGraphBinary(G, filename);
+    }
+    return graph_io::readGraph(G, filename);
+}
+
+static int writeColouring(const std::string &filename, const Colouring &s) {
+    std::ofstream out(filename.c_str());
+    if (!out) {
+        std::cerr << "Error opening " << filename << std::endl;
+        return 1;
+    }
+    for (auto c : s) {
+        out << c << "\n";
+    }
+    out.close();
+    if (!out) {
+        std::cerr << "Error writing " << filename << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+static void writeSummary(std::ostream &out,
+                         const ColourParameters &parameters,
+                         const graph_access &G,
+                         const Colouring &s,
+                         const InstrumentationStats &stats,
+                         const double loadSeconds,
+                         const double colouringSeconds) {
+    auto analysis = analyzeColouring(G, s, parameters.threadCount);
+    out << std::setprecision(6);
+    out << "{\n  \"graph\": \"" << parameters.graphFile << "\""
+        << ",\n  \"nodes\": " << G.number_of_nodes()
+        << ",\n  \"edges\": " << G.number_of_edges() / 2
+        << ",\n  \"algorithm\": \"" << parameters.algorithm << "\""
+        << ",\n  \"parameters\": {\"threads\": " << parameters.threadCount
+        << ", \"time_limit_ms\": " << parameters.timeLimit.count()
+        << ", \"seed\": " << parameters.seed
+        << ", \"deterministic\": " << (parameters.deterministic ? "true" : "false");
+    if (parameters.algorithm == "hca") {
+        out << ", \"clique_time_limit_ms\": " << parameters.cliqueTimeLimit.count()
+            << ", \"reduce_graph\": " << (parameters.reduceGraph ? "true" : "false")
+            << ", \"decompose_components\": " << (parameters.decomposeComponents ? "true" : "false")
+            << ", \"k\": " << parameters.k
+            << ", \"population\": " << parameters.populationSize
+            << ", \"iterations\": " << parameters.maxItr
+            << ", \"L\": " << parameters.L
+            << ", \"A\": " << parameters.A
+            << ", \"alpha\": " << parameters.alpha;
+    } else if (parameters.algorithm == "xrlf") {
+        out << ", \"EXACTLIM\": " << parameters.xrlf.EXACTLIM
+            << ", \"TRIALNUM\": " << parameters.xrlf.TRIALNUM
+            << ", \"SETLIM\": " << parameters.xrlf.SETLIM
+            << ", \"CANDNUM\": " << parameters.xrlf.CANDNUM;
+    }
+    out << "}"
+        << ",\n  \"k\": " << analysis.k
+        << ",\n  \"valid\": " << (analysis.isValid() ? "true" : "false")
+        << ",\n  \"conflicting_edges\": " << analysis.conflictingEdges
+        << ",\n  \"uncoloured_nodes\": " << analysis.uncolouredNodes
+        << ",\n  \"load_s\": " << loadSeconds
+        << ",\n  \"colouring_s\": " << colouringSeconds
+        << ",\n  \"operator_stats\": ";
+    if (!stats.enabled) {
+        out << "null";
+    } else {
+        out << "{";
+        for (size_t r = 0; r < REGION_COUNT; r++) {
+            out << "\"" << regionName(InstrumentedRegion(r)) << "\": {\"calls\": " << stats.calls[r]
+                << ", \"seconds\": " << stats.seconds[r] << "}, ";
+        }
+        out << "\"packages\": " << stats.packages
+            << ", \"discarded_packages\": " << stats.discardedPackages
+            << ", \"parent_selections\": " << stats.parentSelections
+            << ", \"parent_retries\": " << stats.parentRetries << "}";
+    }
+    out << "\n}\n";
+}
+
+int main(int argc, const char *argv[]) {
+    ColourParameters parameters;
+    if (!parseArguments(argc, argv, parameters)) {
+        std::cerr << "Usage: " << argv[0] << " <graph file> [--algorithm hca|xrlf|dsatur] [--output <file>]"
+                  << " [--json <file>] [--threads <n>] [--time-limit <ms>] [--seed <n>] [--deterministic]"
+                  << " [--clique-time-limit <ms>] [--no-reduction] [--no-components]"
+                  << " [--k <n>] [--population <n>] [--iterations <n>] [--L <n>] [--A <n>] [--alpha <x>]"
+                  << " [--exactlim <n>] [--trialnum <n>] [--setlim <n>] [--candnum <n>]\n";
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    graph_access G;
+    if (readGraph(G, parameters.graphFile) != 0) {
+        std::cerr << "Could not read the graph " << parameters.graphFile << std::endl;
+        return 1;
+    }
+    auto loaded = std::chrono::steady_clock::now();
+
+    Colouring s;
+    InstrumentationStats stats;
+    std::mt19937 generator(parameters.seed);
+    if (parameters.algorithm == "dsatur") {
+        s = dsaturColouring(G);
+    } else if (parameters.algorithm == "xrlf") {
+        s = xrlf::initByXRLF(G, parameters.xrlf, generator);
+    } else {
+        s = dsaturColouring(G);
+        if (parameters.k == 0) {
+            parameters.k = colorCount(s);
+        }
+        std::vector<std::unique_ptr<ColouringStrategy>> strategies;
+        strategies.push_back(hcaStrategy(parameters.L, parameters.A, parameters.alpha));
+
+        ColouringAlgorithm algorithm;
+        algorithm.timeLimit = parameters.timeLimit;
+        algorithm.seed = parameters.seed;
+        algorithm.deterministic = parameters.deterministic;
+        algorithm.cliqueTimeLimit = parameters.cliqueTimeLimit;
+        algorithm.reduceGraph = parameters.reduceGraph;
+        algorithm.decomposeComponents = parameters.decomposeComponents;
+        try {
+            auto result = algorithm.perform(strategies,
+                                            G,
+                                            parameters.k,
+                                            parameters.populationSize,
+                                            parameters.maxItr,
+                                            parameters.threadCount)[0];
+            stats = result.stats;
+            if (result.isValid && analyzeColouring(G, result.s).isValid() && colorCount(result.s) <= colorCount(s)) {
+                s = result.s;
+            }
+        } catch (const char *message) {
+            std::cerr << message;
+            return 1;
+        }
+    }
+    auto coloured = std::chrono::steady_clock::now();
+
+    if (!parameters.output.empty() && writeColouring(parameters.output, s) != 0) {
+        return 1;
+    }
+
+    double loadSeconds = std::chrono::duration<double>(loaded - start).count();
+    double colouringSeconds = std::chrono::duration<double>(coloured - loaded).count();
+    if (parameters.json.empty()) {
+        writeSummary(std::cout, parameters, G, s, stats, loadSeconds, colouringSeconds);
+    } else {
+        std::ofstream out(parameters.json.c_str());
+        if (!out) {
+            std::cerr << "Error opening " << parameters.json << std::endl;
+            return 1;
+        }
+        writeSummary(out, parameters, G, s, stats, loadSeconds, colouringSeconds);
+    }
+    return 0;
+}
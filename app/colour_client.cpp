@@ -0,0 +1,124 @@
+/**
+ * Test client of the colouring daemon: sends a graph to colourd and prints the received messages.
+ *
+ * Usage: colour_client <socket path> <graph file> [--format metis|csr|file] [--algorithm hca|batch|dsatur]
+ *                      [--deadline <ms>] [--threads <n>] [--seed <n>] [--k <n>] [--population <n>]
+ *                      [--iterations <n>] [--L <n>] [--A <n>] [--alpha <x>] [--repeat <n>] [--output <file>]
+ *
+ * With --format file, only the path is sent and the daemon reads the file itself. With --repeat, the graph is
+ * sent once and the further requests refer to it by its id. The last colouring is written to the output file
+ * (one colour per line).
+ */
+
+#include "service/colouring_service.h"
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+using namespace graph_colouring;
+
+int main(int argc, const char *argv[]) {
+    std::string socketPath;
+    std::string graphFile;
+    std::string output;
+    size_t repeat = 1;
+    ServiceRequest request;
+    bool ok = true;
+    try {
+        for (int i = 1; i < argc && ok; i++) {
+            std::string argument = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (argument == "--format" && hasValue) {
+                request.format = argv[++i];
+            } else if (argument == "--algorithm" && hasValue) {
+                request.algorithm = argv[++i];
+            } else if (argument == "--deadline" && hasValue) {
+                request.deadline = std::stoul(argv[++i]);
+            } else if (argument == "--threads" && hasValue) {
+                request.threadCount = std::stoul(argv[++i]);
+            } else if (argument == "--seed" && hasValue) {
+                request.seed = std::stoull(argv[++i]);
+            } else if (argument == "--k" && hasValue) {
+                request.k = std::stoul(argv[++i]);
+            } else if (argument == "--population" && hasValue) {
+                request.populationSize = std::stoul(argv[++i]);
+            } else if (argument == "--iterations" && hasValue) {
+                request.maxItr = std::stoul(argv[++i]);
+            } else if (argument == "--L" && hasValue) {
+                request.L = std::stoul(argv[++i]);
+            } else if (argument == "--A" && hasValue) {
+                request.A = std::stoul(argv[++i]);
+            } else if (argument == "--alpha" && hasValue) {
+                request.alpha = std::stod(argv[++i]);
+            } else if (argument == "--repeat" && hasValue) {
+                repeat = std::stoul(argv[++i]);
+            } else if (argument == "--output" && hasValue) {
+                output = argv[++i];
+            } else if (argument[0] != '-' && socketPath.empty()) {
+                socketPath = argument;
+            } else if (argument[0] != '-' && graphFile.empty()) {
+                graphFile = argument;
+            } else {
+                ok = false;
+            }
+        }
+    } catch (const std::exception &) {
+        ok = false;
+    }
+    if (!ok || graphFile.empty()) {
+        std::cerr << "Usage: " << argv[0] << " <socket path> <graph file> [--format metis|csr|file]"
+                  << " [--algorithm hca|batch|dsatur] [--deadline <ms>] [--threads <n>] [--seed <n>] [--k <n>]"
+                  << " [--population <n>] [--iterations <n>] [--L <n>] [--A <n>] [--alpha <x>] [--repeat <n>]"
+                  << " [--output <file>]\n";
+        return 1;
+    }
+
+    if (request.format == "file") {
+        request.payload = graphFile;
+    } else {
+        std::ifstream in(graphFile.c_str(), std::ios::binary);
+        if (!in) {
+            std::cerr << "Error opening " << graphFile << std::endl;
+            return 1;
+        }
+        request.payload.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    Colouring last;
+    for (size_t r = 0; r < repeat; r++) {
+        int status = requestColouring(socketPath, request, [&](const ServiceMessage &message) {
+            if (message.type == "GRAPH") {
+                std::cout << "GRAPH " << message.graphId << " nodes " << message.nodes
+                          << " edges " << message.edges << std::endl;
+                request.graphId = message.graphId;
+            } else if (message.type == "ERROR") {
+                std::cout << "ERROR " << message.error << std::endl;
+            } else {
+                std::cout << message.type << " k " << message.k << " after " << message.milliseconds << " ms"
+                          << std::endl;
+            }
+            if (message.type == "COLOURING") {
+                last = message.s;
+            }
+        });
+        if (status != 0) {
+            return 1;
+        }
+        //later requests use the graph kept by the daemon
+        request.payload.clear();
+    }
+
+    if (!output.empty()) {
+        std::ofstream out(output.c_str());
+        for (auto c : last) {
+            out << c << "\n";
+        }
+        if (!out) {
+            std::cerr << "Error writing " << output << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+/**
+ * Colouring daemon: serves colouring requests on a Unix domain socket (see ColouringService).
+ *
+ * Usage: colourd <socket path> [--threads <n>] [--graphs <n>]
+ *
+ * The daemon runs until it receives SIGINT or SIGTERM.
+ */
+
+#include "service/colouring_service.h"
+
+#include <csignal>
+#include <iostream>
+#include <string>
+
+using namespace graph_colouring;
+
+static ColouringService *runningService = nullptr;
+
+static void stopService(int) {
+    if (runningService != nullptr) {
+        runningService->stop();
+    }
+}
+
+int main(int argc, const char *argv[]) {
+    std::string socketPath;
+    size_t threadCount = std::thread::hardware_concurrency();
+    size_t maxGraphs = 64;
+    bool ok = true;
+    try {
+        for (int i = 1; i < argc && ok; i++) {
+            std::string argument = argv[i];
+            if (argument == "--threads" && i + 1 < argc) {
+                threadCount = std::stoul(argv[++i]);
+            } else if (argument == "--graphs" && i + 1 < argc) {
+                maxGraphs = std::stoul(argv[++i]);
+            } else if (socketPath.empty() && argument[0] != '-') {
+                socketPath = argument;
+            } else {
+                ok = false;
+            }
+        }
+    } catch (const std::exception &) {
+        ok = false;
+    }
+    if (!ok || socketPath.empty()) {
+        std::cerr << "Usage: " << argv[0] << " <socket path> [--threads <n>] [--graphs <n>]\n";
+        return 1;
+    }
+
+    ColouringService service(threadCount, maxGraphs);
+    if (service.listen(socketPath) != 0) {
+        return 1;
+    }
+    runningService = &service;
+    std::signal(SIGINT, stopService);
+    std::signal(SIGTERM, stopService);
+    std::cerr << "Listening on " << socketPath << std::endl;
+    service.serve();
+    runningService = nullptr;
+    return 0;
+}
@@ -0,0 +1,39 @@
+#include "compressed_graph.h"
+
+#include <algorithm>
+
+static void encode(std::vector<uint8_t> &data, uint64_t value) {
+    while (value >= 0x80) {
+        data.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<uint8_t>(value));
+}
+
+static uint64_t zigzag(const int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+compressed_graph_access::compressed_graph_access(const graph_access &G)
+        : m_number_of_nodes(G.number_of_nodes()),
+          m_number_of_edges(G.number_of_edges()),
+          m_offsets(G.number_of_nodes() + 1) {
+    std::vector<NodeID> neighbours;
+    m_data.reserve(G.number_of_edges() + G.number_of_nodes());
+    for (NodeID n = 0; n < G.number_of_nodes(); n++) {
+        m_offsets[n] = m_data.size();
+        neighbours.clear();
+        for (auto neighbour : G.neighbours(n)) {
+            neighbours.push_back(neighbour);
+        }
+        std::sort(neighbours.begin(), neighbours.end());
+        encode(m_data, neighbours.size());
+        for (size_t i = 0; i < neighbours.size(); i++) {
+            encode(m_data, i == 0
+                           ? zigzag(static_cast<int64_t>(neighbours[0]) - static_cast<int64_t>(n))
+                           : neighbours[i] - neighbours[i - 1]);
+        }
+    }
+    m_offsets[G.number_of_nodes()] = m_data.size();
+    m_data.shrink_to_fit();
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "graph.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Read-only graph storing every neighbour list as a sequence of variable length integers (7 bits per byte).
+ * A neighbour list starts with the degree of the node, followed by the first neighbour relative to the node
+ * itself (zigzag encoded) and the gaps between the remaining sorted neighbours.
+ * Sparse graphs with local neighbourhoods need one or two bytes per edge instead of four.
+ * The access methods mirror graph_access, so algorithms templated on the graph type accept both.
+ */
+class compressed_graph_access {
+public:
+    /**
+     * @param G the graph to compress. Its neighbour lists do not need to be sorted.
+     */
+    explicit compressed_graph_access(const graph_access &G);
+
+    compressed_graph_access(const compressed_graph_access &) = delete;
+    compressed_graph_access &operator=(const compressed_graph_access &) = delete;
+
+    NodeID number_of_nodes() const {
+        return m_number_of_nodes;
+    }
+
+    EdgeID number_of_edges() const {
+        return m_number_of_edges;
+    }
+
+    EdgeID getNodeDegree(NodeID node) const {
+        const uint8_t *data = &m_data[m_offsets[node]];
+        return static_cast<EdgeID>(decode(data));
+    }
+
+    /**
+     * @return the number of bytes used by the compressed neighbour lists and their offsets
+     */
+    size_t memory_usage() const {
+        return m_data.size() + m_offsets.size() * sizeof(size_t);
+    }
+
+    class adjacency_iterator {
+    public:
+        adjacency_iterator(const uint8_t *_data, NodeID _node)
+            :   data(_data)
+            ,   remaining(static_cast<EdgeID>(decode(data)))
+            ,   current(0)
+        {
+            if (remaining > 0) {
+                current = static_cast<NodeID>(_node + unzigzag(decode(data)));
+            }
+        }
+
+        adjacency_iterator()
+            :   data(nullptr)
+            ,   remaining(0)
+            ,   current(0)
+        {}
+
+        NodeID operator* () const {
+            return current;
+        }
+
+        adjacency_iterator& operator++ () {
+            if (--remaining > 0) {
+                current += static_cast<NodeID>(decode(data));
+            }
+            return *this;
+        }
+
+        //Only iterators of the same neighbour list are comparable
+        bool operator== (const adjacency_iterator& other) const {
+            return remaining == other.remaining;
+        }
+
+        bool operator!= (const adjacency_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        const uint8_t *data;
+        EdgeID remaining;
+        NodeID current;
+    };
+
+    class adjacency_adapter {
+    public:
+        adjacency_adapter(const compressed_graph_access& _G, NodeID _n)
+            :   G(_G)
+            ,   n(_n)
+        {}
+
+        adjacency_iterator begin() const {
+            return adjacency_iterator(&G.m_data[G.m_offsets[n]], n);
+        }
+
+        adjacency_iterator end() const {
+            return adjacency_iterator();
+        }
+
+    private:
+        const compressed_graph_access& G;
+        NodeID n;
+    };
+
+    adjacency_adapter neighbours(NodeID n) const {
+        return adjacency_adapter(*this, n);
+    }
+
+private:
+    static inline uint64_t decode(const uint8_t *&data) {
+        uint64_t value = *data++;
+        if (value < 0x80) {
+            return value;
+        }
+        value &= 0x7f;
+        unsigned shift = 7;
+        uint8_t byte;
+        do {
+            byte = *data++;
+            value |= uint64_t(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        return value;
+    }
+
+    static inline int64_t unzigzag(const uint64_t value) {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    NodeID m_number_of_nodes;
+    EdgeID m_number_of_edges;
+    /**< m_offsets[n] = the position of the neighbour list of n within m_data */
+    std::vector<size_t> m_offsets;
+    std::vector<uint8_t> m_data;
+};
@@ -0,0 +1,127 @@
+#include "dynamic_graph.h"
+
+dynamic_graph_access::dynamic_graph_access(const graph_access &G,
+                                           const double slack,
+                                           const EdgeID min_slack)
+        : m_slack(slack),
+          m_min_slack(min_slack),
+          m_number_of_edges(G.number_of_edges()),
+          m_garbage(0),
+          m_begin(G.number_of_nodes()),
+          m_capacity(G.number_of_nodes()),
+          m_degree(G.number_of_nodes()) {
+    EdgeID size = 0;
+    for (NodeID n = 0; n < G.number_of_nodes(); n++) {
+        m_begin[n] = size;
+        m_capacity[n] = block_capacity(G.getNodeDegree(n));
+        size += m_capacity[n];
+    }
+    m_edges.resize(size);
+    for (NodeID n = 0; n < G.number_of_nodes(); n++) {
+        for (auto neighbour : G.neighbours(n)) {
+            m_edges[m_begin[n] + m_degree[n]++] = neighbour;
+        }
+    }
+}
+
+bool dynamic_graph_access::has_edge(const NodeID u, const NodeID v) const {
+    const NodeID source = m_degree[u] <= m_degree[v] ? u : v;
+    const NodeID target = source == u ? v : u;
+    for (auto neighbour : neighbours(source)) {
+        if (neighbour == target) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void dynamic_graph_access::insert_arc(const NodeID source, const NodeID target) {
+    if (m_degree[source] == m_capacity[source]) {
+        //move the block into the overflow area
+        const EdgeID capacity = std::max(2 * m_capacity[source], block_capacity(m_degree[source] + 1));
+        const EdgeID begin = m_edges.size();
+        m_edges.resize(begin + capacity);
+        std::copy(m_edges.begin() + m_begin[source],
+                  m_edges.begin() + m_begin[source] + m_degree[source],
+                  m_edges.begin() + begin);
+        m_garbage += m_capacity[source];
+        m_begin[source] = begin;
+        m_capacity[source] = capacity;
+    }
+    m_edges[m_begin[source] + m_degree[source]++] = target;
+}
+
+bool dynamic_graph_access::remove_arc(const NodeID source, const NodeID target) {
+    NodeID *begin = m_edges.data() + m_begin[source];
+    NodeID *end = begin + m_degree[source];
+    NodeID *position = std::find(begin, end, target);
+    if (position == end) {
+        return false;
+    }
+    *position = *(end - 1);
+    m_degree[source]--;
+    return true;
+}
+
+size_t dynamic_graph_access::insert_edges(const std::vector<std::pair<NodeID, NodeID>> &edges) {
+    size_t inserted = 0;
+    for (auto &edge : edges) {
+        if (edge.first == edge.second || edge.first >= number_of_nodes() || edge.second >= number_of_nodes()
+            || has_edge(edge.first, edge.second)) {
+            continue;
+        }
+        insert_arc(edge.first, edge.second);
+        insert_arc(edge.second, edge.first);
+        inserted++;
+    }
+    m_number_of_edges += 2 * inserted;
+    if (m_garbage > m_number_of_edges) {
+        compact();
+    }
+    return inserted;
+}
+
+size_t dynamic_graph_access::remove_edges(const std::vector<std::pair<NodeID, NodeID>> &edges) {
+    size_t removed = 0;
+    for (auto &edge : edges) {
+        if (edge.first >= number_of_nodes() || edge.second >= number_of_nodes()) {
+            continue;
+        }
+        if (remove_arc(edge.first, edge.second)) {
+            remove_arc(edge.second, edge.first);
+            removed++;
+        }
+    }
+    m_number_of_edges -= 2 * removed;
+    return removed;
+}
+
+void dynamic_graph_access::compact() {
+    std::vector<NodeID> edges;
+    EdgeID size = 0;
+    for (NodeID n = 0; n < number_of_nodes(); n++) {
+        size += block_capacity(m_degree[n]);
+    }
+    edges.resize(size);
+    EdgeID begin = 0;
+    for (NodeID n = 0; n < number_of_nodes(); n++) {
+        std::copy(m_edges.begin() + m_begin[n], m_edges.begin() + m_begin[n] + m_degree[n], edges.begin() + begin);
+        m_begin[n] = begin;
+        m_capacity[n] = block_capacity(m_degree[n]);
+        begin += m_capacity[n];
+    }
+    m_edges.swap(edges);
+    m_garbage = 0;
+}
+
+void dynamic_graph_access::to_graph_access(graph_access &G) const {
+    std::vector<EdgeID> nodes(number_of_nodes() + 1);
+    std::vector<NodeID> edges;
+    edges.reserve(m_number_of_edges);
+    for (NodeID n = 0; n < number_of_nodes(); n++) {
+        nodes[n] = edges.size();
+        edges.insert(edges.end(), m_edges.begin() + m_begin[n], m_edges.begin() + m_begin[n] + m_degree[n]);
+    }
+    nodes[number_of_nodes()] = edges.size();
+    G.set_csr(std::move(nodes), std::move(edges));
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "graph.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * Graph supporting batched insertions and deletions of undirected edges.
+ * Every neighbour list is stored in a block of a single edge array with some free slots (slack) behind it.
+ * An insertion into a full block moves the block to an overflow area at the end of the array with twice the
+ * capacity; the old block becomes garbage, which is reclaimed by compact once it exceeds the live edges.
+ * Deletions swap the removed neighbour with the last one of the block, so neighbour lists are unordered.
+ * The access methods mirror graph_access.
+ */
+class dynamic_graph_access {
+public:
+    /**
+     * @param G the initial graph
+     * @param slack the free slots of every block relative to the degree of its node
+     * @param min_slack the minimum number of free slots of every block
+     */
+    explicit dynamic_graph_access(const graph_access &G,
+                                  double slack = 0.25,
+                                  EdgeID min_slack = 4);
+
+    NodeID number_of_nodes() const {
+        return static_cast<NodeID>(m_degree.size());
+    }
+
+    /**
+     * @return the number of directed edges (twice the number of undirected edges, like graph_access)
+     */
+    EdgeID number_of_edges() const {
+        return m_number_of_edges;
+    }
+
+    EdgeID getNodeDegree(NodeID node) const {
+        return m_degree[node];
+    }
+
+    /**
+     * Runs in O(min(degree(u), degree(v)))
+     */
+    bool has_edge(NodeID u, NodeID v) const;
+
+    /**
+     * Inserts undirected edges. Self-loops, edges with unknown nodes and existing edges are skipped.
+     * @return the number of inserted edges
+     */
+    size_t insert_edges(const std::vector<std::pair<NodeID, NodeID>> &edges);
+
+    /**
+     * Removes undirected edges. Edges which do not exist are skipped.
+     * @return the number of removed edges
+     */
+    size_t remove_edges(const std::vector<std::pair<NodeID, NodeID>> &edges);
+
+    /**
+     * Rebuilds the edge array with fresh slack and without garbage
+     */
+    void compact();
+
+    /**
+     * Copies the current graph into a static graph, e.g. to colour it from scratch
+     * @param G the target graph
+     */
+    void to_graph_access(graph_access &G) const;
+
+    /**
+     * @return the number of bytes used by the edge array and the block descriptors
+     */
+    size_t memory_usage() const {
+        return m_edges.size() * sizeof(NodeID) + m_begin.size() * (2 * sizeof(EdgeID) + sizeof(NodeID));
+    }
+
+    /**
+     * @return the number of slots of the edge array occupied by moved blocks
+     */
+    EdgeID garbage() const {
+        return m_garbage;
+    }
+
+    class adjacency_adapter {
+    public:
+        adjacency_adapter(const NodeID *_begin, const NodeID *_end)
+            :   m_begin(_begin)
+            ,   m_end(_end)
+        {}
+
+        const NodeID *begin() const {
+            return m_begin;
+        }
+
+        const NodeID *end() const {
+            return m_end;
+        }
+
+    private:
+        const NodeID *m_begin;
+        const NodeID *m_end;
+    };
+
+    /**
+     * The adapter is invalidated by insertions and compact
+     */
+    adjacency_adapter neighbours(NodeID n) const {
+        const NodeID *begin = m_edges.data() + m_begin[n];
+        return adjacency_adapter(begin, begin + m_degree[n]);
+    }
+
+private:
+    EdgeID block_capacity(EdgeID degree) const {
+        return degree + std::max(m_min_slack, static_cast<EdgeID>(m_slack * degree));
+    }
+
+    void insert_arc(NodeID source, NodeID target);
+
+    bool remove_arc(NodeID source, NodeID target);
+
+    double m_slack;
+    EdgeID m_min_slack;
+    EdgeID m_number_of_edges;
+    EdgeID m_garbage;
+    /**< The block of node n is m_edges[m_begin[n], m_begin[n] + m_capacity[n]), its first m_degree[n] entries
+     * are the neighbours */
+    std::vector<EdgeID> m_begin;
+    std::vector<EdgeID> m_capacity;
+    std::vector<NodeID> m_degree;
+    std::vector<NodeID> m_edges;
+};
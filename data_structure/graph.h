@@ -26,10 +26,15 @@
 #include <cassert>
 #include <cstdint>
 #include <iostream>
+#include <utility>
 #include <vector>
 
 typedef uint32_t NodeID;
+#ifdef COLOURING_64BIT_EDGES
+typedef uint64_t EdgeID;
+#else
 typedef uint32_t EdgeID;
+#endif
 typedef uint32_t Color;
 
 #define UNCOLORED std::numeric_limits<Color>::max()
@@ -42,36 +47,39 @@ struct Edge {
     NodeID target;
 };
 
-class graph_access;
+template<typename NodeIDType, typename EdgeIDType>
+class basic_graph_access;
 
 //construction etc. is encapsulated in basicGraph / access to properties etc. is encapsulated in graph_access
-class basicGraph {
-    friend class graph_access;
+//Both are templates on the width of the node and edge ids, see the typedefs at the end of this file
+template<typename NodeIDType, typename EdgeIDType>
+class basic_graph {
+    friend class basic_graph_access<NodeIDType, EdgeIDType>;
 
 public:
-    basicGraph() : m_building_graph(false) {
+    basic_graph() : m_building_graph(false) {
     }
 
 private:
     //methods only to be used by friend class
-    EdgeID number_of_edges() {
+    EdgeIDType number_of_edges() {
         return m_edges.size();
     }
 
-    NodeID number_of_nodes() {
+    NodeIDType number_of_nodes() {
         return m_nodes.size() - 1;
     }
 
-    inline EdgeID get_first_edge(const NodeID & node) {
+    inline EdgeIDType get_first_edge(const NodeIDType & node) {
         return m_nodes[node];
     }
 
-    inline EdgeID get_first_invalid_edge(const NodeID & node) {
+    inline EdgeIDType get_first_invalid_edge(const NodeIDType & node) {
         return m_nodes[node + 1];
     }
 
     // construction of the graph
-    void start_construction(NodeID n, EdgeID m) {
+    void start_construction(NodeIDType n, EdgeIDType m) {
         m_building_graph = true;
         node             = 0;
         e                = 0;
@@ -84,20 +92,20 @@ private:
         m_nodes[node] = e;
     }
 
-    EdgeID new_edge(NodeID source, NodeID target) {
+    EdgeIDType new_edge(NodeIDType source, NodeIDType target) {
         assert(m_building_graph);
         assert(e < m_edges.size());
 
         m_edges[e] = target;
-        EdgeID e_bar = e;
+        EdgeIDType e_bar = e;
         ++e;
 
         assert(source + 1 < m_nodes.size());
         m_nodes[source + 1] = e;
 
         //fill isolated sources at the end
-        if ((NodeID)(m_last_source + 1) < source) {
-            for (NodeID i = source; i > (NodeID)(m_last_source + 1); i--) {
+        if ((NodeIDType)(m_last_source + 1) < source) {
+            for (NodeIDType i = source; i > (NodeIDType)(m_last_source + 1); i--) {
                 m_nodes[i] = m_nodes[m_last_source + 1];
             }
         }
@@ -105,7 +113,7 @@ private:
         return e_bar;
     }
 
-    NodeID new_node() {
+    NodeIDType new_node() {
         assert(m_building_graph);
         return node++;
     }
@@ -118,9 +126,9 @@ private:
         m_building_graph = false;
 
         //fill isolated sources at the end
-        if ((unsigned int)(m_last_source) != node - 1) {
+        if ((NodeIDType)(m_last_source) != node - 1) {
             //in that case at least the last node was an isolated node
-            for (NodeID i = node; i > (unsigned int)(m_last_source + 1); i--) {
+            for (NodeIDType i = node; i > (NodeIDType)(m_last_source + 1); i--) {
                 m_nodes[i] = m_nodes[m_last_source + 1];
             }
         }
@@ -128,14 +136,14 @@ private:
 
     // %%%%%%%%%%%%%%%%%%% DATA %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
     // split properties for coarsening and uncoarsening
-    std::vector<EdgeID> m_nodes;
-    std::vector<NodeID> m_edges;
+    std::vector<EdgeIDType> m_nodes;
+    std::vector<NodeIDType> m_edges;
 
     // construction properties
     bool m_building_graph;
-    int m_last_source;
-    NodeID node; //current node that is constructed
-    EdgeID e;    //current edge that is constructed
+    int64_t m_last_source;
+    NodeIDType node; //current node that is constructed
+    EdgeIDType e;    //current edge that is constructed
 };
 
 // //makros - graph access
@@ -144,10 +152,14 @@ private:
 // #define forall_out_edges(G,e,n) { for(EdgeID e = G.get_first_edge(n), end = G.get_first_invalid_edge(n); e < end; ++e) {
 // #define endfor }}
 
-class graph_access {
+template<typename NodeIDType, typename EdgeIDType>
+class basic_graph_access {
 public:
-    graph_access() { m_max_degree_computed = false; m_max_degree = 0; graphref = new basicGraph();}
-    virtual ~graph_access() { delete graphref; };
+    typedef NodeIDType NodeID;
+    typedef EdgeIDType EdgeID;
+
+    basic_graph_access() { m_max_degree_computed = false; m_max_degree = 0; graphref = new basic_graph<NodeIDType, EdgeIDType>();}
+    virtual ~basic_graph_access() { delete graphref; };
 
     /* ============================================================= */
     /* build methods */
@@ -157,6 +169,10 @@ public:
     EdgeID new_edge(NodeID source, NodeID target);
     void finish_construction();
 
+    //Replaces the graph by the given CSR arrays, where the neighbours of node n are
+    //edges[nodes[n]], ..., edges[nodes[n + 1] - 1]
+    void set_csr(std::vector<EdgeID> &&nodes, std::vector<NodeID> &&edges);
+
     /* ============================================================= */
     /* graph access methods */
     /* ============================================================= */
@@ -173,7 +189,7 @@ public:
 
     class adjacency_iterator {
     public:
-        adjacency_iterator(const graph_access& _G, EdgeID _e)
+        adjacency_iterator(const basic_graph_access& _G, EdgeID _e)
             :   G(_G)
             ,   e(_e)
         {}
@@ -196,13 +212,13 @@ public:
         }
 
     private:
-        const graph_access& G;
+        const basic_graph_access& G;
         EdgeID e;
     };
 
     class adjacency_adapter {
     public:
-        adjacency_adapter(const graph_access& _G, NodeID _n)
+        adjacency_adapter(const basic_graph_access& _G, NodeID _n)
             :   G(_G)
             ,   n(_n)
         {}
@@ -216,7 +232,7 @@ public:
         }
 
     private:
-        const graph_access& G;
+        const basic_graph_access& G;
         NodeID n;
     };
 
@@ -224,39 +240,56 @@ public:
             return adjacency_adapter(*this, n);
     }
 private:
-    basicGraph* graphref;
+    basic_graph<NodeIDType, EdgeIDType>* graphref;
     bool m_max_degree_computed;
     EdgeID m_max_degree;
 
 };
 
 /* graph build methods */
-inline void graph_access::start_construction(NodeID nodes, EdgeID edges) {
+template<typename NodeIDType, typename EdgeIDType>
+inline void basic_graph_access<NodeIDType, EdgeIDType>::start_construction(NodeIDType nodes, EdgeIDType edges) {
     graphref->start_construction(nodes, edges);
 }
 
-inline NodeID graph_access::new_node() {
+template<typename NodeIDType, typename EdgeIDType>
+inline NodeIDType basic_graph_access<NodeIDType, EdgeIDType>::new_node() {
     return graphref->new_node();
 }
 
-inline EdgeID graph_access::new_edge(NodeID source, NodeID target) {
+template<typename NodeIDType, typename EdgeIDType>
+inline EdgeIDType basic_graph_access<NodeIDType, EdgeIDType>::new_edge(NodeIDType source, NodeIDType target) {
     return graphref->new_edge(source, target);
 }
 
-inline void graph_access::finish_construction() {
+template<typename NodeIDType, typename EdgeIDType>
+inline void basic_graph_access<NodeIDType, EdgeIDType>::finish_construction() {
     graphref->finish_construction();
 }
 
+template<typename NodeIDType, typename EdgeIDType>
+inline void basic_graph_access<NodeIDType, EdgeIDType>::set_csr(std::vector<EdgeIDType> &&nodes,
+                                                               std::vector<NodeIDType> &&edges) {
+    assert(!nodes.empty() && nodes.back() == edges.size());
+    graphref->m_nodes = std::move(nodes);
+    graphref->m_edges = std::move(edges);
+    m_max_degree_computed = false;
+    m_max_degree = 0;
+}
+
 /* graph access methods */
-inline NodeID graph_access::number_of_nodes() const {
+template<typename NodeIDType, typename EdgeIDType>
+inline NodeIDType basic_graph_access<NodeIDType, EdgeIDType>::number_of_nodes() const {
     return graphref->number_of_nodes();
 }
 
-inline EdgeID graph_access::number_of_edges() const {
+template<typename NodeIDType, typename EdgeIDType>
+inline EdgeIDType basic_graph_access<NodeIDType, EdgeIDType>::number_of_edges() const {
     return graphref->number_of_edges();
 }
 
-inline EdgeID graph_access::get_first_edge(NodeID node) const {
+template<typename NodeIDType, typename EdgeIDType>
+inline EdgeIDType basic_graph_access<NodeIDType, EdgeIDType>::get_first_edge(NodeIDType node) const {
 #ifdef NDEBUG
     return graphref->m_nodes[node];
 #else
@@ -264,11 +297,13 @@ inline EdgeID graph_access::get_first_edge(NodeID node) const {
 #endif
 }
 
-inline EdgeID graph_access::get_first_invalid_edge(NodeID node) const {
+template<typename NodeIDType, typename EdgeIDType>
+inline EdgeIDType basic_graph_access<NodeIDType, EdgeIDType>::get_first_invalid_edge(NodeIDType node) const {
     return graphref->m_nodes[node + 1];
 }
 
-inline NodeID graph_access::getEdgeTarget(EdgeID edge) const {
+template<typename NodeIDType, typename EdgeIDType>
+inline NodeIDType basic_graph_access<NodeIDType, EdgeIDType>::getEdgeTarget(EdgeIDType edge) const {
 #ifdef NDEBUG
     return graphref->m_edges[edge];
 #else
@@ -276,14 +311,16 @@ inline NodeID graph_access::getEdgeTarget(EdgeID edge) const {
 #endif
 }
 
-inline EdgeID graph_access::getNodeDegree(NodeID node) const {
+template<typename NodeIDType, typename EdgeIDType>
+inline EdgeIDType basic_graph_access<NodeIDType, EdgeIDType>::getNodeDegree(NodeIDType node) const {
     return graphref->m_nodes[node + 1] - graphref->m_nodes[node];
 }
 
-inline EdgeID graph_access::getMaxDegree() {
+template<typename NodeIDType, typename EdgeIDType>
+inline EdgeIDType basic_graph_access<NodeIDType, EdgeIDType>::getMaxDegree() {
     if (!m_max_degree_computed) {
-        for (NodeID node = 0; node < number_of_nodes(); ++node) {
-            EdgeID cur_degree = 0;
+        for (NodeIDType node = 0; node < number_of_nodes(); ++node) {
+            EdgeIDType cur_degree = 0;
             for (auto e : neighbours(node)) {
                 ++cur_degree;
             }
@@ -299,3 +336,15 @@ inline EdgeID graph_access::getMaxDegree() {
 
 // for(EdgeID e = 0; e < G.number_of_edges(); ++e) { ... }
 // for(NodeID n = 0; n < G.number_of_nodes(); ++n) { ... }
+
+/**
+ * The graph used throughout the colouring framework.
+ * Define COLOURING_64BIT_EDGES (CMake option of the same name) to build the framework with 64 bit edge ids.
+ */
+typedef basic_graph<NodeID, EdgeID> basicGraph;
+typedef basic_graph_access<NodeID, EdgeID> graph_access;
+
+/**
+ * Graphs with more than 2^32 directed edges
+ */
+typedef basic_graph_access<uint32_t, uint64_t> graph_access64;
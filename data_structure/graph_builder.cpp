@@ -0,0 +1,109 @@
+#include "graph_builder.h"
+
+#include <algorithm>
+
+/**
+ * Runs f(threadId) on threadCount threads (the calling thread being one of them)
+ */
+template<typename F>
+static void parallelFor(const size_t threadCount, F f) {
+    std::vector<std::thread> threads;
+    for (size_t threadId = 1; threadId < threadCount; threadId++) {
+        threads.emplace_back(f, threadId);
+    }
+    f(0);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+void graph_builder::build(graph_access &G,
+                          size_t threadCount) {
+    threadCount = std::max<size_t>(1, threadCount);
+
+    //Every thread processes a contiguous range of the concatenated edge buffers
+    std::vector<size_t> bufferStart(m_buffers.size() + 1, 0);
+    for (size_t b = 0; b < m_buffers.size(); b++) {
+        bufferStart[b + 1] = bufferStart[b] + m_buffers[b].size();
+        for (auto &edge : m_buffers[b]) {
+            m_nodes = std::max(m_nodes, std::max(edge.first, edge.second) + 1);
+        }
+    }
+    const size_t totalEdges = bufferStart.back();
+    const NodeID n = m_nodes;
+    //Every sorting thread needs a counter per node, so the counters of all threads must not take more space than
+    //the (symmetrized) edges themselves. Sparse graphs are therefore sorted by fewer threads.
+    const size_t sortThreads = std::min(threadCount, std::max<size_t>(1, 2 * totalEdges / std::max<NodeID>(1, n)));
+    auto forEdges = [&](const size_t threadId, auto f) {
+        size_t begin = totalEdges * threadId / sortThreads;
+        size_t end = totalEdges * (threadId + 1) / sortThreads;
+        size_t b = std::upper_bound(bufferStart.begin(), bufferStart.end(), begin) - bufferStart.begin() - 1;
+        for (size_t i = begin; i < end; i++) {
+            while (i >= bufferStart[b + 1]) {
+                b++;
+            }
+            auto &edge = m_buffers[b][i - bufferStart[b]];
+            if (edge.first != edge.second) {
+                f(edge.first, edge.second);
+                f(edge.second, edge.first);
+            }
+        }
+    };
+
+    //Counting sort: count[t * n + u] = the number of edges of thread t with source u
+    std::vector<EdgeID> count(sortThreads * size_t(n), 0);
+    parallelFor(sortThreads, [&](const size_t threadId) {
+        EdgeID *sourceCount = count.data() + threadId * n;
+        forEdges(threadId, [sourceCount](NodeID u, NodeID) {
+            sourceCount[u]++;
+        });
+    });
+
+    //Prefix sum over (u, t): afterwards count[t * n + u] = the first slot of thread t for source u
+    std::vector<EdgeID> start(size_t(n) + 1, 0);
+    EdgeID offset = 0;
+    for (NodeID u = 0; u < n; u++) {
+        start[u] = offset;
+        for (size_t t = 0; t < sortThreads; t++) {
+            EdgeID c = count[t * n + u];
+            count[t * n + u] = offset;
+            offset += c;
+        }
+    }
+    start[n] = offset;
+
+    std::vector<NodeID> edges(offset);
+    parallelFor(sortThreads, [&](const size_t threadId) {
+        EdgeID *slot = count.data() + threadId * n;
+        forEdges(threadId, [slot, &edges](NodeID u, NodeID v) {
+            edges[slot[u]++] = v;
+        });
+    });
+    m_buffers.clear();
+    m_buffers.shrink_to_fit();
+    std::vector<EdgeID>().swap(count);
+
+    //Remove duplicates within every neighbour list
+    std::vector<EdgeID> degree(size_t(n) + 1, 0);
+    parallelFor(threadCount, [&](const size_t threadId) {
+        for (NodeID u = NodeID(n * threadId / threadCount); u < NodeID(n * (threadId + 1) / threadCount); u++) {
+            auto first = edges.begin() + start[u];
+            auto last = edges.begin() + start[u + 1];
+            std::sort(first, last);
+            degree[u] = static_cast<EdgeID>(std::unique(first, last) - first);
+        }
+    });
+
+    std::vector<EdgeID> nodes(size_t(n) + 1, 0);
+    for (NodeID u = 0; u < n; u++) {
+        nodes[u + 1] = nodes[u] + degree[u];
+    }
+    std::vector<NodeID> uniqueEdges(nodes[n]);
+    parallelFor(threadCount, [&](const size_t threadId) {
+        for (NodeID u = NodeID(n * threadId / threadCount); u < NodeID(n * (threadId + 1) / threadCount); u++) {
+            std::copy(edges.begin() + start[u], edges.begin() + start[u] + degree[u], uniqueEdges.begin() + nodes[u]);
+        }
+    });
+
+    G.set_csr(std::move(nodes), std::move(uniqueEdges));
+}
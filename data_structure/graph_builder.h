@@ -0,0 +1,55 @@
+#pragma once
+
+#include "graph.h"
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * Builds a graph from an unordered list of undirected edges.
+ * Every producer thread appends its edges to its own buffer, so add_edge needs no synchronization as long as
+ * every producer uses a distinct producer id. build symmetrizes the edges, removes self-loops and duplicates and
+ * constructs the CSR arrays with a parallel counting sort. The counting sort uses at most as many threads as the
+ * average degree, so its per-thread counters take O(V + E) memory in total.
+ */
+class graph_builder {
+public:
+    /**
+     * @param nodes the number of nodes. It is increased automatically if an edge references a larger node id.
+     * @param producerCount the number of threads adding edges concurrently
+     */
+    explicit graph_builder(NodeID nodes = 0,
+                           size_t producerCount = 1)
+        :   m_nodes(nodes)
+        ,   m_buffers(producerCount)
+    {}
+
+    /**
+     * Adds the undirected edge {u, v}. Safe to call concurrently for distinct producers.
+     * @param producer the id of the calling producer (< producerCount)
+     */
+    void add_edge(size_t producer, NodeID u, NodeID v) {
+        m_buffers[producer].emplace_back(u, v);
+    }
+
+    /**
+     * @param producer the id of a producer
+     * @param edges the expected number of edges of this producer
+     */
+    void reserve(size_t producer, size_t edges) {
+        m_buffers[producer].reserve(edges);
+    }
+
+    /**
+     * Constructs the graph and releases the edge buffers
+     * @param G the target graph
+     * @param threadCount the number of threads used for the construction
+     */
+    void build(graph_access &G,
+               size_t threadCount = std::thread::hardware_concurrency());
+
+private:
+    NodeID m_nodes;
+    std::vector<std::vector<std::pair<NodeID, NodeID>>> m_buffers;
+};
@@ -0,0 +1,253 @@
+#include "dimacs_io.h"
+
+#include "../graph_builder.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#ifdef COLOURING_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef COLOURING_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace {
+    const size_t BLOCK_SIZE = 1 << 20;
+
+    /**
+     * Sequential source of decompressed bytes
+     */
+    class BlockReader {
+    public:
+        virtual ~BlockReader() = default;
+
+        /**
+         * @return the number of bytes written into \p buffer (0 at the end of the input) or -1 on errors
+         */
+        virtual long read(char *buffer, size_t size) = 0;
+    };
+
+    class PlainReader : public BlockReader {
+    public:
+        explicit PlainReader(FILE *file) : file(file) {}
+
+        ~PlainReader() override {
+            fclose(file);
+        }
+
+        long read(char *buffer, size_t size) override {
+            size_t n = fread(buffer, 1, size, file);
+            return n == 0 && ferror(file) ? -1 : static_cast<long>(n);
+        }
+
+    private:
+        FILE *file;
+    };
+
+#ifdef COLOURING_HAVE_ZLIB
+    class GzipReader : public BlockReader {
+    public:
+        explicit GzipReader(gzFile file) : file(file) {
+            gzbuffer(file, BLOCK_SIZE);
+        }
+
+        ~GzipReader() override {
+            gzclose(file);
+        }
+
+        long read(char *buffer, size_t size) override {
+            return gzread(file, buffer, static_cast<unsigned>(size));
+        }
+
+    private:
+        gzFile file;
+    };
+#endif
+
+#ifdef COLOURING_HAVE_ZSTD
+    class ZstdReader : public BlockReader {
+    public:
+        explicit ZstdReader(FILE *file)
+                : file(file),
+                  stream(ZSTD_createDStream()),
+                  compressed(ZSTD_DStreamInSize()),
+                  input({compressed.data(), 0, 0}) {
+            ZSTD_initDStream(stream);
+        }
+
+        ~ZstdReader() override {
+            ZSTD_freeDStream(stream);
+            fclose(file);
+        }
+
+        long read(char *buffer, size_t size) override {
+            ZSTD_outBuffer output = {buffer, size, 0};
+            while (output.pos == 0) {
+                if (input.pos == input.size) {
+                    input.size = fread(compressed.data(), 1, compressed.size(), file);
+                    input.pos = 0;
+                    if (input.size == 0) {
+                        return ferror(file) ? -1 : 0;
+                    }
+                }
+                if (ZSTD_isError(ZSTD_decompressStream(stream, &output, &input))) {
+                    return -1;
+                }
+            }
+            return static_cast<long>(output.pos);
+        }
+
+    private:
+        FILE *file;
+        ZSTD_DStream *stream;
+        std::vector<char> compressed;
+        ZSTD_inBuffer input;
+    };
+#endif
+
+    std::unique_ptr<BlockReader> openReader(const std::string &filename) {
+        FILE *file = fopen(filename.c_str(), "rb");
+        if (file == nullptr) {
+            std::cerr << "Error opening " << filename << std::endl;
+            return nullptr;
+        }
+        unsigned char magic[4] = {0, 0, 0, 0};
+        size_t magicLength = fread(magic, 1, sizeof(magic), file);
+        rewind(file);
+
+        if (magicLength >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) {
+#ifdef COLOURING_HAVE_ZLIB
+            fclose(file);
+            gzFile gzfile = gzopen(filename.c_str(), "rb");
+            if (gzfile == nullptr) {
+                std::cerr << "Error opening " << filename << std::endl;
+                return nullptr;
+            }
+            return std::unique_ptr<BlockReader>(new GzipReader(gzfile));
+#else
+            fclose(file);
+            std::cerr << filename << " is gzip compressed, but zlib support is not available" << std::endl;
+            return nullptr;
+#endif
+        }
+        if (magicLength == 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) {
+#ifdef COLOURING_HAVE_ZSTD
+            return std::unique_ptr<BlockReader>(new ZstdReader(file));
+#else
+            fclose(file);
+            std::cerr << filename << " is zstd compressed, but zstd support is not available" << std::endl;
+            return nullptr;
+#endif
+        }
+        return std::unique_ptr<BlockReader>(new PlainReader(file));
+    }
+
+    inline const char *skipSpaces(const char *p, const char *end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+            p++;
+        }
+        return p;
+    }
+
+    inline const char *parseNumber(const char *p, const char *end, uint64_t &value, bool &ok) {
+        p = skipSpaces(p, end);
+        if (p == end || *p < '0' || *p > '9') {
+            ok = false;
+            return p;
+        }
+        value = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            value = 10 * value + (*p - '0');
+            p++;
+        }
+        return p;
+    }
+}
+
+int graph_io::readGraphDimacs(graph_access &G,
+                              const std::string &filename,
+                              const size_t threadCount) {
+    auto reader = openReader(filename);
+    if (!reader) {
+        return 1;
+    }
+
+    graph_builder builder;
+    bool foundHeader = false;
+    uint64_t nodes = 0;
+    uint64_t edges = 0;
+    uint64_t lineNumber = 0;
+
+    std::vector<char> buffer(BLOCK_SIZE);
+    //Bytes of an incomplete line at the end of the previous block
+    size_t carry = 0;
+    bool lastBlock = false;
+    while (!lastBlock) {
+        if (carry == buffer.size()) {
+            buffer.resize(2 * buffer.size());
+        }
+        long n = reader->read(buffer.data() + carry, buffer.size() - carry);
+        if (n < 0) {
+            std::cerr << "Error reading " << filename << std::endl;
+            return 1;
+        }
+        lastBlock = n == 0;
+        const char *p = buffer.data();
+        const char *end = buffer.data() + carry + n;
+        while (p < end) {
+            const char *lineEnd = static_cast<const char *>(memchr(p, '\n', end - p));
+            if (lineEnd == nullptr) {
+                if (!lastBlock) {
+                    break;
+                }
+                lineEnd = end;
+            }
+            lineNumber++;
+            const char *q = skipSpaces(p, lineEnd);
+            bool ok = true;
+            if (q < lineEnd && *q == 'e') {
+                uint64_t u, v;
+                q = parseNumber(q + 1, lineEnd, u, ok);
+                q = parseNumber(q, lineEnd, v, ok);
+                ok = ok && foundHeader && u >= 1 && v >= 1 && u <= nodes && v <= nodes;
+                if (ok) {
+                    builder.add_edge(0, static_cast<NodeID>(u - 1), static_cast<NodeID>(v - 1));
+                }
+            } else if (q < lineEnd && *q == 'p') {
+                q = skipSpaces(q + 1, lineEnd);
+                while (q < lineEnd && *q != ' ' && *q != '\t') {
+                    q++;
+                }
+                q = parseNumber(q, lineEnd, nodes, ok);
+                q = parseNumber(q, lineEnd, edges, ok);
+                ok = ok && !foundHeader && nodes < std::numeric_limits<NodeID>::max()
+                     && 2 * edges <= std::numeric_limits<EdgeID>::max();
+                if (ok) {
+                    foundHeader = true;
+                    builder = graph_builder(static_cast<NodeID>(nodes));
+                    builder.reserve(0, edges);
+                }
+            }
+            //Comments (c), empty lines and unknown descriptors are ignored
+            if (!ok) {
+                std::cerr << filename << ":" << lineNumber << ": invalid line" << std::endl;
+                return 1;
+            }
+            p = lineEnd + 1;
+        }
+        carry = p < end ? static_cast<size_t>(end - p) : 0;
+        memmove(buffer.data(), p, carry);
+    }
+
+    if (!foundHeader) {
+        std::cerr << filename << " does not contain a problem line" << std::endl;
+        return 1;
+    }
+    builder.build(G, threadCount);
+    return 0;
+}
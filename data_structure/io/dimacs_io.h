@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+#include <thread>
+
+#include "../graph.h"
+
+namespace graph_io {
+    /**
+     * Reads a graph in DIMACS colouring format ("p edge <nodes> <edges>" followed by lines "e <u> <v>").
+     * Files compressed with gzip or zstd are detected by their magic number and decompressed block-wise
+     * while parsing (if the library has been built with zlib or zstd support).
+     * Duplicate edges, edges given in both directions and self-loops are allowed.
+     * @param G the target graph
+     * @param filename the graph file
+     * @param threadCount the number of threads used to construct the graph (see graph_builder)
+     * @return 0 on success, 1 otherwise
+     */
+    int readGraphDimacs(graph_access &G,
+                        const std::string &filename,
+                        size_t threadCount = std::thread::hardware_concurrency());
+}
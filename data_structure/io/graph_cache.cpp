@@ -0,0 +1,363 @@
+#include "graph_cache.h"
+
+#include "dimacs_io.h"
+#include "graph_io.h"
+
+#include <sys/stat.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+namespace {
+    const char GRAPH_MAGIC[4] = {'G', 'C', 'S', 'R'};
+    const uint32_t GRAPH_VERSION = 1;
+
+    const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    const uint64_t FNV_PRIME = 1099511628211ULL;
+
+    inline uint64_t mix(uint64_t hash, const uint64_t value) {
+        return (hash ^ value) * FNV_PRIME;
+    }
+
+    bool endsWith(const std::string &s, const std::string &suffix) {
+        return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    bool fileState(const std::string &filename, int64_t &mtime, uint64_t &size) {
+        struct stat st;
+        if (stat(filename.c_str(), &st) != 0) {
+            return false;
+        }
+        mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+        size = static_cast<uint64_t>(st.st_size);
+        return true;
+    }
+
+    /**
+     * FNV-1a over 64 bit words of the file content, followed by the modification time
+     */
+    bool hashFile(const std::string &filename, const int64_t mtime, uint64_t &hash) {
+        FILE *file = fopen(filename.c_str(), "rb");
+        if (file == nullptr) {
+            return false;
+        }
+        std::vector<uint64_t> buffer(1 << 17);
+        hash = FNV_OFFSET;
+        size_t n;
+        while ((n = fread(buffer.data(), 1, buffer.size() * sizeof(uint64_t), file)) > 0) {
+            const size_t words = n / sizeof(uint64_t);
+            for (size_t i = 0; i < words; i++) {
+                hash = mix(hash, buffer[i]);
+            }
+            if (n % sizeof(uint64_t) != 0) {
+                uint64_t tail = 0;
+                std::memcpy(&tail, buffer.data() + words, n % sizeof(uint64_t));
+                hash = mix(hash, tail);
+            }
+            hash = mix(hash, n);
+        }
+        bool ok = !ferror(file);
+        fclose(file);
+        hash = mix(hash, static_cast<uint64_t>(mtime));
+        return ok;
+    }
+
+    template<typename T>
+    bool writeArray(FILE *file, const std::vector<T> &values) {
+        return fwrite(values.data(), sizeof(T), values.size(), file) == values.size();
+    }
+
+    template<typename T>
+    bool readArray(FILE *file, std::vector<T> &values) {
+        return fread(values.data(), sizeof(T), values.size(), file) == values.size();
+    }
+}
+
+int graph_io::readGraph(graph_access &G, const std::string &filename) {
+    if (endsWith(filename, ".col") || endsWith(filename, ".col.gz") || endsWith(filename, ".col.zst")) {
+        return readGraphDimacs(G, filename);
+    }
+    return readGraphWeighted(G, filename);
+}
+
+int graph_io::writeGraphBinary(const graph_access &G, const std::string &filename) {
+    const NodeID n = G.number_of_nodes();
+    std::vector<EdgeID> nodes(n + 1);
+    std::vector<NodeID> edges(G.number_of_edges());
+    for (NodeID node = 0; node <= n; node++) {
+        nodes[node] = node < n ? G.get_first_edge(node) : G.number_of_edges();
+    }
+    for (EdgeID e = 0; e < edges.size(); e++) {
+        edges[e] = G.getEdgeTarget(e);
+    }
+
+    const std::string tmpFilename = filename + ".tmp";
+    FILE *file = fopen(tmpFilename.c_str(), "wb");
+    if (file == nullptr) {
+        std::cerr << "Error opening " << tmpFilename << std::endl;
+        return 1;
+    }
+    const uint8_t widths[2] = {sizeof(NodeID), sizeof(EdgeID)};
+    const uint64_t sizes[2] = {nodes.size(), edges.size()};
+    bool ok = fwrite(GRAPH_MAGIC, sizeof(GRAPH_MAGIC), 1, file) == 1
+              && fwrite(&GRAPH_VERSION, sizeof(GRAPH_VERSION), 1, file) == 1
+              && fwrite(widths, sizeof(widths), 1, file) == 1
+              && fwrite(sizes, sizeof(sizes), 1, file) == 1
+              && writeArray(file, nodes)
+              && writeArray(file, edges);
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        std::cerr << "Error writing " << tmpFilename << std::endl;
+        std::remove(tmpFilename.c_str());
+        return 1;
+    }
+    if (std::rename(tmpFilename.c_str(), filename.c_str()) != 0) {
+        std::cerr << "Error renaming " << tmpFilename << " to " << filename << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int graph_io::readGraphBinary(graph_access &G, const std::string &filename) {
+    FILE *file = fopen(filename.c_str(), "rb");
+    if (file == nullptr) {
+        std::cerr << "Error opening " << filename << std::endl;
+        return 1;
+    }
+    char magic[sizeof(GRAPH_MAGIC)];
+    uint32_t version;
+    uint8_t widths[2];
+    uint64_t sizes[2];
+    bool ok = fread(magic, sizeof(magic), 1, file) == 1
+              && std::memcmp(magic, GRAPH_MAGIC, sizeof(magic)) == 0
+              && fread(&version, sizeof(version), 1, file) == 1
+              && version == GRAPH_VERSION
+              && fread(widths, sizeof(widths), 1, file) == 1
+              && widths[0] == sizeof(NodeID) && widths[1] == sizeof(EdgeID)
+              && fread(sizes, sizeof(sizes), 1, file) == 1
+              && sizes[0] > 0;
+    if (!ok) {
+        fclose(file);
+        std::cerr << filename << " is not a compatible binary graph file" << std::endl;
+        return 1;
+    }
+    std::vector<EdgeID> nodes(sizes[0]);
+    std::vector<NodeID> edges(sizes[1]);
+    ok = readArray(file, nodes) && readArray(file, edges) && nodes.back() == edges.size();
+    fclose(file);
+    if (!ok) {
+        std::cerr << "Binary graph " << filename << " is truncated" << std::endl;
+        return 1;
+    }
+    G.set_csr(std::move(nodes), std::move(edges));
+    return 0;
+}
+
+int graph_io::parseGraphBinary(graph_access &G, const std::string &data) {
+    const size_t headerSize = sizeof(GRAPH_MAGIC) + sizeof(GRAPH_VERSION) + 2 * sizeof(uint8_t) + 2 * sizeof(uint64_t);
+    uint32_t version;
+    uint8_t widths[2];
+    uint64_t sizes[2];
+    bool ok = data.size() >= headerSize && std::memcmp(data.data(), GRAPH_MAGIC, sizeof(GRAPH_MAGIC)) == 0;
+    if (ok) {
+        const char *header = data.data() + sizeof(GRAPH_MAGIC);
+        std::memcpy(&version, header, sizeof(version));
+        std::memcpy(widths, header + sizeof(version), sizeof(widths));
+        std::memcpy(sizes, header + sizeof(version) + sizeof(widths), sizeof(sizes));
+        const size_t available = data.size() - headerSize;
+        ok = version == GRAPH_VERSION
+             && widths[0] == sizeof(NodeID) && widths[1] == sizeof(EdgeID)
+             && sizes[0] > 0 && sizes[0] - 1 < std::numeric_limits<NodeID>::max()
+             && sizes[0] <= available / sizeof(EdgeID)
+             && sizes[1] <= (available - sizes[0] * sizeof(EdgeID)) / sizeof(NodeID)
+             && available == sizes[0] * sizeof(EdgeID) + sizes[1] * sizeof(NodeID);
+    }
+    if (!ok) {
+        std::cerr << "The data is not a compatible binary graph" << std::endl;
+        return 1;
+    }
+    std::vector<EdgeID> nodes(sizes[0]);
+    std::vector<NodeID> edges(sizes[1]);
+    std::memcpy(nodes.data(), data.data() + headerSize, nodes.size() * sizeof(EdgeID));
+    std::memcpy(edges.data(), data.data() + headerSize + nodes.size() * sizeof(EdgeID), edges.size() * sizeof(NodeID));
+    const NodeID n = static_cast<NodeID>(nodes.size() - 1);
+    ok = nodes.front() == 0 && nodes.back() == edges.size();
+    for (NodeID node = 0; ok && node < n; node++) {
+        ok = nodes[node] <= nodes[node + 1];
+    }
+    for (EdgeID e = 0; ok && e < edges.size(); e++) {
+        ok = edges[e] < n;
+    }
+    if (!ok) {
+        std::cerr << "The binary graph has inconsistent CSR arrays" << std::endl;
+        return 1;
+    }
+    G.set_csr(std::move(nodes), std::move(edges));
+    return 0;
+}
+
+int graph_io::parseGraphMetis(graph_access &G, const std::string &data) {
+    std::istringstream in(data);
+    std::string line;
+    do {
+        if (!std::getline(in, line)) {
+            std::cerr << "The METIS data has no header" << std::endl;
+            return 1;
+        }
+    } while (line.empty() || line[0] == '%');
+
+    uint64_t nmbNodes = 0;
+    uint64_t nmbEdges = 0;
+    int ew = 0;
+    std::istringstream header(line);
+    if (!(header >> nmbNodes >> nmbEdges)) {
+        std::cerr << "The METIS header is malformed" << std::endl;
+        return 1;
+    }
+    header >> ew;
+    if (nmbNodes >= std::numeric_limits<NodeID>::max() || 2 * nmbEdges > std::numeric_limits<EdgeID>::max()) {
+        std::cerr << "The METIS graph is too large for the id types" << std::endl;
+        return 1;
+    }
+    const bool read_ew = ew == 1 || ew == 11;
+    const bool read_nw = ew == 10 || ew == 11;
+
+    std::vector<EdgeID> nodes(1, 0);
+    std::vector<NodeID> edges;
+    edges.reserve(2 * nmbEdges);
+    while (nodes.size() <= nmbNodes && std::getline(in, line)) {
+        if (!line.empty() && line[0] == '%') {
+            continue;
+        }
+        const NodeID node = static_cast<NodeID>(nodes.size() - 1);
+        std::istringstream sstream(line);
+        uint64_t value;
+        if (read_nw) {
+            sstream >> value;
+        }
+        while (sstream >> value) {
+            if (value == 0 || value > nmbNodes || value - 1 == node || edges.size() == 2 * nmbEdges) {
+                std::cerr << "Node " << node + 1 << " has an invalid edge to " << value << std::endl;
+                return 1;
+            }
+            edges.push_back(static_cast<NodeID>(value - 1));
+            if (read_ew) {
+                sstream >> value;
+            }
+        }
+        nodes.push_back(edges.size());
+    }
+    if (nodes.size() != nmbNodes + 1 || edges.size() != 2 * nmbEdges) {
+        std::cerr << "The METIS data has " << nodes.size() - 1 << " nodes and " << edges.size()
+                  << " edges, expected " << nmbNodes << " and " << 2 * nmbEdges << std::endl;
+        return 1;
+    }
+    G.set_csr(std::move(nodes), std::move(edges));
+    return 0;
+}
+
+graph_io::graph_cache &graph_io::graph_cache::global() {
+    static graph_cache cache;
+    return cache;
+}
+
+std::shared_ptr<const graph_access> graph_io::graph_cache::get(const std::string &filename) {
+    int64_t mtime;
+    uint64_t size;
+    if (!fileState(filename, mtime, size)) {
+        std::cerr << "Error opening " << filename << std::endl;
+        return nullptr;
+    }
+    uint64_t key;
+    bool known;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto state = m_files.find(filename);
+        known = state != m_files.end() && state->second.mtime == mtime && state->second.size == size;
+        key = known ? state->second.key : 0;
+    }
+    if (!known) {
+        if (!hashFile(filename, mtime, key)) {
+            std::cerr << "Error reading " << filename << std::endl;
+            return nullptr;
+        }
+    }
+
+    std::promise<std::shared_ptr<const graph_access>> parsed;
+    std::shared_future<std::shared_ptr<const graph_access>> pending;
+    std::string binaryFilename;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!known) {
+            m_files[filename] = {mtime, size, key};
+        }
+        auto cached = m_graphs.find(key);
+        if (cached != m_graphs.end()) {
+            pending = cached->second;
+        } else {
+            //Placeholder for concurrent requests of the same file
+            m_graphs[key] = parsed.get_future().share();
+            if (!m_cache_directory.empty()) {
+                char name[32];
+                snprintf(name, sizeof(name), "/%016llx.csr", static_cast<unsigned long long>(key));
+                binaryFilename = m_cache_directory + name;
+            }
+        }
+    }
+    if (pending.valid()) {
+        return pending.get();
+    }
+
+    std::shared_ptr<graph_access> G = std::make_shared<graph_access>();
+    struct stat st;
+    bool loaded = !binaryFilename.empty() && stat(binaryFilename.c_str(), &st) == 0
+                  && readGraphBinary(*G, binaryFilename) == 0;
+    if (!loaded && readGraph(*G, filename) == 0) {
+        loaded = true;
+        if (!binaryFilename.empty()) {
+            //A failed write only costs the parsing time of the next process
+            writeGraphBinary(*G, binaryFilename);
+        }
+    }
+    if (!loaded) {
+        G.reset();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        //Unreadable files are not kept, unless the placeholder has been released in the meantime
+        auto placeholder = m_graphs.find(key);
+        if (placeholder != m_graphs.end()
+            && placeholder->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            m_graphs.erase(placeholder);
+        }
+    }
+    parsed.set_value(G);
+    return G;
+}
+
+void graph_io::graph_cache::set_cache_directory(const std::string &cacheDirectory) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cache_directory = cacheDirectory;
+}
+
+void graph_io::graph_cache::release(const std::string &filename) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto state = m_files.find(filename);
+    if (state == m_files.end()) {
+        return;
+    }
+    m_graphs.erase(state->second.key);
+    m_files.erase(state);
+}
+
+void graph_io::graph_cache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_files.clear();
+    m_graphs.clear();
+}
+
+size_t graph_io::graph_cache::size() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_graphs.size();
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "../graph.h"
+
+namespace graph_io {
+    /**
+     * Reads a graph in DIMACS format if the file name ends with .col, .col.gz or .col.zst
+     * (see readGraphDimacs) and in METIS format otherwise (see readGraphWeighted).
+     * @return 0 on success, 1 otherwise
+     */
+    int readGraph(graph_access &G, const std::string &filename);
+
+    /**
+     * Writes the CSR arrays of the graph in a binary format that can be loaded without parsing.
+     * The file is replaced atomically.
+     * @return 0 on success, 1 otherwise
+     */
+    int writeGraphBinary(const graph_access &G, const std::string &filename);
+
+    /**
+     * Reads a graph written by writeGraphBinary. Files written with different id widths are rejected.
+     * @return 0 on success, 1 otherwise
+     */
+    int readGraphBinary(graph_access &G, const std::string &filename);
+
+    /**
+     * Parses a graph in the format of writeGraphBinary from memory. In contrast to readGraphBinary, the CSR arrays
+     * are validated (monotonic offsets, targets within range), so the data may come from untrusted sources.
+     * @return 0 on success, 1 otherwise (G is unchanged)
+     */
+    int parseGraphBinary(graph_access &G, const std::string &data);
+
+    /**
+     * Parses a graph in METIS format from memory. Node and edge weights are skipped.
+     * Malformed input (wrong counts, targets out of range, self-loops) is reported. Unlike readGraphWeighted, self-loops
+     * are rejected and \p G is left unchanged on failure.
+     * @return 0 on success, 1 otherwise (G is unchanged)
+     */
+    int parseGraphMetis(graph_access &G, const std::string &data);
+
+    /**
+     * Registry of parsed graphs. A graph is identified by a hash of the file content and its modification time,
+     * so every file is parsed at most once per process as long as it does not change.
+     * If a cache directory is set, parsed graphs are additionally stored there in binary form (see writeGraphBinary)
+     * and later processes load them from there instead of parsing the original file.
+     */
+    class graph_cache {
+    public:
+        /**
+         * @param cacheDirectory an existing directory for the binary graphs (empty = keep graphs in memory only)
+         */
+        explicit graph_cache(const std::string &cacheDirectory = "")
+            :   m_cache_directory(cacheDirectory)
+        {}
+
+        /**
+         * @return the process-wide cache
+         */
+        static graph_cache &global();
+
+        /**
+         * Thread-safe. The returned graph is shared with every other caller requesting the same file.
+         * Files are hashed and parsed without holding the lock of the registry, so requests of other files
+         * are not blocked. Concurrent requests of the same file wait for the first one to parse it.
+         * @param filename a graph file (see readGraph)
+         * @return the parsed graph or nullptr if the file could not be read
+         */
+        std::shared_ptr<const graph_access> get(const std::string &filename);
+
+        void set_cache_directory(const std::string &cacheDirectory);
+
+        /**
+         * Releases the graph of \p filename (and of every other file with the same content). Graphs still
+         * referenced by callers stay valid.
+         * @param filename a file passed to get before
+         */
+        void release(const std::string &filename);
+
+        /**
+         * Releases all graphs held by the registry. Graphs still referenced by callers stay valid.
+         */
+        void clear();
+
+        /**
+         * @return the number of graphs held (or currently parsed) by the registry
+         */
+        size_t size();
+
+    private:
+        struct file_state {
+            int64_t mtime;
+            uint64_t size;
+            uint64_t key;
+        };
+
+        std::mutex m_mutex;
+        std::string m_cache_directory;
+        /**< Avoids rehashing unchanged files */
+        std::unordered_map<std::string, file_state> m_files;
+        /**< Becomes ready once the graph is parsed */
+        std::unordered_map<uint64_t, std::shared_future<std::shared_ptr<const graph_access>>> m_graphs;
+    };
+}
@@ -1,6 +1,7 @@
 #include "graph_io.h"
 
-int graph_io::readGraphWeighted(graph_access &G, const std::string &filename) {
+template<typename NodeIDType, typename EdgeIDType>
+int graph_io::readGraphWeighted(basic_graph_access<NodeIDType, EdgeIDType> &G, const std::string &filename) {
     std::string line;
 
     // open file for reading
@@ -10,8 +11,13 @@ int graph_io::readGraphWeighted(graph_access &G, const std::string &filename) {
         return 1;
     }
 
-    NodeID nmbNodes;
-    EdgeID nmbEdges;
+    //Every node needs a line and every edge at least two characters, which bounds the allocated memory
+    in.seekg(0, std::ios::end);
+    const uint64_t fileSize = static_cast<uint64_t>(in.tellg());
+    in.seekg(0, std::ios::beg);
+
+    uint64_t nmbNodes = 0;
+    uint64_t nmbEdges = 0;
 
     std::getline(in, line);
     //skip commentsm
@@ -21,13 +27,21 @@ int graph_io::readGraphWeighted(graph_access &G, const std::string &filename) {
 
     int ew = 0;
     std::stringstream ss(line);
-    ss >> nmbNodes;
-    ss >> nmbEdges;
+    if ( !(ss >> nmbNodes >> nmbEdges) ) {
+        std::cerr <<  "The header of " << filename << " is malformed"  << std::endl;
+        return 1;
+    }
     ss >> ew;
 
-    if ( 2 * nmbEdges > std::numeric_limits<int>::max() || nmbNodes > std::numeric_limits<int>::max()) {
-        std::cerr <<  "The graph is too large. Currently only 32bit supported!"  << std::endl;
-        exit(0);
+    if ( 2 * nmbEdges > std::numeric_limits<EdgeIDType>::max() || nmbNodes >= std::numeric_limits<NodeIDType>::max()) {
+        std::cerr <<  "The graph is too large for " << 8 * sizeof(NodeIDType) << "bit node ids and "
+                  << 8 * sizeof(EdgeIDType) << "bit edge ids. Use graph_access64 "
+                  << "(or build with COLOURING_64BIT_EDGES)!"  << std::endl;
+        return 1;
+    }
+    if ( nmbNodes > fileSize || nmbEdges > fileSize ) {
+        std::cerr <<  "The header of " << filename << " specifies more nodes or edges than the file contains"  << std::endl;
+        return 1;
     }
 
     bool read_ew = false;
@@ -43,8 +57,8 @@ int graph_io::readGraphWeighted(graph_access &G, const std::string &filename) {
     }
     nmbEdges *= 2; //since we have forward and backward edges
 
-    NodeID node_counter   = 0;
-    EdgeID edge_counter   = 0;
+    uint64_t node_counter   = 0;
+    uint64_t edge_counter   = 0;
     long long total_nodeweight = 0;
 
     G.start_construction(nmbNodes, nmbEdges);
@@ -55,7 +69,12 @@ int graph_io::readGraphWeighted(graph_access &G, const std::string &filename) {
             continue;
         }
 
-        NodeID node = G.new_node();
+        if ( node_counter == nmbNodes ) {
+            std::cerr <<  "number of specified nodes mismatch"  << std::endl;
+            std::cerr <<  "more than " << nmbNodes << " nodes"  << std::endl;
+            return 1;
+        }
+        NodeIDType node = G.new_node();
         node_counter++;
         std::stringstream sstream(line);
 
@@ -66,12 +85,16 @@ int graph_io::readGraphWeighted(graph_access &G, const std::string &filename) {
             if ( total_nodeweight > (long long) std::numeric_limits<NodeID>::max()) {
                 std::cerr <<  "The sum of the node weights is too large (it exceeds the node weight type)."  << std::endl;
                 std::cerr <<  "Currently not supported. Please scale your node weights."  << std::endl;
-                exit(0);
+                return 1;
             }
         }
 
-        NodeID target;
+        uint64_t target;
         while ( sstream >> target ) {
+            if ( target == 0 || target > nmbNodes || edge_counter == nmbEdges ) {
+                std::cerr <<  "Node " << node + 1 << " has an invalid edge to " << target  << std::endl;
+                return 1;
+            }
             //check for self-loops
             if (target - 1 == node) {
                 std::cerr <<  "The graph file contains self-loops. This is not supported. Please remove them from the file."  << std::endl;
@@ -82,7 +105,7 @@ int graph_io::readGraphWeighted(graph_access &G, const std::string &filename) {
                 sstream >> edge_weight;
             }
             edge_counter++;
-            G.new_edge(node, target - 1);
+            G.new_edge(node, static_cast<NodeIDType>(target - 1));
         }
 
         if (in.eof()) {
@@ -90,19 +113,24 @@ int graph_io::readGraphWeighted(graph_access &G, const std::string &filename) {
         }
     }
 
-    if ( edge_counter != (EdgeID) nmbEdges ) {
+    if ( edge_counter != nmbEdges ) {
         std::cerr <<  "number of specified edges mismatch"  << std::endl;
         std::cerr <<  edge_counter <<  " " <<  nmbEdges  << std::endl;
-        exit(0);
+        return 1;
     }
 
-    if ( node_counter != (NodeID) nmbNodes) {
+    if ( node_counter != nmbNodes) {
         std::cerr <<  "number of specified nodes mismatch"  << std::endl;
         std::cerr <<  node_counter <<  " " <<  nmbNodes  << std::endl;
-        exit(0);
+        return 1;
     }
 
 
     G.finish_construction();
     return 0;
 }
+
+template int graph_io::readGraphWeighted(graph_access &G, const std::string &filename);
+#ifndef COLOURING_64BIT_EDGES
+template int graph_io::readGraphWeighted(graph_access64 &G, const std::string &filename);
+#endif
@@ -34,5 +34,12 @@
 #include "../graph.h"
 
 namespace graph_io {
-    int readGraphWeighted(graph_access &G, const std::string &filename);
+    /**
+     * Reads a graph in METIS format.
+     * Instantiated for graph_access and graph_access64. The graph must fit into the id types of \p G.
+     * Malformed files (wrong counts, targets out of range, too large graphs) are reported, not fatal.
+     * @return 0 on success, 1 otherwise (G is then unspecified)
+     */
+    template<typename NodeIDType, typename EdgeIDType>
+    int readGraphWeighted(basic_graph_access<NodeIDType, EdgeIDType> &G, const std::string &filename);
 }
@@ -0,0 +1,259 @@
+#include "batch.h"
+#include "bounds/clique.h"
+#include "init/dsatur.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace graph_colouring;
+
+/**
+ * Maps the used colours to 0, 1, ..., colorCount(s) - 1 keeping their order
+ */
+static void compactColours(Colouring &s) {
+    std::vector<Color> used;
+    for (auto c : s) {
+        if (c != UNCOLORED) {
+            if (c >= used.size()) {
+                used.resize(c + 1, UNCOLORED);
+            }
+            used[c] = 0;
+        }
+    }
+    Color next = 0;
+    for (auto &c : used) {
+        if (c != UNCOLORED) {
+            c = next++;
+        }
+    }
+    for (auto &c : s) {
+        if (c != UNCOLORED) {
+            c = used[c];
+        }
+    }
+}
+
+/**
+ * Removes the smallest colour class of a valid colouring with k colours. Its nodes are moved one after another
+ * to the colour with the fewest (already coloured) neighbours.
+ * @return a colouring with k - 1 colours, possibly with conflicts
+ */
+static Colouring removeSmallestClass(const graph_access &G, const Colouring &s, const ColorCount k) {
+    std::vector<NodeID> classSizes(k);
+    for (auto c : s) {
+        classSizes[c]++;
+    }
+    auto removed = Color(std::min_element(classSizes.begin(), classSizes.end()) - classSizes.begin());
+
+    Colouring reduced(s);
+    std::vector<NodeID> moved;
+    for (NodeID n = 0; n < G.number_of_nodes(); n++) {
+        if (reduced[n] == removed) {
+            reduced[n] = UNCOLORED;
+            moved.push_back(n);
+        } else if (reduced[n] > removed) {
+            reduced[n]--;
+        }
+    }
+    std::vector<NodeID> neighbourColours(k - 1);
+    for (auto n : moved) {
+        std::fill(neighbourColours.begin(), neighbourColours.end(), 0);
+        for (auto neighbour : G.neighbours(n)) {
+            if (reduced[neighbour] != UNCOLORED) {
+                neighbourColours[reduced[neighbour]]++;
+            }
+        }
+        reduced[n] = Color(std::min_element(neighbourColours.begin(), neighbourColours.end())
+                           - neighbourColours.begin());
+    }
+    return reduced;
+}
+
+/**
+ * Tabu search for a colouring with k colours and without conflicts (see tabuSearchOperator). In contrast to
+ * tabuSearchOperator, the conflicts of every node with every colour are updated incrementally, so an iteration
+ * costs O(conflicting nodes * k + degree) instead of a full conflict count per candidate move.
+ * After moving a node, it may not return to its previous colour for a random(0, A - 1) + alpha * conflicting
+ * nodes iterations, unless the move leads to a colouring with fewer conflicts than found so far.
+ * @param s a colouring with the colours 0, ..., k - 1, replaced by the colouring with the fewest conflicts
+ * @return the number of conflicting edges of \p s
+ */
+static size_t tabuColour(const graph_access &G,
+                         Colouring &s,
+                         const ColorCount k,
+                         const BatchParameters &parameters,
+                         std::mt19937 &generator) {
+    const NodeID V = G.number_of_nodes();
+    //conflicts[v * k + c] = the number of neighbours of v with colour c
+    std::vector<NodeID> conflicts(size_t(V) * k);
+    size_t conflictingEdges = 0;
+    for (NodeID v = 0; v < V; v++) {
+        for (auto neighbour : G.neighbours(v)) {
+            conflicts[size_t(v) * k + s[neighbour]]++;
+        }
+        conflictingEdges += conflicts[size_t(v) * k + s[v]];
+    }
+    conflictingEdges /= 2;
+
+    std::vector<size_t> tabu(size_t(V) * k);
+    std::uniform_int_distribution<size_t> distribution(0, parameters.A - 1);
+    Colouring current(s);
+    size_t currentEdges = conflictingEdges;
+    for (size_t l = 0; l < parameters.L && conflictingEdges > 0; l++) {
+        NodeID conflictingNodes = 0;
+        int64_t bestDelta = std::numeric_limits<int64_t>::max();
+        NodeID bestNode = 0;
+        Color bestColour = 0;
+        size_t ties = 0;
+        for (NodeID v = 0; v < V; v++) {
+            auto own = conflicts[size_t(v) * k + current[v]];
+            if (own == 0) {
+                continue;
+            }
+            conflictingNodes++;
+            for (Color c = 0; c < k; c++) {
+                if (c == current[v]) {
+                    continue;
+                }
+                auto delta = int64_t(conflicts[size_t(v) * k + c]) - int64_t(own);
+                bool aspiration = int64_t(currentEdges) + delta < int64_t(conflictingEdges);
+                if (tabu[size_t(v) * k + c] > l && !aspiration) {
+                    continue;
+                }
+                if (delta < bestDelta) {
+                    bestDelta = delta;
+                    ties = 1;
+                } else if (delta == bestDelta) {
+                    //choose uniformly among the best moves
+                    ties++;
+                    if (std::uniform_int_distribution<size_t>(0, ties - 1)(generator) != 0) {
+                        continue;
+                    }
+                } else {
+                    continue;
+                }
+                bestNode = v;
+                bestColour = c;
+            }
+        }
+        //every move is tabu
+        if (ties == 0) {
+            continue;
+        }
+
+        auto previous = current[bestNode];
+        for (auto neighbour : G.neighbours(bestNode)) {
+            conflicts[size_t(neighbour) * k + previous]--;
+            conflicts[size_t(neighbour) * k + bestColour]++;
+        }
+        current[bestNode] = bestColour;
+        currentEdges = size_t(int64_t(currentEdges) + bestDelta);
+        tabu[size_t(bestNode) * k + previous] = l + 1 + distribution(generator)
+                                               + size_t(parameters.alpha * conflictingNodes);
+        if (currentEdges < conflictingEdges) {
+            conflictingEdges = currentEdges;
+            s = current;
+        }
+    }
+    return conflictingEdges;
+}
+
+ColouringResult graph_colouring::colourSmallGraph(const graph_access &G,
+                                                  const BatchParameters &parameters,
+                                                  std::mt19937 &generator) {
+    ColouringResult result;
+    result.s = dsaturColouring(G);
+    result.isValid = true;
+    if (G.number_of_nodes() == 0) {
+        return result;
+    }
+
+    ColorCount k = colorCount(result.s);
+    ColorCount lowerBound = std::max<ColorCount>(1, cliqueLowerBound(G, parameters.cliqueStepLimit));
+    while (k > lowerBound) {
+        auto candidate = removeSmallestClass(G, result.s, k);
+        size_t conflictingEdges = numberOfConflictingEdges(G, candidate);
+        for (size_t itr = 0; itr < parameters.maxItr && conflictingEdges > 0; itr++) {
+            conflictingEdges = tabuColour(G, candidate, k - 1, parameters, generator);
+        }
+        if (conflictingEdges > 0) {
+            break;
+        }
+        //the search may empty further colour classes
+        compactColours(candidate);
+        result.s = candidate;
+        k = colorCount(candidate);
+    }
+    return result;
+}
+
+ColouringPool::ColouringPool(const size_t threadCount) {
+    for (size_t t = 0; t < std::max<size_t>(1, threadCount); t++) {
+        workers.emplace_back(&ColouringPool::workerLoop, this);
+    }
+}
+
+ColouringPool::~ColouringPool() {
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+void ColouringPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        tasks.push_back(std::move(task));
+    }
+    taskAvailable.notify_one();
+}
+
+void ColouringPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+            //the remaining tasks are executed before the pool stops
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+std::vector<ColouringResult> ColouringPool::colourBatch(const std::vector<const graph_access *> &graphs,
+                                                        const BatchParameters &parameters) {
+    std::vector<ColouringResult> results(graphs.size());
+    size_t remaining = graphs.size();
+    std::mutex batchMutex;
+    std::condition_variable batchDone;
+    for (size_t i = 0; i < graphs.size(); i++) {
+        submit([&, i] {
+            std::seed_seq seeds{uint32_t(parameters.seed), uint32_t(parameters.seed >> 32), uint32_t(i)};
+            std::mt19937 generator(seeds);
+            results[i] = colourSmallGraph(*graphs[i], parameters, generator);
+            std::lock_guard<std::mutex> guard(batchMutex);
+            if (--remaining == 0) {
+                batchDone.notify_one();
+            }
+        });
+    }
+    std::unique_lock<std::mutex> lock(batchMutex);
+    batchDone.wait(lock, [&] { return remaining == 0; });
+    return results;
+}
+
+std::vector<ColouringResult> graph_colouring::colourBatch(const std::vector<const graph_access *> &graphs,
+                                                          const BatchParameters &parameters,
+                                                          const size_t threadCount) {
+    ColouringPool pool(std::min(std::max<size_t>(1, threadCount), std::max<size_t>(1, graphs.size())));
+    return pool.colourBatch(graphs, parameters);
+}
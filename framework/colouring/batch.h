@@ -0,0 +1,113 @@
+#pragma once
+
+#include "graph_colouring.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace graph_colouring {
+
+    /**
+     * Parameters of the single threaded colouring task used for every graph of a batch
+     */
+    struct BatchParameters {
+        /**< Number of iterations of a single tabu search run */
+        size_t L = 1000;
+        /**< Tuning parameter for the tabu list length */
+        size_t A = 2;
+        /**< Tuning parameter for the tabu list length */
+        double alpha = 0.6;
+        /**< The number of tabu search runs for each k before the task returns the best colouring found */
+        size_t maxItr = 10;
+        /**< The maximum number of branch and bound steps for the clique lower bound of each graph (see
+         * findLargeClique). The task stops as soon as k reaches the bound. A work limit instead of a time limit
+         * keeps the bound independent of the load of the machine. */
+        size_t cliqueStepLimit = 1 << 14;
+        /**< Together with the index of a graph in its batch, seeds the random number generator of its task.
+         * The results therefore do not depend on the number of threads or the order of execution. */
+        uint64_t seed = 0;
+    };
+
+    /**
+     * Colours a (small) graph with the calling thread: a DSatur colouring provides the initial k and
+     * afterwards tabu search tries to remove one colour at a time, starting from the best valid colouring with
+     * the nodes of the removed colour moved to the colour with the fewest conflicts. Unlike tabuSearchOperator,
+     * the tabu search updates the conflicts of every node and colour incrementally.
+     * @param G the target graph
+     * @param parameters the tabu search parameters and limits
+     * @param generator the source of random numbers
+     * @return the best colouring found (always valid)
+     */
+    ColouringResult colourSmallGraph(const graph_access &G,
+                                     const BatchParameters &parameters,
+                                     std::mt19937 &generator);
+
+    /**
+     * A fixed set of worker threads executing tasks in submission order.
+     * The threads are started once and shared by all batches, so that colouring many small graphs does not
+     * pay the thread startup (and the population requirements) of ColouringAlgorithm::perform per graph.
+     */
+    class ColouringPool {
+    public:
+        /**
+         * Starts the worker threads
+         * @param threadCount the number of worker threads (at least one)
+         */
+        explicit ColouringPool(size_t threadCount = std::thread::hardware_concurrency());
+
+        /**
+         * Waits for all submitted tasks and stops the worker threads
+         */
+        ~ColouringPool();
+
+        ColouringPool(const ColouringPool &) = delete;
+
+        ColouringPool &operator=(const ColouringPool &) = delete;
+
+        /**
+         * @return the number of worker threads
+         */
+        size_t threadCount() const {
+            return workers.size();
+        }
+
+        /**
+         * Schedules a task for execution by one of the worker threads.
+         * The task must not throw.
+         */
+        void submit(std::function<void()> task);
+
+        /**
+         * Colours every graph with colourSmallGraph, one task per graph, and waits for all of them.
+         * Several threads may colour batches concurrently.
+         * @param graphs the target graphs (they must not change until the call returns)
+         * @param parameters the parameters of every task
+         * @return results[i] = the colouring of graphs[i]
+         */
+        std::vector<ColouringResult> colourBatch(const std::vector<const graph_access *> &graphs,
+                                                 const BatchParameters &parameters);
+
+    private:
+        void workerLoop();
+
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+        std::condition_variable taskAvailable;
+        bool stopping = false;
+    };
+
+    /**
+     * Colours a batch of graphs with a temporary pool (see ColouringPool::colourBatch)
+     * @param graphs the target graphs
+     * @param parameters the parameters of every task
+     * @param threadCount the number of worker threads
+     * @return results[i] = the colouring of graphs[i]
+     */
+    std::vector<ColouringResult> colourBatch(const std::vector<const graph_access *> &graphs,
+                                             const BatchParameters &parameters,
+                                             size_t threadCount = std::thread::hardware_concurrency());
+}
@@ -0,0 +1,307 @@
+#include "clique.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace graph_colouring {
+
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * Computes a degeneracy ordering by repeatedly removing a node of minimal degree
+     * @param G the target graph
+     * @param position position[n] = the index of node n within the ordering
+     * @return the nodes in the order they have been removed
+     */
+    static std::vector<NodeID> degeneracyOrdering(const graph_access &G,
+                                                  std::vector<NodeID> &position) {
+        const NodeID n = G.number_of_nodes();
+        EdgeID maxDegree = 0;
+        std::vector<EdgeID> degree(n);
+        for (NodeID node = 0; node < n; node++) {
+            degree[node] = G.getNodeDegree(node);
+            maxDegree = std::max(maxDegree, degree[node]);
+        }
+
+        //Bucket sort of the nodes by their degree
+        std::vector<NodeID> bucketStart(maxDegree + 2, 0);
+        for (NodeID node = 0; node < n; node++) {
+            bucketStart[degree[node] + 1]++;
+        }
+        for (EdgeID d = 1; d < bucketStart.size(); d++) {
+            bucketStart[d] += bucketStart[d - 1];
+        }
+        std::vector<NodeID> ordering(n);
+        position.resize(n);
+        {
+            std::vector<NodeID> next(bucketStart.begin(), bucketStart.end() - 1);
+            for (NodeID node = 0; node < n; node++) {
+                position[node] = next[degree[node]]++;
+                ordering[position[node]] = node;
+            }
+        }
+
+        for (NodeID i = 0; i < n; i++) {
+            NodeID node = ordering[i];
+            for (auto neighbour : G.neighbours(node)) {
+                if (position[neighbour] <= i || degree[neighbour] <= degree[node]) {
+                    continue;
+                }
+                //Move the neighbour to the front of its bucket and shrink the bucket afterwards
+                auto d = degree[neighbour];
+                NodeID front = std::max<NodeID>(bucketStart[d], i + 1);
+                NodeID swapped = ordering[front];
+                std::swap(ordering[front], ordering[position[neighbour]]);
+                position[swapped] = position[neighbour];
+                position[neighbour] = front;
+                bucketStart[d] = front + 1;
+                degree[neighbour]--;
+            }
+        }
+        return ordering;
+    }
+
+    /**
+     * Exact maximum clique search within a small candidate set whose adjacency is stored as bitsets
+     */
+    class BitsetCliqueSearch {
+    public:
+        /**
+         * @param steps the number of branch and bound steps of all searches so far, updated by solve
+         * @param maxSteps the search stops after this number of steps of all searches
+         */
+        BitsetCliqueSearch(const size_t size,
+                           const Clock::time_point deadline,
+                           size_t &steps,
+                           const size_t maxSteps)
+                : size(size),
+                  words((size + 63) / 64),
+                  adjacency(size * words, 0),
+                  deadline(deadline),
+                  timedOut(false),
+                  steps(steps),
+                  maxSteps(maxSteps) {
+        }
+
+        void addEdge(const size_t u, const size_t v) {
+            adjacency[u * words + v / 64] |= uint64_t(1) << (v % 64);
+            adjacency[v * words + u / 64] |= uint64_t(1) << (u % 64);
+        }
+
+        /**
+         * @param lowerBound the size of the best known clique
+         * @return the local indices of a clique larger than \p lowerBound or an empty vector
+         */
+        std::vector<size_t> solve(const size_t lowerBound) {
+            best.clear();
+            bestSize = lowerBound;
+            current.clear();
+            std::vector<uint64_t> candidates(words, 0);
+            for (size_t v = 0; v < size; v++) {
+                candidates[v / 64] |= uint64_t(1) << (v % 64);
+            }
+            expand(candidates);
+            return best;
+        }
+
+        /**
+         * @return true if the search has been stopped by the deadline or the step limit
+         */
+        bool hasTimedOut() const {
+            return timedOut;
+        }
+
+    private:
+        void expand(std::vector<uint64_t> &candidates) {
+            if (++steps >= maxSteps || (steps % 1024 == 0 && Clock::now() > deadline)) {
+                timedOut = true;
+            }
+            if (timedOut) {
+                return;
+            }
+
+            //Greedy colouring of the candidates: a clique contains at most one node of every colour class
+            std::vector<size_t> order;
+            std::vector<size_t> colourBound;
+            std::vector<uint64_t> uncoloured(candidates);
+            std::vector<uint64_t> colourClass(words);
+            size_t colour = 0;
+            while (!isEmpty(uncoloured)) {
+                colour++;
+                colourClass = uncoloured;
+                while (!isEmpty(colourClass)) {
+                    size_t v = firstBit(colourClass);
+                    clearBit(colourClass, v);
+                    clearBit(uncoloured, v);
+                    const uint64_t *row = &adjacency[v * words];
+                    for (size_t w = 0; w < words; w++) {
+                        colourClass[w] &= ~row[w];
+                    }
+                    order.push_back(v);
+                    colourBound.push_back(colour);
+                }
+            }
+
+            std::vector<uint64_t> nextCandidates(words);
+            for (size_t i = order.size(); i-- > 0;) {
+                if (current.size() + colourBound[i] <= bestSize || timedOut) {
+                    return;
+                }
+                size_t v = order[i];
+                current.push_back(v);
+                const uint64_t *row = &adjacency[v * words];
+                for (size_t w = 0; w < words; w++) {
+                    nextCandidates[w] = candidates[w] & row[w];
+                }
+                if (isEmpty(nextCandidates)) {
+                    if (current.size() > bestSize) {
+                        best = current;
+                        bestSize = current.size();
+                    }
+                } else {
+                    expand(nextCandidates);
+                }
+                current.pop_back();
+                clearBit(candidates, v);
+            }
+        }
+
+        bool isEmpty(const std::vector<uint64_t> &set) const {
+            for (auto word : set) {
+                if (word != 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        size_t firstBit(const std::vector<uint64_t> &set) const {
+            for (size_t w = 0; w < words; w++) {
+                if (set[w] != 0) {
+                    return w * 64 + __builtin_ctzll(set[w]);
+                }
+            }
+            return size;
+        }
+
+        static void clearBit(std::vector<uint64_t> &set, const size_t v) {
+            set[v / 64] &= ~(uint64_t(1) << (v % 64));
+        }
+
+        const size_t size;
+        const size_t words;
+        /**< adjacency[u * words + w] = the w-th word of the neighbourhood of u */
+        std::vector<uint64_t> adjacency;
+        const Clock::time_point deadline;
+        bool timedOut;
+        size_t &steps;
+        const size_t maxSteps;
+        size_t bestSize;
+        std::vector<size_t> current;
+        std::vector<size_t> best;
+    };
+
+    /**
+     * findLargeClique with both a deadline and a limit of the branch and bound steps
+     */
+    static std::vector<NodeID> findLargeClique(const graph_access &G,
+                                               const Clock::time_point deadline,
+                                               const size_t maxSteps) {
+        const NodeID n = G.number_of_nodes();
+        if (n == 0) {
+            return {};
+        }
+
+        std::vector<NodeID> position;
+        auto ordering = degeneracyOrdering(G, position);
+
+        //later[n] = the neighbours of n succeeding it in the degeneracy ordering
+        auto laterNeighbours = [&](const NodeID node, std::vector<NodeID> &later) {
+            later.clear();
+            for (auto neighbour : G.neighbours(node)) {
+                if (position[neighbour] > position[node]) {
+                    later.push_back(neighbour);
+                }
+            }
+        };
+
+        std::vector<NodeID> bestClique = {ordering.back()};
+        std::vector<NodeID> later;
+        std::vector<NodeID> candidates;
+        std::vector<NodeID> mark(n, 0);
+        NodeID stamp = 0;
+
+        //Greedy phase: extend every node by the candidate appearing latest in the degeneracy ordering
+        for (NodeID i = n; i-- > 0;) {
+            NodeID node = ordering[i];
+            laterNeighbours(node, later);
+            if (later.size() + 1 <= bestClique.size()) {
+                continue;
+            }
+            std::vector<NodeID> clique = {node};
+            candidates = later;
+            while (!candidates.empty()) {
+                NodeID next = *std::max_element(candidates.begin(), candidates.end(), [&](NodeID a, NodeID b) {
+                    return position[a] < position[b];
+                });
+                clique.push_back(next);
+                stamp++;
+                for (auto neighbour : G.neighbours(next)) {
+                    mark[neighbour] = stamp;
+                }
+                candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&](NodeID c) {
+                    return mark[c] != stamp;
+                }), candidates.end());
+            }
+            if (clique.size() > bestClique.size()) {
+                bestClique = clique;
+            }
+        }
+
+        //Exact phase: every clique is found within the later neighbourhood of its first node
+        std::vector<NodeID> localId(n, 0);
+        size_t steps = 0;
+        for (NodeID i = n; i-- > 0 && steps < maxSteps && Clock::now() < deadline;) {
+            NodeID node = ordering[i];
+            laterNeighbours(node, later);
+            if (later.size() + 1 <= bestClique.size()) {
+                continue;
+            }
+            stamp++;
+            for (NodeID j = 0; j < later.size(); j++) {
+                mark[later[j]] = stamp;
+                localId[later[j]] = j;
+            }
+            BitsetCliqueSearch search(later.size(), deadline, steps, maxSteps);
+            for (NodeID j = 0; j < later.size(); j++) {
+                for (auto neighbour : G.neighbours(later[j])) {
+                    if (mark[neighbour] == stamp && localId[neighbour] > j) {
+                        search.addEdge(j, localId[neighbour]);
+                    }
+                }
+            }
+            auto clique = search.solve(bestClique.size() - 1);
+            if (!clique.empty()) {
+                bestClique = {node};
+                for (auto v : clique) {
+                    bestClique.push_back(later[v]);
+                }
+            }
+            if (search.hasTimedOut()) {
+                break;
+            }
+        }
+        return bestClique;
+    }
+
+    std::vector<NodeID> findLargeClique(const graph_access &G,
+                                        const std::chrono::milliseconds timeLimit) {
+        return findLargeClique(G, Clock::now() + timeLimit, std::numeric_limits<size_t>::max());
+    }
+
+    std::vector<NodeID> findLargeClique(const graph_access &G,
+                                        const size_t maxSteps) {
+        return findLargeClique(G, Clock::time_point::max(), maxSteps);
+    }
+}
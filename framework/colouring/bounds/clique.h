@@ -0,0 +1,52 @@
+#pragma once
+
+#include "colouring/graph_colouring.h"
+
+#include <chrono>
+#include <vector>
+
+namespace graph_colouring {
+
+    /**
+     * Searches a large clique of the graph.
+     * A greedy search within the neighbourhood of every node provides an initial clique. Afterwards, the
+     * neighbourhood of every node (restricted to the nodes succeeding it in a degeneracy ordering) is solved
+     * exactly with a bitset branch and bound algorithm using greedy colourings as upper bounds.
+     * The search stops after \p timeLimit, in which case the returned clique is not necessarily maximum.
+     * @param G the target graph
+     * @param timeLimit the time available for the branch and bound search
+     * @return the nodes of the largest clique found
+     */
+    std::vector<NodeID> findLargeClique(const graph_access &G,
+                                        std::chrono::milliseconds timeLimit);
+
+    /**
+     * findLargeClique limited by the work of the branch and bound search instead of the time.
+     * The result only depends on the graph and \p maxSteps.
+     * @param G the target graph
+     * @param maxSteps the maximum number of branch and bound steps (0 = greedy search only)
+     * @return the nodes of the largest clique found
+     */
+    std::vector<NodeID> findLargeClique(const graph_access &G,
+                                        size_t maxSteps);
+
+    /**
+     * @param G the target graph
+     * @param timeLimit the time available for the clique search (see findLargeClique)
+     * @return a lower bound of the chromatic number of \p G
+     */
+    inline ColorCount cliqueLowerBound(const graph_access &G,
+                                       const std::chrono::milliseconds timeLimit) {
+        return static_cast<ColorCount>(findLargeClique(G, timeLimit).size());
+    }
+
+    /**
+     * @param G the target graph
+     * @param maxSteps the work limit of the clique search (see findLargeClique)
+     * @return a lower bound of the chromatic number of \p G, which only depends on \p G and \p maxSteps
+     */
+    inline ColorCount cliqueLowerBound(const graph_access &G,
+                                       const size_t maxSteps) {
+        return static_cast<ColorCount>(findLargeClique(G, maxSteps).size());
+    }
+}
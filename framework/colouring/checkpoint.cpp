@@ -0,0 +1,253 @@
+#include "checkpoint.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace graph_colouring {
+
+    constexpr size_t Checkpoint::FINISHED;
+
+    static const char CHECKPOINT_MAGIC[4] = {'G', 'C', 'C', 'P'};
+    static const uint32_t CHECKPOINT_VERSION = 1;
+
+    template<typename T>
+    static void writeValue(std::ostream &out, const T value) {
+        out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    static bool readValue(std::istream &in, T &value) {
+        return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+    }
+
+    /**
+     * @return the number of bytes between the read position and the end of \p in
+     */
+    static uint64_t remainingBytes(std::istream &in) {
+        auto position = in.tellg();
+        in.seekg(0, std::ios::end);
+        auto end = in.tellg();
+        in.seekg(position);
+        return position < 0 || end < position ? 0 : static_cast<uint64_t>(end - position);
+    }
+
+    template<typename T>
+    static void writeColours(std::ostream &out, const Colouring &s) {
+        for (auto color : s) {
+            writeValue(out, color == UNCOLORED ? std::numeric_limits<T>::max() : static_cast<T>(color));
+        }
+    }
+
+    template<typename T>
+    static bool readColours(std::istream &in, Colouring &s) {
+        T color;
+        for (auto &n : s) {
+            if (!readValue(in, color)) {
+                return false;
+            }
+            n = color == std::numeric_limits<T>::max() ? UNCOLORED : color;
+        }
+        return true;
+    }
+
+    /**
+     * Stores a colouring with 1, 2 or 4 bytes per node, depending on the largest used color.
+     * The largest value of each width represents UNCOLORED.
+     */
+    static void writeColouring(std::ostream &out, const Colouring &s) {
+        Color maxColor = 0;
+        for (auto color : s) {
+            if (color != UNCOLORED) {
+                maxColor = std::max(maxColor, color);
+            }
+        }
+        uint8_t width = maxColor < std::numeric_limits<uint8_t>::max() ? 1
+                      : maxColor < std::numeric_limits<uint16_t>::max() ? 2 : 4;
+        writeValue<uint64_t>(out, s.size());
+        writeValue<uint8_t>(out, width);
+        switch (width) {
+            case 1:
+                writeColours<uint8_t>(out, s);
+                break;
+            case 2:
+                writeColours<uint16_t>(out, s);
+                break;
+            default:
+                writeColours<uint32_t>(out, s);
+        }
+    }
+
+    static bool readColouring(std::istream &in, Colouring &s) {
+        uint64_t size;
+        uint8_t width;
+        if (!readValue(in, size) || !readValue(in, width) || width == 0 || size > remainingBytes(in) / width) {
+            return false;
+        }
+        s.resize(size);
+        switch (width) {
+            case 1:
+                return readColours<uint8_t>(in, s);
+            case 2:
+                return readColours<uint16_t>(in, s);
+            case 4:
+                return readColours<uint32_t>(in, s);
+            default:
+                return false;
+        }
+    }
+
+    template<typename T>
+    static void writeVector(std::ostream &out, const std::vector<T> &values) {
+        writeValue<uint64_t>(out, values.size());
+        for (auto value : values) {
+            writeValue<uint64_t>(out, value);
+        }
+    }
+
+    template<typename T>
+    static bool readVector(std::istream &in, std::vector<T> &values) {
+        uint64_t size;
+        if (!readValue(in, size) || size > remainingBytes(in) / sizeof(uint64_t)) {
+            return false;
+        }
+        values.resize(size);
+        uint64_t value;
+        for (auto &n : values) {
+            if (!readValue(in, value)) {
+                return false;
+            }
+            n = static_cast<T>(value);
+        }
+        return true;
+    }
+
+    int writeCheckpoint(const std::string &filename,
+                        const Checkpoint &checkpoint) {
+        const std::string tmpFilename = filename + ".tmp";
+        {
+            std::ofstream out(tmpFilename.c_str(), std::ios::binary | std::ios::trunc);
+            if (!out) {
+                std::cerr << "Error opening " << tmpFilename << std::endl;
+                return 1;
+            }
+            out.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+            writeValue(out, CHECKPOINT_VERSION);
+            writeValue<uint64_t>(out, checkpoint.nodeCount);
+            writeValue<uint64_t>(out, checkpoint.strategyCount);
+            writeValue<uint64_t>(out, checkpoint.populationSize);
+            writeValue<uint64_t>(out, checkpoint.target_k);
+            writeVector(out, checkpoint.strategyK);
+            writeVector(out, checkpoint.iterations);
+
+            writeValue<uint64_t>(out, checkpoint.population.size());
+            for (auto &s : checkpoint.population) {
+                writeColouring(out, s);
+            }
+            writeValue<uint64_t>(out, checkpoint.bestColourings.size());
+            for (auto &s : checkpoint.bestColourings) {
+                writeColouring(out, s);
+            }
+            writeValue<uint64_t>(out, checkpoint.generators.size());
+            for (auto &generator : checkpoint.generators) {
+                writeValue<uint64_t>(out, generator.size());
+                out.write(generator.data(), generator.size());
+            }
+            if (!out) {
+                std::cerr << "Error writing " << tmpFilename << std::endl;
+                return 1;
+            }
+        }
+        if (std::rename(tmpFilename.c_str(), filename.c_str()) != 0) {
+            std::cerr << "Error renaming " << tmpFilename << " to " << filename << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    int readCheckpoint(const std::string &filename,
+                       Checkpoint &checkpoint) {
+        std::ifstream in(filename.c_str(), std::ios::binary);
+        if (!in) {
+            std::cerr << "Error opening " << filename << std::endl;
+            return 1;
+        }
+        char magic[sizeof(CHECKPOINT_MAGIC)];
+        uint32_t version;
+        if (!in.read(magic, sizeof(magic))
+            || std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0
+            || !readValue(in, version)
+            || version != CHECKPOINT_VERSION) {
+            std::cerr << filename << " is not a compatible checkpoint file" << std::endl;
+            return 1;
+        }
+
+        uint64_t nodeCount, strategyCount, populationSize, target_k, size;
+        bool ok = readValue(in, nodeCount)
+                  && readValue(in, strategyCount)
+                  && readValue(in, populationSize)
+                  && readValue(in, target_k)
+                  && readVector(in, checkpoint.strategyK)
+                  && readVector(in, checkpoint.iterations)
+                  && readValue(in, size);
+        checkpoint.nodeCount = static_cast<NodeID>(nodeCount);
+        checkpoint.strategyCount = strategyCount;
+        checkpoint.populationSize = populationSize;
+        checkpoint.target_k = static_cast<ColorCount>(target_k);
+
+        //Every colouring has a header of 9 bytes, every generator one of 8 bytes
+        if (ok && size <= remainingBytes(in) / 9) {
+            checkpoint.population.resize(size);
+            for (auto &s : checkpoint.population) {
+                ok = ok && readColouring(in, s);
+            }
+            ok = ok && readValue(in, size);
+        } else {
+            ok = false;
+        }
+        if (ok && size <= remainingBytes(in) / 9) {
+            checkpoint.bestColourings.resize(size);
+            for (auto &s : checkpoint.bestColourings) {
+                ok = ok && readColouring(in, s);
+            }
+            ok = ok && readValue(in, size);
+        } else {
+            ok = false;
+        }
+        if (ok && size <= remainingBytes(in) / 8) {
+            checkpoint.generators.resize(size);
+            for (auto &generator : checkpoint.generators) {
+                ok = ok && readValue(in, size) && size <= remainingBytes(in);
+                if (ok) {
+                    generator.resize(size);
+                    ok = static_cast<bool>(in.read(&generator[0], size));
+                }
+            }
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::cerr << "Checkpoint " << filename << " is truncated" << std::endl;
+            return 1;
+        }
+
+        //The lanes of the population must match the header, since resuming indexes them without further checks
+        const size_t lanes = checkpoint.iterations.size();
+        ok = strategyCount > 0 && populationSize > 0
+             && lanes % populationSize == 0 && lanes / populationSize == strategyCount
+             && checkpoint.population.size() == lanes
+             && checkpoint.strategyK.size() == strategyCount
+             && checkpoint.bestColourings.size() == strategyCount;
+        for (auto *colourings : {&checkpoint.population, &checkpoint.bestColourings}) {
+            for (auto &s : *colourings) {
+                ok = ok && (s.empty() || s.size() == nodeCount);
+            }
+        }
+        if (!ok) {
+            std::cerr << "Checkpoint " << filename << " is inconsistent" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+}
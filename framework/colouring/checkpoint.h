@@ -0,0 +1,61 @@
+#pragma once
+
+#include "graph_colouring.h"
+
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace graph_colouring {
+
+    /**
+     * Snapshot of the state maintained by ColouringAlgorithm::perform.
+     * It is used to resume an interrupted run or to split a long search into several shorter runs.
+     */
+    struct Checkpoint {
+        /**< Marks a lane (see iterations) which does not need any further processing */
+        static constexpr size_t FINISHED = std::numeric_limits<size_t>::max();
+
+        /**< The number of nodes of the coloured graph */
+        NodeID nodeCount = 0;
+        /**< The number of colouring strategies */
+        size_t strategyCount = 0;
+        /**< The population size of every strategy */
+        size_t populationSize = 0;
+        /**< The smallest number of colors that has not been found yet */
+        ColorCount target_k = 0;
+        /**< strategyK[s] = the number of colours the population of strategy s has been initialized with */
+        std::vector<ColorCount> strategyK;
+        /**< iterations[s * populationSize + i] = the next iteration of the i-th colouring of strategy s
+         * (0 = not initialized yet) or FINISHED */
+        std::vector<size_t> iterations;
+        /**< The populations of all strategies */
+        std::vector<Colouring> population;
+        /**< The best valid colouring of every strategy (empty if no valid colouring was found) */
+        std::vector<Colouring> bestColourings;
+        /**< The textual representation of the random number generator of every worker thread */
+        std::vector<std::string> generators;
+    };
+
+    /**
+     * Writes the checkpoint in a compact binary format. Every colouring is stored with the smallest
+     * integer width that can represent its colours. The file is replaced atomically, so an interrupted
+     * write never destroys an older checkpoint.
+     * @param filename the target file
+     * @param checkpoint the checkpoint to write
+     * @return 0 on success, 1 otherwise
+     */
+    int writeCheckpoint(const std::string &filename,
+                        const Checkpoint &checkpoint);
+
+    /**
+     * Truncated files and files whose vectors do not match the header (one entry of iterations and population per
+     * lane, one entry of strategyK and bestColourings per strategy, nodeCount colours per non-empty colouring)
+     * are rejected. No length is allocated before it has been checked against the size of the file.
+     * @param filename the checkpoint file
+     * @param checkpoint the checkpoint to read into
+     * @return 0 on success, 1 otherwise
+     */
+    int readCheckpoint(const std::string &filename,
+                       Checkpoint &checkpoint);
+}
@@ -12,8 +12,15 @@ inline Color biggestColorClass(const std::vector<size_t> &colorDist) {
     return max;
 }
 
+graph_colouring::Colouring graph_colouring::gpxCrossover(const graph_colouring::Colouring &s1,
+                                                         const graph_colouring::Colouring &s2) {
+    std::mt19937 generator;
+    return gpxCrossover(s1, s2, generator);
+}
+
 graph_colouring::Colouring graph_colouring::gpxCrossover(const graph_colouring::Colouring &s1_org,
-                                                         const graph_colouring::Colouring &s2_org) {
+                                                         const graph_colouring::Colouring &s2_org,
+                                                         std::mt19937 &generator) {
     assert(graph_colouring::colorCount(s1_org) == graph_colouring::colorCount(s2_org));
 
     Colouring s1(s1_org);
@@ -51,7 +58,6 @@ graph_colouring::Colouring graph_colouring::gpxCrossover(const graph_colouring::
         }
     }
 
-    std::mt19937 generator;
     std::uniform_int_distribution<Color> distribution(0,
                                                       static_cast<Color>(colorDistS1.size() - 1));
     Color target = distribution(generator);
@@ -8,8 +8,16 @@ namespace graph_colouring {
      * See Hybrid Evolutionary Algorithms for Graph Coloring, page 385
      * @param s1 the first parent
      * @param s2 the second parent
+     * @param generator the source of random numbers
      * @return a new colouring based on the two parents
      */
+    Colouring gpxCrossover(const Colouring &s1,
+                           const Colouring &s2,
+                           std::mt19937 &generator);
+
+    /**
+     * gpxCrossover with a default constructed generator, i.e. every call draws the same random numbers
+     */
     Colouring gpxCrossover(const Colouring &s1,
                            const Colouring &s2);
 }
\ No newline at end of file
@@ -1,7 +1,21 @@
 #include "graph_colouring.h"
+#include "operator_selection.h"
+#include "portfolio_scheduler.h"
+#include "checkpoint.h"
+#include "bounds/clique.h"
+#include "reduction/graph_reduction.h"
+#include "init/xrlf.h"
+#include "util/graph_util.h"
+#include "util/thread_util.h"
+#include "data_structure/compressed_graph.h"
 
 #include <atomic>
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <type_traits>
 #include <debug.h>
 
 namespace graph_colouring {
@@ -32,14 +46,44 @@ namespace graph_colouring {
         ColorCount next_k;
         /**< The strategy which reported this found k */
         size_t reportingStrategy;
-        /**< The actual colouring */
+        /**< The worker thread which reported this found k. Its colouring is kept in localBestColourings. */
+        size_t reportingThread;
     };
 
+    /**
+     * The operator selectors used for a single colouring strategy
+     */
+    struct StrategyOperatorSelection {
+        template<typename Strategy>
+        explicit StrategyOperatorSelection(const Strategy &strategy)
+                : initOperators(strategy.initOperators.size()),
+                  crossoverOperators(strategy.crossoverOperators.size()),
+                  lsOperators(strategy.lsOperators.size()) {
+        }
+
+        OperatorSelector initOperators;
+        OperatorSelector crossoverOperators;
+        OperatorSelector lsOperators;
+    };
+
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * Every colouring strategy has its own queue of working packages
+     */
+    typedef boost::lockfree::queue<WorkingPackage> WorkQueue;
+
     ColorCount colorCount(const Colouring &s) {
         std::vector<bool> usedColor(s.size());
         ColorCount color_count = 0;
         for (auto n : s) {
-            if (n != UNCOLORED && !usedColor[n]) {
+            if (n == UNCOLORED) {
+                continue;
+            }
+            if (n >= usedColor.size()) {
+                usedColor.resize(n + 1);
+            }
+            if (!usedColor[n]) {
                 usedColor[n] = true;
                 color_count++;
             }
@@ -48,74 +92,36 @@ namespace graph_colouring {
     }
 
     int64_t squaredColorClassSizes(const Colouring &s) {
-        ColorCount numColors = colorCount(s);
-        std::vector<int64_t> colorClassSizes(numColors);
+        //Sized by the largest color, as the colors of a colouring are not necessarily consecutive
+        std::vector<int64_t> colorClassSizes;
         for (auto n : s) {
-            colorClassSizes[n]++;
-        }
-        return -1 * std::accumulate(colorClassSizes.begin(), colorClassSizes.end(), 0, [&] (int64_t a, int64_t b) {return a + b * b;});
-    }
-
-    bool allowedInClass(const graph_access &G,
-                        const Colouring &c,
-                        const Color color,
-                        const NodeID nodeID) {
-        for (auto neighbour : G.neighbours(nodeID)) {
-            if (c[neighbour] == color) {
-                return false;
-            }
-        }
-        return true;
-    }
-
-    size_t numberOfConflictingNodes(const graph_access &G,
-                                    const Colouring &s) {
-        size_t count = 0;
-        for (NodeID n = 0; n < s.size(); n++) {
-            for (auto neighbour : G.neighbours(n)) {
-                if (s[n] == s[neighbour]) {
-                    count++;
-                    break;
-                }
+            if (n == UNCOLORED) {
+                continue;
             }
-        }
-        return count;
-    }
-
-    size_t numberOfConflictingEdges(const graph_access &G,
-                                    const Colouring &s) {
-        size_t count = 0;
-        for (NodeID n = 0; n < s.size(); n++) {
-            for (auto neighbour : G.neighbours(n)) {
-                if (s[n] == s[neighbour]) {
-                    count++;
-                }
-            }
-        }
-        return count / 2;
-    }
-
-    size_t sumUncoloredDegree(const graph_access &G, const Colouring &s) {
-        ColorCount degree_count = 0;
-        for (NodeID id = 0; id < G.number_of_nodes(); ++id) {
-            if (s[id] == UNCOLORED) {
-                degree_count += G.getNodeDegree(id);
+            if (n >= colorClassSizes.size()) {
+                colorClassSizes.resize(n + 1, 0);
             }
+            colorClassSizes[n]++;
         }
-        return degree_count;
+        return -1 * std::accumulate(colorClassSizes.begin(), colorClassSizes.end(), int64_t(0), [&] (int64_t a, int64_t b) {return a + b * b;});
     }
 
     inline size_t chooseParent(const size_t strategyId,
                                const size_t populationSize,
                                std::vector<std::atomic<bool>> &lock,
-                               std::mt19937 &generator) {
+                               std::mt19937 &generator,
+                               ThreadCounters &counters) {
         std::uniform_int_distribution<size_t> populationDist(0, populationSize - 1);
         size_t nextTry;
         bool expected;
+        (void) counters;
+        COLOURING_INSTRUMENT(counters.parentSelections++);
         do {
             expected = false;
             nextTry = strategyId * populationSize + populationDist(generator);
+            COLOURING_INSTRUMENT(counters.parentRetries++);
         } while (!lock[nextTry].compare_exchange_weak(expected, true));
+        COLOURING_INSTRUMENT(counters.parentRetries--);
         return nextTry;
     }
 
@@ -128,99 +134,520 @@ namespace graph_colouring {
         return true;
     }
 
-    static void workerThread(const std::vector<std::unique_ptr<ColouringStrategy>> &strategies,
-                             const graph_access &G,
+    /**
+     * Pops the next working package, preferring the packages of the strategy \p preferredStrategy.
+     * If there is no work left for the preferred strategy, the packages of the remaining strategies are processed.
+     * The time of a successful pop is accounted to the counters of the popped strategy.
+     * @return false if all queues are empty
+     */
+    inline bool popWork(std::vector<std::unique_ptr<WorkQueue>> &workQueues,
+                        const size_t preferredStrategy,
+                        WorkingPackage &wp,
+                        ThreadCounterVector &counters) {
+        (void) counters;
+        COLOURING_INSTRUMENT(const uint64_t start = readTicks());
+        for (size_t i = 0; i < workQueues.size(); i++) {
+            if (workQueues[(preferredStrategy + i) % workQueues.size()]->pop(wp)) {
+                COLOURING_INSTRUMENT(counters[wp.strategyId].add(REGION_QUEUE, readTicks() - start));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * The state shared between the master thread, the worker threads and the checkpoint writer of a single run
+     */
+    struct SharedState {
+        template<typename Strategies>
+        SharedState(const Strategies &strategies,
+                    const size_t populationSize,
+                    const size_t threadCount,
+                    const ColorCount k)
+                : context(strategies.size()),
+                  masterQueue(k),
+                  population(strategies.size() * populationSize),
+                  localBestColourings(strategies.size() * threadCount),
+                  lock(strategies.size() * populationSize),
+                  laneIterations(strategies.size() * populationSize),
+                  strategyK(strategies.size()),
+                  target_k(k),
+                  terminated(false),
+                  searchStopped(false),
+                  stopCheckpointing(false),
+                  snapshotEpoch(0),
+                  publishedSnapshots(0),
+                  generatorSnapshots(threadCount),
+                  bestColouringSnapshots(strategies.size() * threadCount),
+                  counters(strategies.size()) {
+            workQueues.reserve(strategies.size());
+            selection.reserve(strategies.size());
+            for (auto &strategy : strategies) {
+                workQueues.emplace_back(new WorkQueue(populationSize));
+                //Operator statistics are kept across k-restarts, since they describe the operators, not the population
+                selection.emplace_back(new StrategyOperatorSelection(*strategy));
+            }
+            for (auto &strategy_k : strategyK) {
+                strategy_k = k;
+            }
+        }
+
+        /**< context[s] = the number of pending working packages of strategy s */
+        std::vector<std::atomic<size_t>> context;
+        std::vector<std::unique_ptr<WorkQueue>> workQueues;
+        //It is possible that all threads report the same found k colouring
+        boost::lockfree::queue<MasterPackage> masterQueue;
+        std::vector<Colouring> population;
+        std::vector<Colouring> localBestColourings;
+        /**< Held while a worker replaces its entry of localBestColourings or the master copies it */
+        std::mutex localBestMutex;
+        //lock[i] = true -> i-th individual is not available for mating
+        std::vector<std::atomic<bool>> lock;
+        /**< laneIterations[i] = the next iteration of the working package of the i-th individual
+         * (0 = initialization) or Checkpoint::FINISHED */
+        std::vector<std::atomic<size_t>> laneIterations;
+        /**< strategyK[s] = the number of colours the population of strategy s has been initialized with */
+        std::vector<std::atomic<ColorCount>> strategyK;
+        std::vector<std::unique_ptr<StrategyOperatorSelection>> selection;
+        //Only needed if there are several strategies competing for the worker threads
+        std::unique_ptr<PortfolioScheduler> scheduler;
+        //Represents the smallest number of colors used in a recently found colouring
+        std::atomic<ColorCount> target_k;
+        //Used to signal the termination of the worker pool
+        std::atomic<bool> terminated;
+        //Set as soon as a colouring with the proven minimal number of colours has been found or the time
+        //limit has expired. The workers discard their remaining packages afterwards.
+        std::atomic<bool> searchStopped;
+
+        //Checkpointing
+        /**< Held by the master thread during a k-restart and by the checkpoint writer while copying the population */
+        std::mutex populationMutex;
+        std::mutex checkpointMutex;
+        std::condition_variable checkpointCondition;
+        bool stopCheckpointing;
+        /**< Incremented by the checkpoint writer to ask the workers for a snapshot of their thread-local state */
+        std::atomic<size_t> snapshotEpoch;
+        std::atomic<size_t> publishedSnapshots;
+        std::vector<std::string> generatorSnapshots;
+        std::vector<Colouring> bestColouringSnapshots;
+
+        //Instrumentation
+        /**< counters[s] = the merged counters of all terminated worker threads for strategy s */
+        ThreadCounterVector counters;
+        std::mutex countersMutex;
+
+        //Tracing
+        /**< The tracer of the current run or nullptr */
+        Tracer *tracer = nullptr;
+        /**< The trace process id of this search */
+        uint32_t traceProcess = 0;
+
+        /**< If not empty, worker thread i is pinned to cpus[i % cpus.size()] */
+        std::vector<int> cpus;
+        /**< If true, a worker waits until the master handled its reported colourings */
+        bool synchronousReports = false;
+        std::atomic<size_t> reportedColourings{0};
+        std::atomic<size_t> handledColourings{0};
+
+        /**< cpuNodes[i] = the NUMA node of cpus[i] */
+        std::vector<size_t> cpuNodes;
+        /**< If not empty, graphReplicas[node] is a copy of the graph allocated on the given NUMA node */
+        std::vector<std::unique_ptr<graph_access>> graphReplicas;
+    };
+
+    /**
+     * Copies the thread-local state of a worker thread, if the checkpoint writer asked for it
+     * @param seenEpoch the last epoch the worker thread published a snapshot for
+     * @param force if true, the snapshot is published regardless of the current epoch
+     */
+    static void publishSnapshot(SharedState &state,
+                                const size_t threadId,
+                                const std::mt19937 &generator,
+                                size_t &seenEpoch,
+                                const bool force = false) {
+        auto epoch = state.snapshotEpoch.load(std::memory_order_acquire);
+        if (epoch == seenEpoch && !force) {
+            return;
+        }
+        seenEpoch = epoch;
+        std::ostringstream generatorState;
+        generatorState << generator;
+        state.generatorSnapshots[threadId] = generatorState.str();
+        size_t threadCount = state.generatorSnapshots.size();
+        for (size_t strategyId = 0; strategyId < state.context.size(); strategyId++) {
+            state.bestColouringSnapshots[strategyId * threadCount + threadId] =
+                    state.localBestColourings[strategyId * threadCount + threadId];
+        }
+        state.publishedSnapshots.fetch_add(1, std::memory_order_release);
+    }
+
+    /**
+     * @return the replica of the graph on the given NUMA node, if there is one, or the shared graph
+     */
+    static const graph_access &workerGraph(const graph_access &sharedGraph,
+                                           const SharedState &state,
+                                           const size_t node) {
+        return state.graphReplicas.empty() || !state.graphReplicas[node] ? sharedGraph : *state.graphReplicas[node];
+    }
+
+    //Only graph_access graphs are replicated
+    template<typename Graph>
+    static const Graph &workerGraph(const Graph &sharedGraph,
+                                    const SharedState &,
+                                    const size_t) {
+        return sharedGraph;
+    }
+
+    template<typename Graph>
+    static void workerThread(const std::vector<std::unique_ptr<BasicColouringStrategy<Graph>>> &strategies,
+                             const Graph &sharedGraph,
                              const size_t populationSize,
                              const size_t maxItr,
                              const size_t threadId,
-                             std::vector<std::atomic<size_t>> &context,
-                             boost::lockfree::queue<WorkingPackage> &workQueue,
-                             boost::lockfree::queue<MasterPackage> &masterQueue,
-                             std::vector<Colouring> &population,
-                             std::vector<Colouring> &localBestColourings,
-                             std::vector<std::atomic<bool>> &lock,
-                             std::atomic<ColorCount> &target_k,
-                             std::atomic<bool> &terminated) {
-        std::mt19937 generator(threadId);
+                             const bool adaptiveOperatorSelection,
+                             std::mt19937 generator,
+                             SharedState &state) {
+        auto &context = state.context;
+        auto &workQueues = state.workQueues;
+        auto &masterQueue = state.masterQueue;
+        auto &population = state.population;
+        auto &localBestColourings = state.localBestColourings;
+        auto &lock = state.lock;
+        auto &target_k = state.target_k;
+        auto *scheduler = state.scheduler.get();
 
         //Only used to avoid rapid reporting of already known colourings
         ColorCount last_reported_k = target_k + 1;
+        size_t seenEpoch = 0;
+
+        ThreadCounterVector counters(strategies.size());
+
+        //Operators allocate their colourings and scratch buffers in the worker threads, so pinned workers
+        //find them on their own NUMA node
+        size_t node = 0;
+        if (!state.cpus.empty()) {
+            thread_util::pinCurrentThread(state.cpus[threadId % state.cpus.size()]);
+            node = state.cpuNodes[threadId % state.cpus.size()];
+        }
+        const Graph &G = workerGraph(sharedGraph, state, node);
+
+        const Tracer *tracer = state.tracer;
+        TraceBuffer *trace = tracer != nullptr
+                             ? state.tracer->createBuffer(state.traceProcess, threadId,
+                                                          "worker " + std::to_string(threadId))
+                             : nullptr;
+        //Consecutive unsuccessful polls of the work queues are recorded as a single idle event
+        uint64_t idleSince = 0;
+        bool idle = false;
 
         WorkingPackage wp = {0, 0, 0, 0};
-        while (!terminated) {
-            while (workQueue.pop(wp)) {
-                const ColouringStrategy &strategy = *strategies[wp.strategyId];
+        while (!state.terminated) {
+            publishSnapshot(state, threadId, generator, seenEpoch);
+            while (popWork(workQueues, scheduler != nullptr ? scheduler->strategyOf(threadId) : 0, wp, counters)) {
+                const auto &strategy = *strategies[wp.strategyId];
+                StrategyOperatorSelection &operators = *state.selection[wp.strategyId];
+
+                if (idle && trace != nullptr) {
+                    trace->record({"idle", idleSince, tracer->now(), 0, 0});
+                }
+                idle = false;
 
-                if (target_k < wp.target_k && strategy.isFixedKStrategy()) {
+                ThreadCounters &strategyCounters = counters[wp.strategyId];
+
+                if ((target_k < wp.target_k && strategy.isFixedKStrategy()) || state.searchStopped) {
+                    COLOURING_INSTRUMENT(strategyCounters.discardedPackages++);
                     context[wp.strategyId].fetch_sub(1);
                     continue;
                 }
+                COLOURING_INSTRUMENT(strategyCounters.packages++);
+                TraceScope packageScope(tracer, trace, wp.itr > 0 ? "generation" : "init", wp.strategyId, wp.itr);
 
                 if (wp.itr > 0) {
-                    auto p1 = chooseParent(wp.strategyId, populationSize, lock, generator);
-                    auto p2 = chooseParent(wp.strategyId, populationSize, lock, generator);
+                    size_t p1, p2;
+                    {
+                        TraceScope parentScope(tracer, trace, "choose_parents", wp.strategyId);
+                        p1 = instrumented(strategyCounters, REGION_CHOOSE_PARENT, [&] {
+                            return chooseParent(wp.strategyId, populationSize, lock, generator, strategyCounters);
+                        });
+                        p2 = instrumented(strategyCounters, REGION_CHOOSE_PARENT, [&] {
+                            return chooseParent(wp.strategyId, populationSize, lock, generator, strategyCounters);
+                        });
+                    }
 
                     std::array<Colouring *, 2> parents = {&population[p1], &population[p2]};
-                    auto weakerParent = static_cast<size_t>(strategy.compare(G,
-                                                                             *parents[0],
-                                                                             *parents[1]));
+                    //compare is true if the first parent is the weaker one
+                    auto weakerParent = static_cast<size_t>(instrumented(strategyCounters, REGION_COMPARE, [&] {
+                        return !strategy.compare(G, *parents[0], *parents[1]);
+                    }));
+
+                    auto crossoverOpId = operators.crossoverOperators.select(generator);
+                    auto lsOpId = operators.lsOperators.select(generator);
 
-                    std::uniform_int_distribution<size_t> crossoverOprDist(0,
-                                                                           strategy.crossoverOperators.size() - 1);
-                    std::uniform_int_distribution<size_t> lsOprDist(0, strategy.lsOperators.size() - 1);
+                    //Scores are only needed if there are operators to choose from
+                    bool rateCrossover = adaptiveOperatorSelection && operators.crossoverOperators.size() > 1;
+                    bool rateLs = adaptiveOperatorSelection && operators.lsOperators.size() > 1;
+                    //The portfolio scheduler needs to know whether the offspring improved its population
+                    bool rateGeneration = scheduler != nullptr;
 
-                    auto crossoverOp = strategy.crossoverOperators[
-                            crossoverOprDist(generator)];
-                    auto lsOp = strategies[wp.strategyId]->lsOperators[
-                            lsOprDist(generator)];
+                    int64_t parentScore = rateCrossover || rateGeneration
+                                          ? strategy.score(G, *parents[weakerParent]) : 0;
 
-                    *parents[weakerParent] = lsOp(crossoverOp(*parents[0], *parents[1], G), G);
+                    auto start = Clock::now();
+                    Colouring child = instrumented(strategyCounters, REGION_CROSSOVER, [&] {
+                        return strategy.crossoverOperators[crossoverOpId](*parents[0], *parents[1], G, generator);
+                    });
+                    auto crossoverEnd = Clock::now();
+                    int64_t childScore = rateCrossover || rateLs ? strategy.score(G, child) : 0;
+                    auto lsStart = Clock::now();
+                    *parents[weakerParent] = instrumented(strategyCounters, REGION_LOCAL_SEARCH, [&] {
+                        return strategy.lsOperators[lsOpId](child, G, generator);
+                    });
+                    auto lsEnd = Clock::now();
 
-                    if (strategy.isSolution(G, target_k, *parents[weakerParent]) && last_reported_k > target_k) {
+                    if (rateCrossover) {
+                        operators.crossoverOperators.reward(crossoverOpId,
+                                                            childScore - parentScore,
+                                                            crossoverEnd - start);
+                    }
+                    int64_t offspringScore = rateLs || rateGeneration ? strategy.score(G, *parents[weakerParent]) : 0;
+                    if (rateLs) {
+                        operators.lsOperators.reward(lsOpId, offspringScore - childScore, lsEnd - lsStart);
+                    }
+                    if (rateGeneration) {
+                        scheduler->recordGeneration(wp.strategyId, offspringScore > parentScore, lsEnd - start);
+                    }
+
+                    bool isSolution = instrumented(strategyCounters, REGION_IS_SOLUTION, [&] {
+                        return strategy.isSolution(G, target_k, *parents[weakerParent]);
+                    });
+                    if (isSolution && last_reported_k > target_k) {
                         last_reported_k = colorCount(*parents[weakerParent]);
-                        masterQueue.push({last_reported_k, wp.strategyId});
+                        state.reportedColourings++;
                         size_t threadCount = localBestColourings.size() / strategies.size();
-                        localBestColourings[wp.strategyId * threadCount + threadId] = *parents[weakerParent];
+                        {
+                            std::lock_guard<std::mutex> guard(state.localBestMutex);
+                            localBestColourings[wp.strategyId * threadCount + threadId] = *parents[weakerParent];
+                        }
+                        masterQueue.push({last_reported_k, wp.strategyId, threadId});
                     }
 
                     lock[p1] = false;
                     lock[p2] = false;
 
+                    auto lane = wp.strategyId * populationSize + wp.colouring;
                     if (wp.itr < maxItr) {
-                        workQueue.push({wp.itr + 1, wp.strategyId, wp.target_k, wp.colouring});
+                        state.laneIterations[lane] = wp.itr + 1;
+                        instrumented(strategyCounters, REGION_QUEUE, [&] {
+                            workQueues[wp.strategyId]->push({wp.itr + 1, wp.strategyId, wp.target_k, wp.colouring});
+                        });
                     } else {
+                        state.laneIterations[lane] = Checkpoint::FINISHED;
                         context[wp.strategyId].fetch_sub(1);
                     }
                 } else {
-                    std::uniform_int_distribution<size_t> initOprDist(0, strategy.initOperators.size() - 1);
-                    std::uniform_int_distribution<size_t> lsOprDist(0, strategy.lsOperators.size() - 1);
+                    auto initOpId = operators.initOperators.select(generator);
+                    auto lsOpId = operators.lsOperators.select(generator);
+
+                    bool rateInit = adaptiveOperatorSelection && operators.initOperators.size() > 1;
+                    bool rateLs = adaptiveOperatorSelection && operators.lsOperators.size() > 1;
 
-                    auto initOpr = strategy.initOperators[initOprDist(generator)];
-                    auto lsOpr = strategy.lsOperators[lsOprDist(generator)];
+                    auto start = Clock::now();
+                    Colouring initial = instrumented(strategyCounters, REGION_INIT, [&] {
+                        return strategy.initOperators[initOpId](G, wp.target_k, generator);
+                    });
+                    auto initEnd = Clock::now();
+                    int64_t initialScore = rateInit || rateLs ? strategy.score(G, initial) : 0;
+                    auto lsStart = Clock::now();
+                    auto lane = wp.strategyId * populationSize + wp.colouring;
+                    Colouring &individual = population[lane];
+                    individual = instrumented(strategyCounters, REGION_LOCAL_SEARCH, [&] {
+                        return strategy.lsOperators[lsOpId](initial, G, generator);
+                    });
+                    auto lsEnd = Clock::now();
 
-                    population[wp.strategyId * populationSize + wp.colouring] = lsOpr(initOpr(G, wp.target_k), G);
+                    if (rateInit) {
+                        operators.initOperators.rewardScore(initOpId, initialScore, initEnd - start);
+                    }
+                    if (rateLs) {
+                        operators.lsOperators.reward(lsOpId,
+                                                     strategy.score(G, individual) - initialScore,
+                                                     lsEnd - lsStart);
+                    }
 
-                    if (strategy.isSolution(G, target_k, population[wp.strategyId * populationSize + wp.colouring])
-                        && last_reported_k > target_k) {
-                        last_reported_k = colorCount(population[wp.strategyId * populationSize + wp.colouring]);
-                        masterQueue.push({last_reported_k, wp.strategyId});
+                    bool isSolution = instrumented(strategyCounters, REGION_IS_SOLUTION, [&] {
+                        return strategy.isSolution(G, target_k, individual);
+                    });
+                    if (isSolution && last_reported_k > target_k) {
+                        last_reported_k = colorCount(individual);
+                        state.reportedColourings++;
                         size_t threadCount = localBestColourings.size() / strategies.size();
-                        localBestColourings[wp.strategyId * threadCount + threadId] = population[
-                                wp.strategyId * populationSize + wp.colouring];
+                        {
+                            std::lock_guard<std::mutex> guard(state.localBestMutex);
+                            localBestColourings[wp.strategyId * threadCount + threadId] = individual;
+                        }
+                        masterQueue.push({last_reported_k, wp.strategyId, threadId});
                     }
 
-                    lock[wp.strategyId * populationSize + wp.colouring] = false;
+                    lock[lane] = false;
 
                     auto matingPopulationSize = populationSize / 2;
                     if (wp.colouring < matingPopulationSize) {
-                        workQueue.push({wp.itr + 1, wp.strategyId, wp.target_k, wp.colouring});
+                        state.laneIterations[lane] = wp.itr + 1;
+                        instrumented(strategyCounters, REGION_QUEUE, [&] {
+                            workQueues[wp.strategyId]->push({wp.itr + 1, wp.strategyId, wp.target_k, wp.colouring});
+                        });
                     } else {
+                        state.laneIterations[lane] = Checkpoint::FINISHED;
                         context[wp.strategyId].fetch_sub(1);
                     }
                 }
+                //The next package must not depend on the time the master needs to restart the search
+                while (state.synchronousReports && state.handledColourings < state.reportedColourings
+                       && !state.terminated) {
+                    std::this_thread::yield();
+                }
+                publishSnapshot(state, threadId, generator, seenEpoch);
             }
+            if (!idle && trace != nullptr) {
+                idleSince = tracer->now();
+            }
+            idle = true;
             std::this_thread::yield();
         }
+        if (idle && trace != nullptr) {
+            trace->record({"idle", idleSince, tracer->now(), 0, 0});
+        }
+        publishSnapshot(state, threadId, generator, seenEpoch, true);
+
+#ifdef COLOURING_INSTRUMENTATION
+        std::lock_guard<std::mutex> guard(state.countersMutex);
+        for (size_t strategyId = 0; strategyId < strategies.size(); strategyId++) {
+            state.counters[strategyId] += counters[strategyId];
+        }
+#endif
+    }
+
+    /**
+     * Creates a checkpoint of the current state.
+     * If \p concurrent is true, the worker threads are still running. In this case, every individual is copied
+     * while holding its lock. Individuals which could not be locked are stored as empty colourings and will be
+     * re-initialized when resuming.
+     */
+    template<typename Graph>
+    static void takeCheckpoint(const Graph &G,
+                               const size_t populationSize,
+                               SharedState &state,
+                               Checkpoint &checkpoint,
+                               const bool concurrent) {
+        const size_t strategyCount = state.context.size();
+        const size_t threadCount = state.generatorSnapshots.size();
+
+        if (concurrent) {
+            state.publishedSnapshots = 0;
+            state.snapshotEpoch.fetch_add(1, std::memory_order_release);
+            while (state.publishedSnapshots.load(std::memory_order_acquire) < threadCount) {
+                if (state.terminated) {
+                    return;
+                }
+                std::this_thread::yield();
+            }
+        }
+
+        checkpoint.nodeCount = G.number_of_nodes();
+        checkpoint.strategyCount = strategyCount;
+        checkpoint.populationSize = populationSize;
+        checkpoint.target_k = state.target_k;
+        checkpoint.generators = state.generatorSnapshots;
+
+        checkpoint.bestColourings.assign(strategyCount, Colouring());
+        for (size_t strategyId = 0; strategyId < strategyCount; strategyId++) {
+            auto &best = checkpoint.bestColourings[strategyId];
+            for (size_t threadId = 0; threadId < threadCount; threadId++) {
+                auto &localBest = state.bestColouringSnapshots[strategyId * threadCount + threadId];
+                if (!localBest.empty() && (best.empty() || colorCount(localBest) < colorCount(best))) {
+                    best = localBest;
+                }
+            }
+        }
+
+        std::unique_lock<std::mutex> restartGuard(state.populationMutex, std::defer_lock);
+        if (concurrent) {
+            restartGuard.lock();
+        }
+        checkpoint.strategyK.resize(strategyCount);
+        for (size_t strategyId = 0; strategyId < strategyCount; strategyId++) {
+            checkpoint.strategyK[strategyId] = state.strategyK[strategyId];
+        }
+        checkpoint.population.resize(state.population.size());
+        checkpoint.iterations.resize(state.population.size());
+        for (size_t i = 0; i < state.population.size(); i++) {
+            checkpoint.iterations[i] = state.laneIterations[i];
+            if (!concurrent) {
+                checkpoint.population[i] = state.population[i];
+                continue;
+            }
+            bool locked = false;
+            for (size_t attempt = 0; attempt < 1000 && !locked && !state.terminated; attempt++) {
+                bool expected = false;
+                locked = state.lock[i].compare_exchange_weak(expected, true);
+                if (!locked) {
+                    std::this_thread::yield();
+                }
+            }
+            if (locked) {
+                checkpoint.population[i] = state.population[i];
+                state.lock[i] = false;
+            } else {
+                checkpoint.population[i].clear();
+            }
+        }
+    }
+
+    template<typename Graph>
+    static void checkpointWriterThread(const Graph &G,
+                                       const size_t populationSize,
+                                       const std::string &filename,
+                                       const std::chrono::milliseconds interval,
+                                       SharedState &state) {
+        std::unique_lock<std::mutex> guard(state.checkpointMutex);
+        while (!state.checkpointCondition.wait_for(guard, interval, [&state] { return state.stopCheckpointing; })) {
+            guard.unlock();
+            Checkpoint checkpoint;
+            takeCheckpoint(G, populationSize, state, checkpoint, true);
+            if (!state.terminated) {
+                writeCheckpoint(filename, checkpoint);
+            }
+            guard.lock();
+        }
+    }
+
+    size_t ColouringAlgorithm::start(const size_t strategyCount,
+                                     const size_t populationSize,
+                                     const size_t maxItr,
+                                     const size_t threadCount) {
+        assert(strategyCount > 0);
+        assert(populationSize > 0);
+        assert(maxItr > 0);
+        assert(threadCount > 0);
+
+        const size_t workerCount = deterministic ? 1 : threadCount;
+        if (4 * workerCount > strategyCount * populationSize) {
+            throw "WARNING: Make sure that populationSize is bigger than 4*categoryCount*threadCount\n";
+        }
+
+        deadline = Clock::now() + timeLimit;
+        stopRequested = false;
+        if (!traceFile.empty()) {
+            tracer.reset(new Tracer(traceCapacity));
+        }
+        return workerCount;
+    }
+
+    void ColouringAlgorithm::finish() {
+        if (tracer) {
+            tracer->write(traceFile);
+            tracer.reset();
+        }
     }
 
     std::vector<ColouringResult>
@@ -231,95 +658,458 @@ namespace graph_colouring {
                                 const size_t maxItr,
                                 const size_t threadCount,
                                 std::ostream *outputStream) {
+        const size_t workerCount = start(strategies.size(), populationSize, maxItr, threadCount);
+        inputGraph = &G;
 
-        assert(!strategies.empty());
-        assert(populationSize > 0);
-        assert(maxItr > 0);
-        assert(threadCount > 0);
+        ColorCount lowerBound = 0;
+        if (cliqueTimeLimit.count() > 0) {
+            //The result of the time limited search depends on the load of the machine
+            lowerBound = deterministic ? cliqueLowerBound(G, cliqueStepLimit) : cliqueLowerBound(G, cliqueTimeLimit);
+            if (outputStream != nullptr) {
+                *outputStream << "Lower bound k = " << lowerBound << "\n";
+            }
+        }
 
-        if (4 * threadCount > strategies.size() * populationSize) {
-            throw "WARNING: Make sure that populationSize is bigger than 4*categoryCount*threadCount\n";
+        std::vector<ColouringResult> results;
+        std::unique_ptr<GraphReduction> reduction;
+        //The kernel depends on the lower bound, so a resumed run could not rebuild the checkpointed kernel
+        if (reduceGraph && checkpointFile.empty() && resumeFile.empty()) {
+            //Nodes with less than k neighbours are only removed if k colours are necessary anyway
+            reduction.reset(new GraphReduction(G, std::min(k, lowerBound)));
+        }
+        if (reduction && reduction->removedNodes() > 0) {
+            auto &kernel = reduction->kernel();
+            if (outputStream != nullptr) {
+                *outputStream << "Reduced graph to " << kernel.number_of_nodes() << " nodes\n";
+            }
+            results.assign(strategies.size(), {Colouring(), true, InstrumentationStats()});
+            if (kernel.number_of_nodes() > 0) {
+                results = colourComponents(strategies, kernel, k, populationSize, maxItr, workerCount,
+                                           lowerBound, outputStream);
+            }
+            for (auto &result : results) {
+                if (result.s.size() == kernel.number_of_nodes()) {
+                    result.s = reduction->lift(result.s);
+                }
+            }
+        } else {
+            results = colourComponents(strategies, G, k, populationSize, maxItr, workerCount, lowerBound,
+                                       outputStream);
         }
 
-        std::vector<Colouring> population(strategies.size() * populationSize);
-        std::vector<Colouring> localBestColourings(strategies.size() * threadCount);
-        //lock[i] = true -> i-th individual is free for mating
-        std::vector<std::atomic<bool>> lock(strategies.size() * populationSize);
-        std::vector<std::atomic<size_t>> context(strategies.size());
+        finish();
+        return results;
+    }
 
-        //Represents the smallest number of colors used in a recently found colouring
-        std::atomic<ColorCount> target_k(k);
-        boost::lockfree::queue<WorkingPackage> workQueue(populationSize * strategies.size());
+    std::vector<ColouringResult>
+    ColouringAlgorithm::perform(const std::vector<std::unique_ptr<BasicColouringStrategy<compressed_graph_access>>> &strategies,
+                                const compressed_graph_access &G,
+                                const ColorCount k,
+                                const size_t populationSize,
+                                const size_t maxItr,
+                                const size_t threadCount,
+                                std::ostream *outputStream) {
+        const size_t workerCount = start(strategies.size(), populationSize, maxItr, threadCount);
+        inputGraph = &G;
+        auto results = evolve(strategies, G, k, populationSize, maxItr, workerCount, 0, 0, outputStream);
+        finish();
+        return results;
+    }
 
-        //It is possible that all threads report the same found k colouring
-        boost::lockfree::queue<MasterPackage> masterQueue(k);
+    std::vector<ColouringResult>
+    ColouringAlgorithm::colourComponents(const std::vector<std::unique_ptr<ColouringStrategy>> &strategies,
+                                         const graph_access &G,
+                                         const ColorCount k,
+                                         const size_t populationSize,
+                                         const size_t maxItr,
+                                         const size_t threadCount,
+                                         const ColorCount lowerBound,
+                                         std::ostream *outputStream) {
+        //A checkpoint always describes the population of a single graph
+        if (!decomposeComponents || !checkpointFile.empty() || !resumeFile.empty()) {
+            return evolve(strategies, G, k, populationSize, maxItr, threadCount, lowerBound, 0, outputStream);
+        }
 
-        //Used to signal the termination of the worker pool
-        std::atomic<bool> terminated(false);
+        std::vector<NodeID> component;
+        NodeID componentCount = graph_util::connectedComponents(G, component, threadCount);
+        if (componentCount <= 1) {
+            return evolve(strategies, G, k, populationSize, maxItr, threadCount, lowerBound, 0, outputStream);
+        }
+        if (outputStream != nullptr) {
+            *outputStream << "Split graph into " << componentCount << " components\n";
+        }
+
+        std::vector<std::vector<NodeID>> componentNodes(componentCount);
+        for (NodeID n = 0; n < G.number_of_nodes(); n++) {
+            componentNodes[component[n]].push_back(n);
+        }
+        std::vector<NodeID> largeComponents;
+        std::vector<NodeID> smallComponents;
+        for (NodeID c = 0; c < componentCount; c++) {
+            (componentNodes[c].size() > exactComponentSize ? largeComponents : smallComponents).push_back(c);
+        }
+        std::sort(largeComponents.begin(), largeComponents.end(), [&](NodeID a, NodeID b) {
+            return componentNodes[a].size() > componentNodes[b].size();
+        });
+
+        //Every large component gets a share of the worker threads proportional to its size
+        std::vector<size_t> componentThreads(largeComponents.size(), 1);
+        if (largeComponents.size() < threadCount) {
+            size_t largeNodes = 0;
+            for (auto c : largeComponents) {
+                largeNodes += componentNodes[c].size();
+            }
+            size_t assigned = largeComponents.size();
+            for (size_t i = 0; i < largeComponents.size(); i++) {
+                size_t share = (threadCount - largeComponents.size()) * componentNodes[largeComponents[i]].size()
+                               / largeNodes;
+                componentThreads[i] += share;
+                assigned += share;
+            }
+            for (size_t i = 0; assigned < threadCount; i = (i + 1) % largeComponents.size(), assigned++) {
+                componentThreads[i]++;
+            }
+        }
+
+        //Pinned workers of concurrently coloured components must not share their CPUs
+        std::vector<size_t> firstCpu(largeComponents.size(), 0);
+        for (size_t i = 1; i < largeComponents.size(); i++) {
+            firstCpu[i] = (firstCpu[i - 1] + componentThreads[i - 1]) % threadCount;
+        }
+
+        std::vector<std::vector<ColouringResult>> componentResults(componentCount);
+        std::atomic<size_t> nextComponent(0);
+        auto colourLargeComponents = [&]() {
+            for (size_t i = nextComponent++; i < largeComponents.size(); i = nextComponent++) {
+                auto c = largeComponents[i];
+                graph_access subgraph;
+                graph_util::inducedSubgraph(G, componentNodes[c], subgraph);
+                //Colourings with lowerBound colours are optimal for the whole graph
+                componentResults[c] = evolve(strategies, subgraph, k, populationSize, maxItr,
+                                             componentThreads[i], lowerBound, firstCpu[i], nullptr);
+            }
+        };
+        std::vector<std::thread> runners;
+        for (size_t i = 0; i < std::min(threadCount, largeComponents.size()); i++) {
+            runners.emplace_back(colourLargeComponents);
+        }
+
+        //Small components are coloured optimally by the exact solver of XRLF
+        for (auto c : smallComponents) {
+            graph_access subgraph;
+            graph_util::inducedSubgraph(G, componentNodes[c], subgraph);
+            xrlf::Subgraph exactSubgraph(subgraph);
+            Colouring s(subgraph.number_of_nodes(), UNCOLORED);
+            Color offset = 0;
+            xrlf::findOptimalColouring(exactSubgraph, s, offset);
+            componentResults[c].assign(strategies.size(), {s, true, InstrumentationStats()});
+        }
+
+        for (auto &runner : runners) {
+            runner.join();
+        }
+
+        std::vector<ColouringResult> results(strategies.size(),
+                                             {Colouring(G.number_of_nodes(), UNCOLORED), true, InstrumentationStats()});
+        for (NodeID c = 0; c < componentCount; c++) {
+            for (size_t strategyId = 0; strategyId < strategies.size(); strategyId++) {
+                auto &componentResult = componentResults[c][strategyId];
+                results[strategyId].isValid = results[strategyId].isValid && componentResult.isValid;
+                results[strategyId].stats += componentResult.stats;
+                for (NodeID i = 0; i < componentResult.s.size(); i++) {
+                    results[strategyId].s[componentNodes[c][i]] = componentResult.s[i];
+                }
+            }
+        }
+        return results;
+    }
+
+    /**
+     * Copies \p G into the replica of a NUMA node
+     */
+    static void copyToReplica(const graph_access &G, graph_access &replica) {
+        graph_util::copyGraph(G, replica);
+    }
+
+    template<typename Graph>
+    static void copyToReplica(const Graph &, graph_access &) {
+    }
+
+    template<typename Graph>
+    std::vector<ColouringResult>
+    ColouringAlgorithm::evolve(const std::vector<std::unique_ptr<BasicColouringStrategy<Graph>>> &strategies,
+                               const Graph &G,
+                               const ColorCount k,
+                               const size_t populationSize,
+                               const size_t maxItr,
+                               const size_t threadCount,
+                               const ColorCount lowerBound,
+                               const size_t firstCpu,
+                               std::ostream *outputStream) {
+        Checkpoint resumed;
+        if (!resumeFile.empty()) {
+            if (readCheckpoint(resumeFile, resumed) != 0) {
+                throw "ERROR: Could not read the checkpoint file\n";
+            }
+            if (resumed.nodeCount != G.number_of_nodes()
+                || resumed.strategyCount != strategies.size()
+                || resumed.populationSize != populationSize) {
+                throw "ERROR: The checkpoint does not match the graph, the strategies or the population size\n";
+            }
+        }
+
+        SharedState state(strategies, populationSize, threadCount, k);
+        auto &context = state.context;
+        auto &workQueues = state.workQueues;
+        auto &population = state.population;
+        auto &localBestColourings = state.localBestColourings;
+        auto &lock = state.lock;
+        auto &target_k = state.target_k;
+
+        state.synchronousReports = deterministic;
+        if (portfolioScheduling && !deterministic && strategies.size() > 1) {
+            state.scheduler.reset(new PortfolioScheduler(strategies.size(), threadCount));
+        }
+        auto *scheduler = state.scheduler.get();
+
+        size_t numaNodeCount = 1;
+        if (numaAware) {
+            //Fill the CPUs of one NUMA node before using the next one
+            auto nodes = thread_util::numaNodes();
+            numaNodeCount = nodes.size();
+            for (size_t node = 0; node < nodes.size(); node++) {
+                state.cpus.insert(state.cpus.end(), nodes[node].begin(), nodes[node].end());
+                state.cpuNodes.insert(state.cpuNodes.end(), nodes[node].size(), node);
+            }
+        } else if (pinThreads) {
+            state.cpus = thread_util::availableCpus();
+            state.cpuNodes.assign(state.cpus.size(), 0);
+        }
+        if (!state.cpus.empty()) {
+            //Concurrent searches (see colourComponents) start at different CPUs
+            auto first = firstCpu % state.cpus.size();
+            std::rotate(state.cpus.begin(), state.cpus.begin() + first, state.cpus.end());
+            std::rotate(state.cpuNodes.begin(), state.cpuNodes.begin() + first, state.cpuNodes.end());
+        }
+        if (numaAware) {
+            //Only graph_access graphs are replicated (see workerGraph)
+            if (replicateGraph && std::is_same<Graph, graph_access>::value) {
+                state.graphReplicas.resize(numaNodeCount);
+                std::vector<std::thread> replicators;
+                for (size_t threadId = 0; threadId < std::min(threadCount, state.cpus.size()); threadId++) {
+                    size_t node = state.cpuNodes[threadId];
+                    if (state.graphReplicas[node]) {
+                        continue;
+                    }
+                    state.graphReplicas[node].reset(new graph_access());
+                    //The replica is allocated by a thread on the target node (first touch)
+                    replicators.emplace_back([&G, &state, threadId, node] {
+                        thread_util::pinCurrentThread(state.cpus[threadId]);
+                        copyToReplica(G, *state.graphReplicas[node]);
+                    });
+                }
+                for (auto &replicator : replicators) {
+                    replicator.join();
+                }
+            }
+        }
+
+        TraceBuffer *trace = nullptr;
+        if (tracer) {
+            state.tracer = tracer.get();
+            state.traceProcess = tracer->newProcess();
+            trace = tracer->createBuffer(state.traceProcess, threadCount, "master");
+        }
+
+        if (!resumeFile.empty()) {
+            target_k = resumed.target_k;
+            population = resumed.population;
+            for (size_t strategyId = 0; strategyId < strategies.size(); strategyId++) {
+                state.strategyK[strategyId] = resumed.strategyK[strategyId];
+                localBestColourings[strategyId * threadCount] = resumed.bestColourings[strategyId];
+            }
+        }
+
+        for (auto &best : resumed.bestColourings) {
+            if (!best.empty() && colorCount(best) <= lowerBound) {
+                state.searchStopped = true;
+            }
+        }
+
+        //Calibrates the ticks of the instrumentation timers
+        const uint64_t startTicks = readTicks();
+        const auto startTime = Clock::now();
 
         std::vector<std::thread> workerPool;
         workerPool.reserve(threadCount);
         for (size_t threadId = 0; threadId < threadCount; threadId++) {
-            workerPool.emplace_back(workerThread,
+            std::mt19937 generator(seed == 0 ? threadId : seed * threadCount + threadId);
+            if (threadId < resumed.generators.size()) {
+                std::istringstream generatorState(resumed.generators[threadId]);
+                generatorState >> generator;
+            }
+            workerPool.emplace_back(workerThread<Graph>,
                                     std::cref(strategies),
                                     std::cref(G),
                                     populationSize,
                                     maxItr,
                                     threadId,
-                                    std::ref(context),
-                                    std::ref(workQueue),
-                                    std::ref(masterQueue),
-                                    std::ref(population),
-                                    std::ref(localBestColourings),
-                                    std::ref(lock),
-                                    std::ref(target_k),
-                                    std::ref(terminated));
+                                    adaptiveOperatorSelection && !deterministic,
+                                    generator,
+                                    std::ref(state));
         }
 
         //Init work queue
         for (size_t colouringId = 0; colouringId < populationSize; colouringId++) {
             for (size_t strategyId = 0; strategyId < strategies.size(); strategyId++) {
-                lock[strategyId * populationSize + colouringId] = true;
-                context[strategyId].fetch_add(1);
-                workQueue.push({0, strategyId, target_k, colouringId});
+                auto lane = strategyId * populationSize + colouringId;
+                ColorCount strategy_k = state.strategyK[strategyId];
+                bool restart = resumeFile.empty()
+                               || population[lane].empty()
+                               || resumed.iterations[lane] == 0
+                               || (strategies[strategyId]->isFixedKStrategy() && strategy_k > target_k);
+                if (restart) {
+                    if (strategies[strategyId]->isFixedKStrategy()) {
+                        state.strategyK[strategyId] = target_k.load();
+                    }
+                    lock[lane] = true;
+                    state.laneIterations[lane] = 0;
+                    context[strategyId].fetch_add(1);
+                    workQueues[strategyId]->push({0, strategyId, state.strategyK[strategyId], colouringId});
+                } else if (resumed.iterations[lane] <= maxItr) {
+                    state.laneIterations[lane] = resumed.iterations[lane];
+                    context[strategyId].fetch_add(1);
+                    workQueues[strategyId]->push({resumed.iterations[lane], strategyId, strategy_k, colouringId});
+                } else {
+                    state.laneIterations[lane] = Checkpoint::FINISHED;
+                }
             }
         }
 
-        MasterPackage mp = {0, 0};
-        while (!hasFinished(context)) {
-            while (masterQueue.pop(mp)) {
-                if (outputStream != nullptr) {
-                    auto &ss = *outputStream;
-                    ss << "Found colouring k = " << mp.next_k
-                       << " from colouring strategy " << mp.reportingStrategy << "\n";
+        std::thread checkpointWriter;
+        if (!checkpointFile.empty()) {
+            checkpointWriter = std::thread(checkpointWriterThread<Graph>,
+                                           std::cref(G),
+                                           populationSize,
+                                           std::cref(checkpointFile),
+                                           checkpointInterval,
+                                           std::ref(state));
+        }
+
+        //The colourings of components and kernels do not colour the input graph
+        const bool reportColourings = onValidColouring && &G == inputGraph;
+        Colouring reported;
+        auto announce = [&](const MasterPackage &mp) {
+            if (outputStream != nullptr) {
+                auto &ss = *outputStream;
+                ss << "Found colouring k = " << mp.next_k
+                   << " from colouring strategy " << mp.reportingStrategy << "\n";
+            }
+            if (onColouringFound) {
+                onColouringFound(mp.next_k, mp.reportingStrategy);
+            }
+            if (reportColourings) {
+                {
+                    std::lock_guard<std::mutex> guard(state.localBestMutex);
+                    reported = localBestColourings[mp.reportingStrategy * threadCount + mp.reportingThread];
                 }
+                onValidColouring(reported, mp.reportingStrategy);
+            }
+        };
+
+        MasterPackage mp = {0, 0, 0};
+        WorkingPackage stalePackage = {0, 0, 0, 0};
+        auto lastRebalance = Clock::now();
+        std::vector<bool> activeStrategies(strategies.size());
+        while (!hasFinished(context)) {
+            while (state.masterQueue.pop(mp)) {
+                announce(mp);
                 if (target_k >= mp.next_k) {
+                    if (scheduler) {
+                        scheduler->reportColouring(mp.reportingStrategy);
+                    }
                     target_k = mp.next_k - 1;
+                    if (mp.next_k <= lowerBound) {
+                        //There is no colouring with less colours, the remaining packages are discarded
+                        state.searchStopped = true;
+                        state.handledColourings++;
+                        continue;
+                    }
+                    std::lock_guard<std::mutex> restartGuard(state.populationMutex);
+                    TraceScope restartScope(tracer.get(), trace, "k_restart", 0, target_k);
                     for (size_t strategyId = 0; strategyId < strategies.size(); strategyId++) {
                         if (strategies[strategyId]->isFixedKStrategy()) {
                             //Wait until every worker stopped working on the affected population
+                            TraceScope waitScope(tracer.get(), trace, "wait_for_workers", strategyId);
                             while (context[strategyId] > 0) {
-                                std::this_thread::yield();
+                                //All pending packages are outdated now. Since starved strategies might not
+                                //be served by any worker, the master discards them by itself
+                                if (workQueues[strategyId]->pop(stalePackage)) {
+                                    context[strategyId].fetch_sub(1);
+                                } else {
+                                    std::this_thread::yield();
+                                }
                             }
                             context[strategyId] = 0;
+                            state.strategyK[strategyId] = target_k.load();
                             for (size_t colouringId = 0; colouringId < populationSize; colouringId++) {
                                 lock[strategyId * populationSize + colouringId] = true;
+                                state.laneIterations[strategyId * populationSize + colouringId] = 0;
                             }
                             for (size_t colouringId = 0; colouringId < populationSize; colouringId++) {
                                 context[strategyId].fetch_add(1);
-                                workQueue.push({0, strategyId, target_k, colouringId});
+                                workQueues[strategyId]->push({0, strategyId, target_k, colouringId});
                             }
                         }
                     }
                 }
+                state.handledColourings++;
+            }
+            if (timeLimit.count() > 0 && !state.searchStopped && Clock::now() >= deadline) {
+                state.searchStopped = true;
+            }
+            if (stopRequested && !state.searchStopped) {
+                state.searchStopped = true;
+            }
+            if (scheduler && Clock::now() - lastRebalance >= rebalanceInterval) {
+                for (size_t strategyId = 0; strategyId < strategies.size(); strategyId++) {
+                    activeStrategies[strategyId] = context[strategyId] > 0;
+                }
+                TraceScope rebalanceScope(tracer.get(), trace, "rebalance");
+                scheduler->rebalance(activeStrategies);
+                lastRebalance = Clock::now();
             }
             std::this_thread::yield();
         }
-        terminated = true;
+
+        if (checkpointWriter.joinable()) {
+            {
+                std::lock_guard<std::mutex> guard(state.checkpointMutex);
+                state.stopCheckpointing = true;
+            }
+            state.checkpointCondition.notify_all();
+            checkpointWriter.join();
+        }
+
+        state.terminated = true;
 
         for (auto &worker : workerPool) {
             worker.join();
         }
+        //Colourings reported after the last iteration of the loop above are part of the result as well
+        while (state.masterQueue.pop(mp)) {
+            announce(mp);
+        }
+        const double elapsedSeconds = std::chrono::duration<double>(Clock::now() - startTime).count();
+        const uint64_t elapsedTicks = readTicks() - startTicks;
+        const double secondsPerTick = elapsedTicks > 0 ? elapsedSeconds / elapsedTicks : 0.0;
+
+        //The final checkpoint allows to continue the search with a larger maxItr
+        if (!checkpointFile.empty()) {
+            Checkpoint checkpoint;
+            takeCheckpoint(G, populationSize, state, checkpoint, false);
+            writeCheckpoint(checkpointFile, checkpoint);
+        }
 
         std::vector<ColouringResult> bestResults(strategies.size());
         for (size_t strategyId = 0; strategyId < strategies.size(); strategyId++) {
@@ -350,7 +1140,9 @@ namespace graph_colouring {
                                     ? &population[nextTry] : bestColouring;
                 }
             }
-            bestResults[strategyId] = {*bestColouring, foundBestColourings};
+            bestResults[strategyId] = {*bestColouring,
+                                       foundBestColourings,
+                                       state.counters[strategyId].toStats(secondsPerTick)};
         }
         return bestResults;
     }
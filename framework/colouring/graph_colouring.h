@@ -1,15 +1,22 @@
 #pragma once
 
 #include "../../data_structure/graph.h"
+#include "instrumentation.h"
+#include "tracing.h"
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <random>
 #include <set>
+#include <string>
 #include <memory>
 #include <thread>
 #include <boost/lockfree/queue.hpp>
 #include <cstdint>
 
+class compressed_graph_access;
+
 template<typename T>
 std::ostream &operator<<(std::ostream &strm, const std::set<T> &set) {
     strm << "{";
@@ -55,22 +62,34 @@ namespace graph_colouring {
     /**
      * Operator used to create an initial configuration with k colors.
      * The parameter k represents the (desired) number of colors for the configuration.
+     * All operators draw their random numbers from the passed generator of the calling worker thread,
+     * so that runs with the same ColouringAlgorithm::seed can be reproduced.
+     * The operator types are templated on the graph type (graph_access or compressed_graph_access).
      */
-    typedef std::function<Colouring(const graph_access &G,
-                                    const ColorCount k)> InitOperator;
+    template<typename Graph>
+    using BasicInitOperator = std::function<Colouring(const Graph &G,
+                                                      const ColorCount k,
+                                                      std::mt19937 &generator)>;
+    typedef BasicInitOperator<graph_access> InitOperator;
 
     /**
      * Creates a new colouring based on two existing parent configurations s1 and s2.
      */
-    typedef std::function<Colouring(const Colouring &s1,
-                                    const Colouring &s2,
-                                    const graph_access &G)> CrossoverOperator;
+    template<typename Graph>
+    using BasicCrossoverOperator = std::function<Colouring(const Colouring &s1,
+                                                           const Colouring &s2,
+                                                           const Graph &G,
+                                                           std::mt19937 &generator)>;
+    typedef BasicCrossoverOperator<graph_access> CrossoverOperator;
 
     /**
      * Optimizes / mutates the existign colouring s.
      */
-    typedef std::function<Colouring(const Colouring &s,
-                                    const graph_access &G)> LSOperator;
+    template<typename Graph>
+    using BasicLSOperator = std::function<Colouring(const Colouring &s,
+                                                    const Graph &G,
+                                                    std::mt19937 &generator)>;
+    typedef BasicLSOperator<graph_access> LSOperator;
 
     /**
      * @param s a graph colouring
@@ -92,18 +111,38 @@ namespace graph_colouring {
      * @return true if the node denoted by \p noteID has
      * edges to nodes with the same color class
      */
-    bool allowedInClass(const graph_access &G,
+    template<typename Graph>
+    bool allowedInClass(const Graph &G,
                         const Colouring &s,
-                        Color color,
-                        NodeID nodeID);
+                        const Color color,
+                        const NodeID nodeID) {
+        for (auto neighbour : G.neighbours(nodeID)) {
+            if (s[neighbour] == color) {
+                return false;
+            }
+        }
+        return true;
+    }
 
     /**
      * @param G the target graph
      * @param s the colouring of graph \p G
      * @return the number of nodes whose neighbours reside in the same color class
      */
-    size_t numberOfConflictingNodes(const graph_access &G,
-                                    const Colouring &s);
+    template<typename Graph>
+    size_t numberOfConflictingNodes(const Graph &G,
+                                    const Colouring &s) {
+        size_t count = 0;
+        for (NodeID n = 0; n < s.size(); n++) {
+            for (auto neighbour : G.neighbours(n)) {
+                if (s[n] == s[neighbour]) {
+                    count++;
+                    break;
+                }
+            }
+        }
+        return count;
+    }
 
     /**
      *
@@ -111,8 +150,19 @@ namespace graph_colouring {
      * @param s the colouring of graph \p G
      * @return the number of edges between two nodes that have the same colouring
      */
-    size_t numberOfConflictingEdges(const graph_access &G,
-                                    const Colouring &s);
+    template<typename Graph>
+    size_t numberOfConflictingEdges(const Graph &G,
+                                    const Colouring &s) {
+        size_t count = 0;
+        for (NodeID n = 0; n < s.size(); n++) {
+            for (auto neighbour : G.neighbours(n)) {
+                if (s[n] == s[neighbour]) {
+                    count++;
+                }
+            }
+        }
+        return count / 2;
+    }
 
     /**
      *
@@ -120,8 +170,17 @@ namespace graph_colouring {
      * @param s the colouring of graph \p G
      * @return the sum of the degrees of the vertices that are uncolored
      */
-    size_t sumUncoloredDegree(const graph_access &G,
-                                    const Colouring &s);
+    template<typename Graph>
+    size_t sumUncoloredDegree(const Graph &G,
+                              const Colouring &s) {
+        size_t degree_count = 0;
+        for (NodeID id = 0; id < G.number_of_nodes(); ++id) {
+            if (s[id] == UNCOLORED) {
+                degree_count += G.getNodeDegree(id);
+            }
+        }
+        return degree_count;
+    }
 
     /**
      * @param s a colouring
@@ -154,9 +213,13 @@ namespace graph_colouring {
      * - Producing / Enhancing valid, but partial colourings.
      * Every colouring strategy can provide its own comparison operator for comparing two different colourings and
      * validation method.
+     * The strategies are templated on the graph type their operators work on (see BasicInitOperator).
      */
-    class ColouringStrategy {
+    template<typename Graph>
+    class BasicColouringStrategy {
     public:
+        virtual ~BasicColouringStrategy() = default;
+
         /**
          * True if the given coloring is a valid solution. By default, a valid coloring must:
          * - have (at most) k colors
@@ -170,7 +233,7 @@ namespace graph_colouring {
          * @param s the vertex coloring / configuration
          * @return true if the given coloring is a valid solution.
          */
-        virtual bool isSolution(const graph_access &G,
+        virtual bool isSolution(const Graph &G,
                                 const ColorCount k,
                                 const Colouring &s) const {
             return colorCount(s) <= k &&
@@ -196,30 +259,49 @@ namespace graph_colouring {
          * @param b the second coloring
          * @return True if coloring \p a has a lesser score compared to coloring \p b
          */
-        virtual bool compare(const graph_access &G,
+        virtual bool compare(const Graph &G,
                              const Colouring &a,
                              const Colouring &b) const = 0;
 
+        /**
+         * Numerical counterpart of compare which is used to measure the score gain of single operators.
+         * A colouring \p a has a lesser score compared to coloring \p b if and only if
+         * score(G, a) < score(G, b).
+         * @param G the target graph
+         * @param s the coloring
+         * @return the score of the colouring \p s
+         */
+        virtual int64_t score(const Graph &G,
+                              const Colouring &s) const = 0;
+
         /**< Used initialization operators */
-        std::vector<InitOperator> initOperators;
+        std::vector<BasicInitOperator<Graph>> initOperators;
         /**< Crossover operators */
-        std::vector<CrossoverOperator> crossoverOperators;
+        std::vector<BasicCrossoverOperator<Graph>> crossoverOperators;
         /**< Local Search / Mutation operators */
-        std::vector<LSOperator> lsOperators;
+        std::vector<BasicLSOperator<Graph>> lsOperators;
     };
 
+    typedef BasicColouringStrategy<graph_access> ColouringStrategy;
+
     /**
      * This strategy is supposed for operator families which can handle invalid colourings
      */
-    class FixedKColouringStrategy : public ColouringStrategy {
+    template<typename Graph>
+    class BasicFixedKColouringStrategy : public BasicColouringStrategy<Graph> {
     public:
-        bool compare(const graph_access &G,
+        bool compare(const Graph &G,
                      const Colouring &a,
                      const Colouring &b) const override {
             return numberOfConflictingEdges(G, a) >
                    numberOfConflictingEdges(G, b);
         }
 
+        int64_t score(const Graph &G,
+                      const Colouring &s) const override {
+            return -static_cast<int64_t>(numberOfConflictingEdges(G, s));
+        }
+
         bool isFixedKStrategy() const override {
             return true;
         }
@@ -228,15 +310,21 @@ namespace graph_colouring {
     /**
      * This strategy is supposed for operator families which can handle invalid colourings
      */
-    class FixedKPartialColouringStrategy : public ColouringStrategy {
+    template<typename Graph>
+    class BasicFixedKPartialColouringStrategy : public BasicColouringStrategy<Graph> {
     public:
-        bool compare(const graph_access &G,
+        bool compare(const Graph &G,
                      const Colouring &a,
                      const Colouring &b) const override {
             return sumUncoloredDegree(G, a) >
                 sumUncoloredDegree(G, b);
         }
 
+        int64_t score(const Graph &G,
+                      const Colouring &s) const override {
+            return -static_cast<int64_t>(sumUncoloredDegree(G, s));
+        }
+
         bool isFixedKStrategy() const override {
             return true;
         }
@@ -245,20 +333,30 @@ namespace graph_colouring {
     /**
      * This strategy is supposed for operator families which can handle valid colourings
      */
-    class VariableColouringStrategy : public ColouringStrategy {
+    template<typename Graph>
+    class BasicVariableColouringStrategy : public BasicColouringStrategy<Graph> {
     public:
-        bool compare(const graph_access &G,
+        bool compare(const Graph &,
                      const Colouring &a,
                      const Colouring &b) const override {
             return squaredColorClassSizes(a) >
                    squaredColorClassSizes(b);
         }
 
+        int64_t score(const Graph &,
+                      const Colouring &s) const override {
+            return -squaredColorClassSizes(s);
+        }
+
         bool isFixedKStrategy() const override {
             return false;
         }
     };
 
+    typedef BasicFixedKColouringStrategy<graph_access> FixedKColouringStrategy;
+    typedef BasicFixedKPartialColouringStrategy<graph_access> FixedKPartialColouringStrategy;
+    typedef BasicVariableColouringStrategy<graph_access> VariableColouringStrategy;
+
     /**
      * @brief Represents the best colouring for each strategy
      */
@@ -267,15 +365,113 @@ namespace graph_colouring {
         Colouring s;
         /**< True if no correct colouring could be found for the particular configuration */
         bool isValid;
+        /**< Time spent per operator and synchronization counters of the worker threads (see InstrumentationStats) */
+        InstrumentationStats stats;
     };
 
     class ColouringAlgorithm {
     public:
+        /**< If true, the operators of a strategy are chosen based on their recent score gain per millisecond
+         * (see OperatorSelector). Otherwise, every operator is chosen with the same probability. */
+        bool adaptiveOperatorSelection = true;
+
+        /**< If true and several strategies are passed to perform, the worker threads are periodically
+         * re-distributed among the strategies based on their rate of improvement (see PortfolioScheduler) */
+        bool portfolioScheduling = true;
+
+        /**< The time between two re-distributions of the worker threads */
+        std::chrono::milliseconds rebalanceInterval = std::chrono::milliseconds(100);
+
+        /**< If not empty, a background thread periodically writes a checkpoint of the populations into this
+         * file (see Checkpoint). The final state is written when perform returns. */
+        std::string checkpointFile;
+
+        /**< The time between two checkpoints */
+        std::chrono::milliseconds checkpointInterval = std::chrono::minutes(5);
+
+        /**< If not empty, perform continues the run stored in this checkpoint file instead of starting
+         * with new populations. The strategies and the population size must match the checkpointed run.
+         * Every colouring continues with its saved iteration count, so a finished run can be continued
+         * by passing a larger maxItr. */
+        std::string resumeFile;
+
+        /**< The time spent on searching a large clique before the colouring starts (see findLargeClique).
+         * Its size is a lower bound of the chromatic number, so the search stops as soon as a
+         * colouring with this number of colours has been found. Zero (the default) disables the clique search. */
+        std::chrono::milliseconds cliqueTimeLimit = std::chrono::milliseconds(0);
+
+        /**< Replaces cliqueTimeLimit in deterministic runs: the maximum number of branch and bound steps of the
+         * clique search (see findLargeClique). Only used if cliqueTimeLimit is positive. */
+        size_t cliqueStepLimit = 1 << 20;
+
+        /**< If true, the search runs on the kernel of the graph (see GraphReduction) and the resulting colourings
+         * are lifted to the original graph afterwards. Low degree nodes are only removed if a clique has been
+         * found, since its size must not exceed the number of colours of any lifted colouring.
+         * Ignored if a checkpoint is written or resumed. */
+        bool reduceGraph = false;
+
+        /**< If true, the connected components of the (reduced) graph are coloured independently. Components
+         * with at most exactComponentSize nodes are coloured optimally by an exact solver, the remaining components
+         * are coloured concurrently with a share of the worker threads proportional to their size.
+         * Ignored if a checkpoint is written or resumed. */
+        bool decomposeComponents = false;
+
+        /**< The largest component which is coloured by the exact solver */
+        NodeID exactComponentSize = 20;
+
+        /**< If positive, the search stops after this time (measured from the start of perform) and the best
+         * colourings found so far are returned */
+        std::chrono::milliseconds timeLimit = std::chrono::milliseconds(0);
+
+        /**< Seeds the random number generators of the worker threads. Runs with the same seed, thread count and
+         * parameters draw the same random numbers. Zero selects the historical seeds (the worker thread ids). */
+        uint64_t seed = 0;
+
+        /**< If set, called by the master thread whenever a worker reports a valid colouring with k colours found
+         * by the given strategy. If the graph is split into components, k refers to the coloured component and the
+         * callback may be called concurrently for different components. */
+        std::function<void(ColorCount k, size_t strategyId)> onColouringFound;
+
+        /**< If set, called by the master thread after onColouringFound with the reported valid colouring (which
+         * uses at most k colours, since the worker may have improved it in the meantime). Only called if the
+         * search runs on the input graph itself, i.e. neither reduceGraph nor decomposeComponents changed it. */
+        std::function<void(const Colouring &s, size_t strategyId)> onValidColouring;
+
+        /**< If not empty, a timeline of the working packages, idle times and k restarts is written to this file
+         * in the Chrome trace event format at the end of perform */
+        std::string traceFile;
+
+        /**< The maximum number of trace events kept per thread. Older events are overwritten. */
+        size_t traceCapacity = 1 << 16;
+
+        /**< If true, worker thread i is pinned to the i-th CPU the process may run on (wrapping around if there
+         * are more threads than CPUs). The master thread is not pinned. Components which are coloured concurrently
+         * (see decomposeComponents) use consecutive ranges of CPUs. */
+        bool pinThreads = false;
+
+        /**< If true, the worker threads are pinned NUMA node by NUMA node: the CPUs of a node are used before
+         * the CPUs of the next node. Overrides pinThreads. */
+        bool numaAware = false;
+
+        /**< If true and numaAware is set, every NUMA node used by the worker threads gets its own copy of the
+         * graph, which is read by the workers of this node */
+        bool replicateGraph = false;
+
+        /**< If true, runs with the same seed follow the same search trajectory: a single worker thread processes
+         * the working packages (threadCount is ignored, components are coloured one after another), every found
+         * colouring is handled by the master before the worker continues, the clique search is limited by
+         * cliqueStepLimit instead of cliqueTimeLimit, and the time based adaptive operator selection and portfolio
+         * scheduling are disabled. timeLimit may still end a run at different points. */
+        bool deterministic = false;
+
         /**
          * The main entry point for executing the genetic algorithm in parallel.
          * It will maintain a population for each colouring strategy passed to this function.
-         * For each iteration and strategy, the algorithm will choose randomly select one
-         * operator to perform a corresponding action.
+         * Every strategy has its own queue of working packages. If portfolioScheduling is enabled,
+         * worker threads prefer the strategies which currently improve their populations the most.
+         * For each iteration and strategy, the algorithm will randomly select one
+         * operator to perform a corresponding action, preferring operators which recently
+         * improved the score of their colourings if adaptiveOperatorSelection is enabled.
          * @param strategies the categories of operators and scoring functions used in this run
          * @param G the target graph
          * @param k the (maximum) number of colors
@@ -292,6 +488,84 @@ namespace graph_colouring {
                                              size_t maxItr,
                                              size_t threadCount = std::thread::hardware_concurrency(),
                                              std::ostream *outputStream = nullptr);
+
+        /**
+         * perform on a compressed graph, whose operators decode the neighbour lists while iterating them.
+         * The pre-passes and the graph replicas need a graph_access and are skipped: cliqueTimeLimit,
+         * reduceGraph, decomposeComponents and replicateGraph are ignored.
+         */
+        std::vector<ColouringResult> perform(const std::vector<std::unique_ptr<BasicColouringStrategy<compressed_graph_access>>> &strategies,
+                                             const compressed_graph_access &G,
+                                             ColorCount k,
+                                             size_t populationSize,
+                                             size_t maxItr,
+                                             size_t threadCount = std::thread::hardware_concurrency(),
+                                             std::ostream *outputStream = nullptr);
+
+        /**
+         * Makes the running perform stop its search as if timeLimit had expired, so it returns the best
+         * colourings found so far. Thread-safe; may be called from onColouringFound and onValidColouring.
+         * A call before perform starts has no effect.
+         */
+        void stop() {
+            stopRequested = true;
+        }
+
+    private:
+        /**< The graph passed to the current perform call */
+        const void *inputGraph = nullptr;
+
+        /**< Set by stop */
+        std::atomic<bool> stopRequested{false};
+
+        /**< The end of the time limit of the current run */
+        std::chrono::steady_clock::time_point deadline;
+
+        /**< Records the timeline of the current run if traceFile is set */
+        std::unique_ptr<Tracer> tracer;
+
+        /**
+         * Colours the connected components of \p G independently and merges the results
+         * @param lowerBound a lower bound of the chromatic number of the whole graph
+         */
+        std::vector<ColouringResult> colourComponents(const std::vector<std::unique_ptr<ColouringStrategy>> &strategies,
+                                                      const graph_access &G,
+                                                      ColorCount k,
+                                                      size_t populationSize,
+                                                      size_t maxItr,
+                                                      size_t threadCount,
+                                                      ColorCount lowerBound,
+                                                      std::ostream *outputStream);
+
+        /**
+         * Checks the arguments of perform and prepares the run
+         * @return the number of worker threads
+         */
+        size_t start(size_t strategyCount,
+                     size_t populationSize,
+                     size_t maxItr,
+                     size_t threadCount);
+
+        /**
+         * Writes the trace of the finished run
+         */
+        void finish();
+
+        /**
+         * Runs the genetic algorithm described in perform on the graph \p G
+         * @param lowerBound the search stops as soon as a colouring with this number of colours has been found
+         * @param firstCpu if the worker threads are pinned, worker i runs on the (firstCpu + i)-th CPU
+         */
+        template<typename Graph>
+        std::vector<ColouringResult> evolve(const std::vector<std::unique_ptr<BasicColouringStrategy<Graph>>> &strategies,
+                                            const Graph &G,
+                                            ColorCount k,
+                                            size_t populationSize,
+                                            size_t maxItr,
+                                            size_t threadCount,
+                                            ColorCount lowerBound,
+                                            size_t firstCpu,
+                                            std::ostream *outputStream);
     };
 
 
@@ -3,9 +3,43 @@
 #include "init/greedy_saturation.h"
 #include "crossover/gpx.h"
 #include "ls/tabu_search.h"
+#include "data_structure/compressed_graph.h"
 
 namespace graph_colouring {
 
+    template<typename Graph>
+    std::unique_ptr<BasicColouringStrategy<Graph>> hcaStrategy(const size_t L,
+                                                               const size_t A,
+                                                               const double alpha) {
+        std::unique_ptr<BasicColouringStrategy<Graph>> strategy(new BasicFixedKColouringStrategy<Graph>());
+        strategy->initOperators.emplace_back([](const Graph &graph,
+                                                const ColorCount colors,
+                                                std::mt19937 &generator) {
+            return graph_colouring::initByGreedySaturation(graph, colors, generator);
+
+        });
+        strategy->crossoverOperators.emplace_back([](const Colouring &s1,
+                                                     const Colouring &s2,
+                                                     const Graph &graph,
+                                                     std::mt19937 &generator) {
+            return graph_colouring::gpxCrossover(s1, s2, generator);
+        });
+        strategy->lsOperators.emplace_back([L, A, alpha](const Colouring &s,
+                                                         const Graph &graph,
+                                                         std::mt19937 &generator) {
+            return graph_colouring::tabuSearchOperator(s, graph, L, A, alpha, generator);
+        });
+        return strategy;
+    }
+
+    template std::unique_ptr<BasicColouringStrategy<graph_access>> hcaStrategy(size_t L,
+                                                                               size_t A,
+                                                                               double alpha);
+
+    template std::unique_ptr<BasicColouringStrategy<compressed_graph_access>> hcaStrategy(size_t L,
+                                                                                          size_t A,
+                                                                                          double alpha);
+
     ColouringResult hybridColouringAlgorithm(
             const graph_access &G,
             const ColorCount k,
@@ -18,21 +52,7 @@ namespace graph_colouring {
             std::ostream *outputStream) {
 
         std::vector<std::unique_ptr<ColouringStrategy>> strategies;
-        strategies.emplace_back(new FixedKColouringStrategy());
-        strategies[0]->initOperators.emplace_back([](const graph_access &graph,
-                                                     const ColorCount colors) {
-            return graph_colouring::initByGreedySaturation(graph, colors);
-
-        });
-        strategies[0]->crossoverOperators.emplace_back([](const Colouring &s1,
-                                                          const Colouring &s2,
-                                                          const graph_access &graph) {
-            return graph_colouring::gpxCrossover(s1, s2);
-        });
-        strategies[0]->lsOperators.emplace_back([L, A, alpha](const Colouring &s,
-                                                              const graph_access &graph) {
-            return graph_colouring::tabuSearchOperator(s, graph, L, A, alpha);
-        });
+        strategies.push_back(hcaStrategy(L, A, alpha));
 
         return ColouringAlgorithm().perform(strategies,
                                             G,
@@ -42,4 +62,4 @@ namespace graph_colouring {
                                             threadCount,
                                             outputStream)[0];
     }
-}
\ No newline at end of file
+}
@@ -3,6 +3,20 @@
 #include "graph_colouring.h"
 
 namespace graph_colouring {
+    /**
+     * Creates the colouring strategy of the hybrid colouring algorithm: greedy saturation initialization,
+     * GPX crossover and tabu search
+     * @param L number of iterations for the tabu search operator
+     * @param A tuning parameter for tabu search operator
+     * @param alpha tuning parameter for tabu search operator
+     * @return the fixed k colouring strategy
+     * @tparam Graph graph_access or compressed_graph_access
+     */
+    template<typename Graph = graph_access>
+    std::unique_ptr<BasicColouringStrategy<Graph>> hcaStrategy(size_t L,
+                                                               size_t A,
+                                                               double alpha);
+
     /**
      * Very naive implementation of the hybrid coloring algorithm.
      * See Hybrid Evolutionary Algorithms for Graph Coloring.
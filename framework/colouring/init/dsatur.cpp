@@ -0,0 +1,65 @@
+#include "dsatur.h"
+
+#include <algorithm>
+#include <tuple>
+
+using namespace graph_colouring;
+
+Colouring graph_colouring::dsaturColouring(const graph_access &G) {
+    const NodeID V = G.number_of_nodes();
+    Colouring s(V, UNCOLORED);
+
+    //A node of degree d is always coloured with a colour <= d, so only the neighbour colours below d + 1 are
+    //needed to choose its colour. They are stored in d + 1 flags per node (at offset first_edge + node).
+    //Larger neighbour colours only count for the saturation and are kept in a short list per node.
+    std::vector<bool> adjacentColour(G.number_of_edges() + V, false);
+    std::vector<std::vector<Color>> largeAdjacentColours(V);
+    std::vector<NodeID> saturation(V, 0);
+
+    //Ordered by saturation, degree and the inverted node id, the next node is the last element
+    typedef std::tuple<NodeID, EdgeID, NodeID> Key;
+    auto key = [&](NodeID n) {
+        return Key(saturation[n], G.getNodeDegree(n), V - 1 - n);
+    };
+    std::set<Key> queue;
+    for (NodeID n = 0; n < V; n++) {
+        queue.insert(key(n));
+    }
+
+    while (!queue.empty()) {
+        auto last = std::prev(queue.end());
+        NodeID n = V - 1 - std::get<2>(*last);
+        queue.erase(last);
+
+        const EdgeID offset = G.get_first_edge(n) + n;
+        Color c = 0;
+        while (adjacentColour[offset + c]) {
+            c++;
+        }
+        s[n] = c;
+
+        for (auto neighbour : G.neighbours(n)) {
+            if (s[neighbour] != UNCOLORED) {
+                continue;
+            }
+            bool isNew;
+            if (c <= G.getNodeDegree(neighbour)) {
+                auto flag = adjacentColour[G.get_first_edge(neighbour) + neighbour + c];
+                isNew = !flag;
+                flag = true;
+            } else {
+                auto &colours = largeAdjacentColours[neighbour];
+                isNew = std::find(colours.begin(), colours.end(), c) == colours.end();
+                if (isNew) {
+                    colours.push_back(c);
+                }
+            }
+            if (isNew) {
+                queue.erase(key(neighbour));
+                saturation[neighbour]++;
+                queue.insert(key(neighbour));
+            }
+        }
+    }
+    return s;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "../graph_colouring.h"
+
+namespace graph_colouring {
+    /**
+     * DSatur colouring: repeatedly colours the uncoloured node with the most distinct colours in its
+     * neighbourhood (ties are broken by the degree, then by the smaller node id) with the smallest allowed colour.
+     * See Brelaz, New methods to color the vertices of a graph.
+     * Runs in O((V + E) log V).
+     * @param G the target graph
+     * @return a valid colouring of \p G
+     */
+    Colouring dsaturColouring(const graph_access &G);
+}
@@ -1,8 +1,10 @@
 #include "greedy_saturation.h"
+#include "data_structure/compressed_graph.h"
 
 using namespace graph_colouring;
 
-inline std::set<NodeID> toSet(const graph_access &G) {
+template<typename Graph>
+inline std::set<NodeID> toSet(const Graph &G) {
     std::set<NodeID> nodes;
     for (NodeID n = 0; n < G.number_of_nodes(); n++) {
         nodes.insert(n);
@@ -10,7 +12,8 @@ inline std::set<NodeID> toSet(const graph_access &G) {
     return nodes;
 }
 
-static ColorCount numberOfAllowedClasses(const graph_access &G,
+template<typename Graph>
+static ColorCount numberOfAllowedClasses(const Graph &G,
                                          const Colouring &s,
                                          const NodeID nodeID,
                                          const ColorCount k) {
@@ -21,7 +24,8 @@ static ColorCount numberOfAllowedClasses(const graph_access &G,
     return count;
 }
 
-static NodeID nextNodeWithMinAllowedClasses(const graph_access &G,
+template<typename Graph>
+static NodeID nextNodeWithMinAllowedClasses(const Graph &G,
                                             const Colouring &c,
                                             const std::set<NodeID> &nodes,
                                             const ColorCount k) {
@@ -38,7 +42,16 @@ static NodeID nextNodeWithMinAllowedClasses(const graph_access &G,
     return targetNode;
 }
 
-Colouring graph_colouring::initByGreedySaturation(const graph_access &G, const ColorCount k) {
+template<typename Graph>
+Colouring graph_colouring::initByGreedySaturation(const Graph &G, const ColorCount k) {
+    std::mt19937 generator;
+    return initByGreedySaturation(G, k, generator);
+}
+
+template<typename Graph>
+Colouring graph_colouring::initByGreedySaturation(const Graph &G,
+                                                  const ColorCount k,
+                                                  std::mt19937 &generator) {
     Colouring s(G.number_of_nodes(), std::numeric_limits<NodeID>::max());
 
     auto nodes = toSet(G);
@@ -58,11 +71,20 @@ Colouring graph_colouring::initByGreedySaturation(const graph_access &G, const C
         v = nextNodeWithMinAllowedClasses(G, s, nodes, k);
     }
     std::uniform_int_distribution<Color> distribution(0, static_cast<Color>(k - 1));
-    std::mt19937 generator;
     for (NodeID n : nodes) {
         s[n] = distribution(generator);
     }
     return s;
 }
 
+template Colouring graph_colouring::initByGreedySaturation(const graph_access &G, ColorCount k);
+
+template Colouring graph_colouring::initByGreedySaturation(const compressed_graph_access &G, ColorCount k);
+
+template Colouring graph_colouring::initByGreedySaturation(const graph_access &G,
+                                                           ColorCount k,
+                                                           std::mt19937 &generator);
 
+template Colouring graph_colouring::initByGreedySaturation(const compressed_graph_access &G,
+                                                           ColorCount k,
+                                                           std::mt19937 &generator);
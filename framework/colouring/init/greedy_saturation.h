@@ -8,8 +8,19 @@ namespace graph_colouring {
      * See Hybrid Evolutionary Algorithms for Graph Coloring, page 385
      * @param k the number of used colors
      * @param G the target graph
+     * @param generator the source of random numbers
      * @return a (possibly invalid) colouring with \p k colors
+     * @tparam Graph graph_access or compressed_graph_access
      */
-    Colouring initByGreedySaturation(const graph_access &G,
+    template<typename Graph>
+    Colouring initByGreedySaturation(const Graph &G,
+                                     ColorCount k,
+                                     std::mt19937 &generator);
+
+    /**
+     * initByGreedySaturation with a default constructed generator, i.e. every call draws the same random numbers
+     */
+    template<typename Graph>
+    Colouring initByGreedySaturation(const Graph &G,
                                      ColorCount k);
 }
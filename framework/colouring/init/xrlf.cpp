@@ -8,38 +8,52 @@
 using namespace graph_colouring;
 
 Colouring graph_colouring::initByXRLFIgnored(const graph_access &G, const ColorCount _) {
+    return initByXRLFIgnored(G, _, xrlf::rngGenerator);
+}
+
+Colouring graph_colouring::initByXRLFRandom(const graph_access &G, const ColorCount k) {
+    return initByXRLFRandom(G, k, xrlf::rngGenerator);
+}
+
+Colouring graph_colouring::initByXRLFUncolored(const graph_access &G, const ColorCount k) {
+    return initByXRLFUncolored(G, k, xrlf::rngGenerator);
+}
+
+Colouring graph_colouring::initByXRLFIgnored(const graph_access &G, const ColorCount _, std::mt19937 &generator) {
     xrlf::XRLFParameters params;
     params.COLORCOUNT = _;
-    return xrlf::initByXRLF(G, params);
+    return xrlf::initByXRLF(G, params, generator);
 }
 
-Colouring graph_colouring::initByXRLFRandom(const graph_access &G, const ColorCount k) {
+Colouring graph_colouring::initByXRLFRandom(const graph_access &G, const ColorCount k, std::mt19937 &generator) {
     xrlf::XRLFParameters params;
     params.COLORCOUNT = k;
     params.MODE = xrlf::XRLFMode::RANDOM_COLOR_REMAINNIG;
-    return xrlf::initByXRLF(G, params);
+    return xrlf::initByXRLF(G, params, generator);
 }
 
-Colouring graph_colouring::initByXRLFUncolored(const graph_access &G, const ColorCount k) {
+Colouring graph_colouring::initByXRLFUncolored(const graph_access &G, const ColorCount k, std::mt19937 &generator) {
     xrlf::XRLFParameters params;
     params.COLORCOUNT = k;
     params.MODE = xrlf::XRLFMode::UNCOLOR_REMAINING;
-    return xrlf::initByXRLF(G, params);
+    return xrlf::initByXRLF(G, params, generator);
 }
 
 namespace xrlf {
-    std::random_device randomNumberDevice;
-    std::mt19937 rngGenerator(xrlf::randomNumberDevice());
+    thread_local std::mt19937 rngGenerator(std::random_device{}());
 
-    
     Colouring initByXRLF(const graph_access &G, XRLFParameters parameters) {
+        return initByXRLF(G, parameters, rngGenerator);
+    }
+    
+    Colouring initByXRLF(const graph_access &G, XRLFParameters parameters, std::mt19937 &generator) {
         Colouring s(G.number_of_nodes(), std::numeric_limits<NodeID>::max());
         Color k = 0;
 
         NodeID nodeCount = G.number_of_nodes();
         xrlf::Subgraph subgraph(G);
         while (subgraph.getNumberOfNodes() > parameters.EXACTLIM) {
-            std::unordered_set<NodeID> independentSet = xrlf::calculateIndependentSet(subgraph, parameters);
+            std::unordered_set<NodeID> independentSet = xrlf::calculateIndependentSet(subgraph, parameters, generator);
             assert(xrlf::isIndependentSet(independentSet, G));
             subgraph.removeNodes(independentSet);
             // Color Independent set
@@ -58,7 +72,7 @@ namespace xrlf {
 
                     for (auto n_ = nodes.begin(); n_ != nodes.end(); n_++) {
                         NodeID n = *n_;
-                        Color r = distr(xrlf::rngGenerator);
+                        Color r = distr(generator);
                         s[n] = r;
                     }
                     return s;
@@ -398,6 +412,10 @@ namespace xrlf {
     }
 
     std::unordered_set<NodeID> calculateIndependentSet(xrlf::Subgraph &subgraph, XRLFParameters parameters) {
+        return calculateIndependentSet(subgraph, parameters, rngGenerator);
+    }
+
+    std::unordered_set<NodeID> calculateIndependentSet(xrlf::Subgraph &subgraph, XRLFParameters parameters, std::mt19937 &generator) {
         // 1.
         bool setBest = false;
         NodeID best = 0;
@@ -408,7 +426,7 @@ namespace xrlf {
         NodeID numNodes = subgraph.getNumberOfNodes();
         // 2.
         if (parameters.TRIALNUM == 1 && numNodes > parameters.SETLIM) {
-            C0.insert(subgraph.randomMaxDegreeNode());            
+            C0.insert(subgraph.randomMaxDegreeNode(generator));            
         }
 
         // 3.
@@ -465,7 +483,7 @@ namespace xrlf {
                 std::uniform_int_distribution<NodeID> distr(0, W.size() - 1);
 
                 for (int i = 0; i < parameters.CANDNUM; i++) {
-                    auto r = distr(xrlf::rngGenerator);
+                    auto r = distr(generator);
                     NodeID u = W.getElementAt(r);
                     std::shared_ptr<std::unordered_set<NodeID>> neighbors = subgraph.getNeighbors(u);
                     NodeID deg = 0;
@@ -601,9 +619,13 @@ namespace xrlf {
     }
 
     NodeID Subgraph::randomMaxDegreeNode() const {
+        return randomMaxDegreeNode(rngGenerator);
+    }
+
+    NodeID Subgraph::randomMaxDegreeNode(std::mt19937 &generator) const {
         assert(maxDegreeNodes.size() > 0);
         std::uniform_int_distribution<NodeID>  distr(0, maxDegreeNodes.size() - 1);
-        auto r = distr(xrlf::rngGenerator);
+        auto r = distr(generator);
         return maxDegreeNodes.getElementAt(r);
     }
 
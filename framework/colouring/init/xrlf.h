@@ -26,11 +26,29 @@ namespace graph_colouring {
     Colouring initByXRLFUncolored(const graph_access &G,
                                      const ColorCount k);
 
+    /**
+     * The versions above drawing their random numbers from \p generator
+     */
+    Colouring initByXRLFIgnored(const graph_access &G,
+                                const ColorCount _,
+                                std::mt19937 &generator);
+
+    Colouring initByXRLFRandom(const graph_access &G,
+                               const ColorCount k,
+                               std::mt19937 &generator);
+
+    Colouring initByXRLFUncolored(const graph_access &G,
+                                  const ColorCount k,
+                                  std::mt19937 &generator);
+
 };
 
 namespace xrlf {
-    extern std::random_device randomNumberDevice;
-    extern std::mt19937 rngGenerator;
+    /**
+     * The generator of the calling thread used by the functions without a generator parameter.
+     * Every thread seeds its generator from a std::random_device.
+     */
+    extern thread_local std::mt19937 rngGenerator;
 
 
     enum XRLFMode {
@@ -52,6 +70,7 @@ namespace xrlf {
      * This function is called by the methods in graph_colouring 
      */
     graph_colouring::Colouring initByXRLF(const graph_access &G, XRLFParameters parameters);
+    graph_colouring::Colouring initByXRLF(const graph_access &G, XRLFParameters parameters, std::mt19937 &generator);
 
     bool isIndependentSet(std::unordered_set<NodeID> set, const graph_access &G);
         
@@ -140,6 +159,7 @@ namespace xrlf {
             void removeNodes(std::unordered_set<NodeID> nodes);
             NodeID getNodeDegree(NodeID node) const;
             NodeID randomMaxDegreeNode() const;
+            NodeID randomMaxDegreeNode(std::mt19937 &generator) const;
             NodeID getMinDegree() const;
             NodeID getNumberOfNodes() const;
             std::shared_ptr<std::unordered_set<NodeID>> getNeighbors(NodeID node) const;
@@ -206,5 +226,6 @@ namespace xrlf {
     typedef std::pair<std::unordered_set<NodeID>, NodeID> SubsetPair;
     std::unordered_set<NodeID> exhaustiveSearch(const RandomAccessSet<NodeID> &W, const xrlf::Subgraph& s, std::unordered_set<NodeID> const& C);
     std::unordered_set<NodeID> calculateIndependentSet(xrlf::Subgraph &subgraph, XRLFParameters parameters);    
+    std::unordered_set<NodeID> calculateIndependentSet(xrlf::Subgraph &subgraph, XRLFParameters parameters, std::mt19937 &generator);
     void findOptimalColouring(xrlf::Subgraph &G, graph_colouring::Colouring& colouring, Color& offset);
 };
\ No newline at end of file
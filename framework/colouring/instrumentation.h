@@ -0,0 +1,213 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#if defined(COLOURING_INSTRUMENTATION) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
+
+namespace graph_colouring {
+
+    /**
+     * The instrumented regions of the worker threads of ColouringAlgorithm
+     */
+    enum InstrumentedRegion {
+        REGION_INIT,
+        REGION_CROSSOVER,
+        REGION_LOCAL_SEARCH,
+        REGION_COMPARE,
+        REGION_IS_SOLUTION,
+        /**< Successful pops and pushes of working packages */
+        REGION_QUEUE,
+        /**< Selecting and locking a parent, including the retries if the parent is in use */
+        REGION_CHOOSE_PARENT,
+        REGION_COUNT
+    };
+
+    /**
+     * @return a printable name of the region
+     */
+    inline const char *regionName(const InstrumentedRegion region) {
+        static const char *names[REGION_COUNT] = {"init", "crossover", "local_search", "compare", "is_solution",
+                                                   "queue", "choose_parent"};
+        return names[region];
+    }
+
+    /**
+     * Aggregated counters of the worker threads. Only collected if the library has been built with
+     * COLOURING_INSTRUMENTATION, otherwise every counter is zero.
+     */
+    struct InstrumentationStats {
+        /**< True if the counters have been collected */
+        bool enabled = false;
+        /**< calls[r] = the number of executions of region r */
+        std::array<uint64_t, REGION_COUNT> calls{};
+        /**< seconds[r] = the time spent in region r, summed over all threads */
+        std::array<double, REGION_COUNT> seconds{};
+        /**< The number of processed working packages */
+        uint64_t packages = 0;
+        /**< The number of working packages discarded after a k-restart or the end of the search */
+        uint64_t discardedPackages = 0;
+        /**< The number of parents selected for crossover */
+        uint64_t parentSelections = 0;
+        /**< The number of failed attempts to lock a parent (the parent was in use by another thread) */
+        uint64_t parentRetries = 0;
+
+        InstrumentationStats &operator+=(const InstrumentationStats &other) {
+            enabled = enabled || other.enabled;
+            for (size_t r = 0; r < REGION_COUNT; r++) {
+                calls[r] += other.calls[r];
+                seconds[r] += other.seconds[r];
+            }
+            packages += other.packages;
+            discardedPackages += other.discardedPackages;
+            parentSelections += other.parentSelections;
+            parentRetries += other.parentRetries;
+            return *this;
+        }
+    };
+
+#ifdef COLOURING_INSTRUMENTATION
+#define COLOURING_INSTRUMENT(statement) statement
+#else
+#define COLOURING_INSTRUMENT(statement)
+#endif
+
+    /**
+     * @return the time stamp counter on x86 and the nanoseconds of the steady clock otherwise
+     */
+    inline uint64_t readTicks() {
+#if defined(COLOURING_INSTRUMENTATION) && (defined(__x86_64__) || defined(__i386__))
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /**
+     * Counters of a single worker thread and strategy. Every worker thread owns its counters, which are
+     * padded to whole cache lines (see ThreadCounterVector), and merges them into the shared totals when it
+     * terminates.
+     */
+    struct alignas(64) ThreadCounters {
+#ifdef COLOURING_INSTRUMENTATION
+        std::array<uint64_t, REGION_COUNT> calls{};
+        std::array<uint64_t, REGION_COUNT> ticks{};
+        uint64_t packages = 0;
+        uint64_t discardedPackages = 0;
+        uint64_t parentSelections = 0;
+        uint64_t parentRetries = 0;
+
+        void add(const InstrumentedRegion region, const uint64_t elapsedTicks) {
+            calls[region]++;
+            ticks[region] += elapsedTicks;
+        }
+
+        ThreadCounters &operator+=(const ThreadCounters &other) {
+            for (size_t r = 0; r < REGION_COUNT; r++) {
+                calls[r] += other.calls[r];
+                ticks[r] += other.ticks[r];
+            }
+            packages += other.packages;
+            discardedPackages += other.discardedPackages;
+            parentSelections += other.parentSelections;
+            parentRetries += other.parentRetries;
+            return *this;
+        }
+
+        /**
+         * @param secondsPerTick the duration of a tick (see readTicks)
+         */
+        InstrumentationStats toStats(const double secondsPerTick) const {
+            InstrumentationStats stats;
+            stats.enabled = true;
+            for (size_t r = 0; r < REGION_COUNT; r++) {
+                stats.calls[r] = calls[r];
+                stats.seconds[r] = ticks[r] * secondsPerTick;
+            }
+            stats.packages = packages;
+            stats.discardedPackages = discardedPackages;
+            stats.parentSelections = parentSelections;
+            stats.parentRetries = parentRetries;
+            return stats;
+        }
+#else
+        ThreadCounters &operator+=(const ThreadCounters &) {
+            return *this;
+        }
+
+        InstrumentationStats toStats(double) const {
+            return InstrumentationStats();
+        }
+#endif
+    };
+
+    /**
+     * Allocates cache line aligned memory. std::allocator does not have to respect the alignment of
+     * over-aligned types before C++17.
+     */
+    template<typename T>
+    struct CacheLineAllocator {
+        using value_type = T;
+
+        CacheLineAllocator() = default;
+
+        template<typename U>
+        CacheLineAllocator(const CacheLineAllocator<U> &) {}
+
+        T *allocate(const size_t n) {
+            void *memory = nullptr;
+            if (posix_memalign(&memory, 64, n * sizeof(T)) != 0) {
+                throw std::bad_alloc();
+            }
+            return static_cast<T *>(memory);
+        }
+
+        void deallocate(T *memory, size_t) {
+            free(memory);
+        }
+    };
+
+    template<typename T, typename U>
+    inline bool operator==(const CacheLineAllocator<T> &, const CacheLineAllocator<U> &) {
+        return true;
+    }
+
+    template<typename T, typename U>
+    inline bool operator!=(const CacheLineAllocator<T> &, const CacheLineAllocator<U> &) {
+        return false;
+    }
+
+    using ThreadCounterVector = std::vector<ThreadCounters, CacheLineAllocator<ThreadCounters>>;
+
+    /**
+     * Evaluates f() and accounts its duration to the given region. Without COLOURING_INSTRUMENTATION,
+     * this is a plain call of f.
+     */
+    template<typename F>
+    inline auto instrumented(ThreadCounters &counters,
+                             const InstrumentedRegion region,
+                             F f) -> decltype(f()) {
+#ifndef COLOURING_INSTRUMENTATION
+        (void) counters;
+        (void) region;
+#else
+        struct RegionTimer {
+            ThreadCounters &counters;
+            InstrumentedRegion region;
+            uint64_t start;
+
+            ~RegionTimer() {
+                counters.add(region, readTicks() - start);
+            }
+        } timer{counters, region, readTicks()};
+#endif
+        return f();
+    }
+}
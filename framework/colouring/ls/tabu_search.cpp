@@ -1,15 +1,27 @@
 #include "tabu_search.h"
+#include "data_structure/compressed_graph.h"
 
 using namespace graph_colouring;
 
+template<typename Graph>
 Colouring graph_colouring::tabuSearchOperator(const Colouring &s,
-                                              const graph_access &G,
+                                              const Graph &G,
                                               const size_t L,
                                               const size_t A,
                                               const double alpha) {
+    std::mt19937 generator;
+    return tabuSearchOperator(s, G, L, A, alpha, generator);
+}
+
+template<typename Graph>
+Colouring graph_colouring::tabuSearchOperator(const Colouring &s,
+                                              const Graph &G,
+                                              const size_t L,
+                                              const size_t A,
+                                              const double alpha,
+                                              std::mt19937 &generator) {
     Colouring s_mutated(s);
     std::uniform_int_distribution<size_t> distribution(0, A - 1);
-    std::mt19937 generator;
     //tabu tenure
     auto tl = static_cast<size_t>(distribution(generator)
                                   + alpha * numberOfConflictingNodes(G, s_mutated));
@@ -54,4 +66,30 @@ Colouring graph_colouring::tabuSearchOperator(const Colouring &s,
     }
 
     return s_mutated;
-}
\ No newline at end of file
+}
+
+template Colouring graph_colouring::tabuSearchOperator(const Colouring &s,
+                                                       const graph_access &G,
+                                                       size_t L,
+                                                       size_t A,
+                                                       double alpha);
+
+template Colouring graph_colouring::tabuSearchOperator(const Colouring &s,
+                                                       const compressed_graph_access &G,
+                                                       size_t L,
+                                                       size_t A,
+                                                       double alpha);
+
+template Colouring graph_colouring::tabuSearchOperator(const Colouring &s,
+                                                       const graph_access &G,
+                                                       size_t L,
+                                                       size_t A,
+                                                       double alpha,
+                                                       std::mt19937 &generator);
+
+template Colouring graph_colouring::tabuSearchOperator(const Colouring &s,
+                                                       const compressed_graph_access &G,
+                                                       size_t L,
+                                                       size_t A,
+                                                       double alpha,
+                                                       std::mt19937 &generator);
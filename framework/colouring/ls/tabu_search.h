@@ -11,10 +11,24 @@ namespace graph_colouring {
      * @param L the maximum number of iterations
      * @param A tuning parameter for table list length
      * @param alpha tuning parameter for table list length
+     * @param generator the source of random numbers
      * @return an enhanced colouring based of configuration \p s
+     * @tparam Graph graph_access or compressed_graph_access
      */
+    template<typename Graph>
     Colouring tabuSearchOperator(const Colouring &s,
-                                 const graph_access &G,
+                                 const Graph &G,
+                                 size_t L,
+                                 size_t A,
+                                 double alpha,
+                                 std::mt19937 &generator);
+
+    /**
+     * tabuSearchOperator with a default constructed generator, i.e. every call draws the same random numbers
+     */
+    template<typename Graph>
+    Colouring tabuSearchOperator(const Colouring &s,
+                                 const Graph &G,
                                  size_t L,
                                  size_t A,
                                  double alpha);
@@ -0,0 +1,101 @@
+#include "operator_selection.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace graph_colouring {
+
+    /**
+     * Lock-free exponential smoothing of an atomic value
+     */
+    static void smooth(std::atomic<double> &value, const double sample, const double rate) {
+        double expected = value.load(std::memory_order_relaxed);
+        while (!value.compare_exchange_weak(expected, expected + rate * (sample - expected),
+                                            std::memory_order_relaxed)) {
+        }
+    }
+
+    OperatorSelector::OperatorSelector(const size_t operatorCount,
+                                       const double minProbability,
+                                       const double adaptationRate)
+            : operatorCount(operatorCount),
+              minProbability(operatorCount > 0 ? std::min(minProbability, 1.0 / operatorCount) : 0.0),
+              adaptationRate(adaptationRate),
+              stats(new OperatorStats[operatorCount]),
+              baseline(0.0),
+              hasBaseline(false) {
+        for (size_t i = 0; i < operatorCount; i++) {
+            stats[i].quality = 0.0;
+            stats[i].applications = 0;
+        }
+    }
+
+    double OperatorSelector::qualitySum() const {
+        double sum = 0.0;
+        for (size_t i = 0; i < operatorCount; i++) {
+            sum += stats[i].quality.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    size_t OperatorSelector::select(std::mt19937 &generator) const {
+        assert(operatorCount > 0);
+        const double sum = qualitySum();
+        if (sum <= 0.0) {
+            std::uniform_int_distribution<size_t> operatorDist(0, operatorCount - 1);
+            return operatorDist(generator);
+        }
+        std::uniform_real_distribution<double> rouletteDist(0.0, 1.0);
+        const double r = rouletteDist(generator);
+        const double scale = (1.0 - operatorCount * minProbability) / sum;
+        double cumulated = 0.0;
+        for (size_t i = 0; i < operatorCount; i++) {
+            cumulated += minProbability + scale * stats[i].quality.load(std::memory_order_relaxed);
+            if (r < cumulated) {
+                return i;
+            }
+        }
+        return operatorCount - 1;
+    }
+
+    void OperatorSelector::reward(const size_t operatorId,
+                                  const double gain,
+                                  const std::chrono::nanoseconds elapsed) {
+        assert(operatorId < operatorCount);
+        //Avoids division by zero for operators which are faster than the clock resolution
+        const double elapsedMs = std::max(std::chrono::duration<double, std::milli>(elapsed).count(), 1e-3);
+        smooth(stats[operatorId].quality, std::max(gain, 0.0) / elapsedMs, adaptationRate);
+        stats[operatorId].applications.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void OperatorSelector::rewardScore(const size_t operatorId,
+                                       const double score,
+                                       const std::chrono::nanoseconds elapsed) {
+        bool expected = false;
+        if (hasBaseline.compare_exchange_strong(expected, true)) {
+            baseline = score;
+        }
+        reward(operatorId, score - baseline.load(std::memory_order_relaxed), elapsed);
+        smooth(baseline, score, adaptationRate);
+    }
+
+    double OperatorSelector::probability(const size_t operatorId) const {
+        assert(operatorId < operatorCount);
+        const double sum = qualitySum();
+        if (sum <= 0.0) {
+            return 1.0 / operatorCount;
+        }
+        return minProbability
+               + (1.0 - operatorCount * minProbability) * stats[operatorId].quality.load(std::memory_order_relaxed) / sum;
+    }
+
+    double OperatorSelector::quality(const size_t operatorId) const {
+        assert(operatorId < operatorCount);
+        return stats[operatorId].quality.load(std::memory_order_relaxed);
+    }
+
+    size_t OperatorSelector::applications(const size_t operatorId) const {
+        assert(operatorId < operatorCount);
+        return stats[operatorId].applications.load(std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <random>
+
+namespace graph_colouring {
+
+    /**
+     * Adaptive selection of one operator out of a family of operators (init, crossover or local search)
+     * based on online credit assignment.
+     * Every operator keeps an exponentially smoothed quality q_i which represents the score gain per millisecond
+     * the operator achieved in its recent applications. The selection follows the probability matching scheme:
+     * p_i = pMin + (1 - n * pMin) * q_i / sum(q)
+     * As long as no operator reported a positive gain, all operators are chosen with the same probability.
+     * All methods are lock-free and may be called concurrently from any worker thread.
+     */
+    class OperatorSelector {
+    public:
+        /**
+         * @param operatorCount the number of operators to choose from
+         * @param minProbability the minimal selection probability of every operator (at most 1 / operatorCount)
+         * @param adaptationRate the weight of a new reward within the smoothed quality of an operator
+         */
+        explicit OperatorSelector(size_t operatorCount,
+                                  double minProbability = 0.05,
+                                  double adaptationRate = 0.1);
+
+        /**
+         * @param generator the random number generator of the calling thread
+         * @return the index of the next operator to apply
+         */
+        size_t select(std::mt19937 &generator) const;
+
+        /**
+         * Credits the operator \p operatorId with the score gain of one application
+         * @param operatorId the applied operator
+         * @param gain the score difference between the resulting and the original colouring
+         * (negative values are treated as zero gain)
+         * @param elapsed the time needed to apply the operator
+         */
+        void reward(size_t operatorId,
+                    double gain,
+                    std::chrono::nanoseconds elapsed);
+
+        /**
+         * Credits an operator which created a colouring from scratch (e.g. an init operator).
+         * The gain is measured against the smoothed score of all colourings reported to this method.
+         * @param operatorId the applied operator
+         * @param score the score of the created colouring
+         * @param elapsed the time needed to apply the operator
+         */
+        void rewardScore(size_t operatorId,
+                         double score,
+                         std::chrono::nanoseconds elapsed);
+
+        /**
+         * @return the current selection probability of the operator \p operatorId
+         */
+        double probability(size_t operatorId) const;
+
+        /**
+         * @return the smoothed score gain per millisecond of the operator \p operatorId
+         */
+        double quality(size_t operatorId) const;
+
+        /**
+         * @return the number of rewarded applications of the operator \p operatorId
+         */
+        size_t applications(size_t operatorId) const;
+
+        /**
+         * @return the number of managed operators
+         */
+        size_t size() const {
+            return operatorCount;
+        }
+
+    private:
+        /**
+         * Padded to a cache line to avoid false sharing between threads rewarding different operators
+         */
+        struct OperatorStats {
+            std::atomic<double> quality;
+            std::atomic<size_t> applications;
+            char padding[64 - sizeof(std::atomic<double>) - sizeof(std::atomic<size_t>)];
+        };
+
+        double qualitySum() const;
+
+        size_t operatorCount;
+        double minProbability;
+        double adaptationRate;
+        std::unique_ptr<OperatorStats[]> stats;
+        std::atomic<double> baseline;
+        std::atomic<bool> hasBaseline;
+    };
+}
@@ -0,0 +1,157 @@
+#include "portfolio_scheduler.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace graph_colouring {
+
+    PortfolioScheduler::PortfolioScheduler(const size_t strategyCount,
+                                           const size_t threadCount,
+                                           const double smoothing,
+                                           const double colouringBonus)
+            : strategyCount(strategyCount),
+              threadCount(threadCount),
+              smoothing(smoothing),
+              colouringBonus(colouringBonus),
+              stats(new StrategyStats[strategyCount]),
+              assignment(new std::atomic<size_t>[threadCount]),
+              rates(strategyCount, 0.0),
+              colourings(strategyCount, 0.0),
+              measured(strategyCount, false) {
+        assert(strategyCount > 0);
+        for (size_t strategyId = 0; strategyId < strategyCount; strategyId++) {
+            stats[strategyId].improvements = 0;
+            stats[strategyId].busyNanoseconds = 0;
+            stats[strategyId].colourings = 0;
+        }
+        //Round robin until the first measurements are available
+        for (size_t threadId = 0; threadId < threadCount; threadId++) {
+            assignment[threadId] = threadId % strategyCount;
+        }
+    }
+
+    void PortfolioScheduler::recordGeneration(const size_t strategyId,
+                                              const bool improved,
+                                              const std::chrono::nanoseconds elapsed) {
+        assert(strategyId < strategyCount);
+        if (improved) {
+            stats[strategyId].improvements.fetch_add(1, std::memory_order_relaxed);
+        }
+        stats[strategyId].busyNanoseconds.fetch_add(elapsed.count(), std::memory_order_relaxed);
+    }
+
+    void PortfolioScheduler::reportColouring(const size_t strategyId) {
+        assert(strategyId < strategyCount);
+        stats[strategyId].colourings.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void PortfolioScheduler::rebalance(const std::vector<bool> &active) {
+        assert(active.size() == strategyCount);
+
+        double maxRate = 0.0;
+        std::vector<bool> idle(strategyCount, false);
+        for (size_t strategyId = 0; strategyId < strategyCount; strategyId++) {
+            auto &strategyStats = stats[strategyId];
+            auto improvements = strategyStats.improvements.exchange(0, std::memory_order_relaxed);
+            auto busyNanoseconds = strategyStats.busyNanoseconds.exchange(0, std::memory_order_relaxed);
+            auto foundColourings = strategyStats.colourings.exchange(0, std::memory_order_relaxed);
+
+            if (busyNanoseconds > 0) {
+                double rate = improvements / (busyNanoseconds * 1e-9);
+                rates[strategyId] = measured[strategyId]
+                                    ? rates[strategyId] + smoothing * (rate - rates[strategyId])
+                                    : rate;
+                measured[strategyId] = true;
+            } else {
+                idle[strategyId] = true;
+            }
+            colourings[strategyId] = (1.0 - smoothing) * colourings[strategyId] + foundColourings;
+            if (active[strategyId]) {
+                maxRate = std::max(maxRate, rates[strategyId]);
+            }
+        }
+
+        //A strategy without threads is not measured anymore, so its rate decays toward the optimistic guess
+        //until it receives a thread again
+        for (size_t strategyId = 0; strategyId < strategyCount; strategyId++) {
+            if (active[strategyId] && measured[strategyId] && idle[strategyId]) {
+                rates[strategyId] += smoothing * (maxRate - rates[strategyId]);
+            }
+        }
+
+        std::vector<double> weights(strategyCount, 0.0);
+        double weightSum = 0.0;
+        size_t activeCount = 0;
+        for (size_t strategyId = 0; strategyId < strategyCount; strategyId++) {
+            if (!active[strategyId]) {
+                continue;
+            }
+            activeCount++;
+            if (!measured[strategyId]) {
+                //Optimistic guess for strategies without any measurements
+                weights[strategyId] = 1.0;
+            } else {
+                weights[strategyId] = (maxRate > 0.0 ? rates[strategyId] / maxRate : 0.0)
+                                      + colouringBonus * colourings[strategyId];
+            }
+            weightSum += weights[strategyId];
+        }
+        if (activeCount == 0) {
+            return;
+        }
+        if (weightSum <= 0.0) {
+            for (size_t strategyId = 0; strategyId < strategyCount; strategyId++) {
+                weights[strategyId] = active[strategyId] ? 1.0 : 0.0;
+            }
+            weightSum = activeCount;
+        }
+
+        //Largest remainder method
+        std::vector<size_t> quota(strategyCount, 0);
+        std::vector<std::pair<double, size_t>> remainders;
+        size_t assigned = 0;
+        for (size_t strategyId = 0; strategyId < strategyCount; strategyId++) {
+            double share = threadCount * weights[strategyId] / weightSum;
+            quota[strategyId] = static_cast<size_t>(std::floor(share));
+            assigned += quota[strategyId];
+            remainders.emplace_back(share - quota[strategyId], strategyId);
+        }
+        std::sort(remainders.begin(), remainders.end(), std::greater<std::pair<double, size_t>>());
+        for (size_t i = 0; assigned < threadCount; i = (i + 1) % strategyCount) {
+            if (weights[remainders[i].second] > 0.0) {
+                quota[remainders[i].second]++;
+                assigned++;
+            }
+        }
+
+        //Keep threads at their current strategy if possible
+        std::vector<bool> reassign(threadCount, true);
+        for (size_t threadId = 0; threadId < threadCount; threadId++) {
+            auto strategyId = assignment[threadId].load(std::memory_order_relaxed);
+            if (quota[strategyId] > 0) {
+                quota[strategyId]--;
+                reassign[threadId] = false;
+            }
+        }
+        size_t strategyId = 0;
+        for (size_t threadId = 0; threadId < threadCount; threadId++) {
+            if (!reassign[threadId]) {
+                continue;
+            }
+            while (quota[strategyId] == 0) {
+                strategyId++;
+            }
+            quota[strategyId]--;
+            assignment[threadId].store(strategyId, std::memory_order_relaxed);
+        }
+    }
+
+    size_t PortfolioScheduler::threadsOf(const size_t strategyId) const {
+        size_t count = 0;
+        for (size_t threadId = 0; threadId < threadCount; threadId++) {
+            count += strategyOf(threadId) == strategyId;
+        }
+        return count;
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace graph_colouring {
+
+    /**
+     * Distributes the worker threads of a ColouringAlgorithm among several colouring strategies.
+     * The worker threads report the outcome of every generation (see recordGeneration) and the master thread
+     * reports the strategies which found a colouring with a new target k (see reportColouring).
+     * Periodically, the master thread calls rebalance, which assigns the threads in proportion to
+     * the rate of improvement of each strategy (number of offsprings which were better than the replaced parent
+     * per second of computation time). The strategy that currently drives the target k down receives a bonus,
+     * while stalled strategies do not keep any dedicated thread. The rate of a strategy without threads decays toward
+     * the best rate, so it is measured again after a few calls of rebalance.
+     * Worker threads only read their assignment, so recordGeneration and strategyOf are lock-free.
+     */
+    class PortfolioScheduler {
+    public:
+        /**
+         * @param strategyCount the number of colouring strategies
+         * @param threadCount the number of worker threads
+         * @param smoothing the weight of the latest measurement within the smoothed improvement rate
+         * @param colouringBonus the additional (normalized) weight of a strategy for each reported colouring
+         */
+        PortfolioScheduler(size_t strategyCount,
+                           size_t threadCount,
+                           double smoothing = 0.5,
+                           double colouringBonus = 1.0);
+
+        /**
+         * @param threadId the id of a worker thread
+         * @return the colouring strategy the worker thread should prefer
+         */
+        size_t strategyOf(size_t threadId) const {
+            return assignment[threadId].load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Called by a worker thread after one generation (crossover and local search) of the strategy \p strategyId
+         * @param strategyId the processed strategy
+         * @param improved true if the offspring has a better score than the replaced parent
+         * @param elapsed the time spent for the generation
+         */
+        void recordGeneration(size_t strategyId,
+                              bool improved,
+                              std::chrono::nanoseconds elapsed);
+
+        /**
+         * Called by the master thread if the strategy \p strategyId has lowered the target k
+         * @param strategyId the reporting strategy
+         */
+        void reportColouring(size_t strategyId);
+
+        /**
+         * Re-assigns the worker threads based on the measurements since the last call of this method.
+         * Must only be called by a single thread.
+         * @param active active[s] = false marks strategies without any pending work, which will not receive threads
+         */
+        void rebalance(const std::vector<bool> &active);
+
+        /**
+         * @return the number of threads which currently prefer the strategy \p strategyId
+         */
+        size_t threadsOf(size_t strategyId) const;
+
+        /**
+         * @return the smoothed number of improvements per second of the strategy \p strategyId
+         */
+        double improvementRate(size_t strategyId) const {
+            return rates[strategyId];
+        }
+
+    private:
+        /**
+         * Padded to a cache line, since it is updated by the worker threads after every generation
+         */
+        struct StrategyStats {
+            std::atomic<size_t> improvements;
+            std::atomic<int64_t> busyNanoseconds;
+            std::atomic<size_t> colourings;
+            char padding[64 - 2 * sizeof(std::atomic<size_t>) - sizeof(std::atomic<int64_t>)];
+        };
+
+        size_t strategyCount;
+        size_t threadCount;
+        double smoothing;
+        double colouringBonus;
+        std::unique_ptr<StrategyStats[]> stats;
+        std::unique_ptr<std::atomic<size_t>[]> assignment;
+        /**< Smoothed rate of improvement, only accessed by the master thread */
+        std::vector<double> rates;
+        /**< Smoothed number of found colourings, only accessed by the master thread */
+        std::vector<double> colourings;
+        /**< False as long as the strategy could not be measured */
+        std::vector<bool> measured;
+    };
+}
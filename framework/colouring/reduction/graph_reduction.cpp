@@ -0,0 +1,150 @@
+#include "graph_reduction.h"
+
+#include "util/graph_util.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <queue>
+
+namespace graph_colouring {
+
+    const NodeID GraphReduction::NO_DOMINATOR = std::numeric_limits<NodeID>::max();
+
+    /**
+     * The dominance test is quadratic in the node degrees. Its total work is limited to a multiple of the graph size,
+     * since dense graphs barely contain dominated nodes.
+     */
+    static const size_t DOMINANCE_WORK_FACTOR = 32;
+
+    GraphReduction::GraphReduction(const graph_access &G,
+                                   const ColorCount minColours)
+            : G(G),
+              minColours(minColours),
+              dominator(G.number_of_nodes(), NO_DOMINATOR) {
+        const NodeID n = G.number_of_nodes();
+        std::vector<bool> alive(n, true);
+        std::vector<EdgeID> degree(n);
+        std::queue<NodeID> lowDegree;
+        for (NodeID node = 0; node < n; node++) {
+            degree[node] = G.getNodeDegree(node);
+            if (degree[node] < minColours) {
+                lowDegree.push(node);
+            }
+        }
+
+        auto remove = [&](const NodeID node) {
+            alive[node] = false;
+            removalOrder.push_back(node);
+            for (auto neighbour : G.neighbours(node)) {
+                if (alive[neighbour] && degree[neighbour]-- == minColours) {
+                    lowDegree.push(neighbour);
+                }
+            }
+        };
+        auto peel = [&]() {
+            while (!lowDegree.empty()) {
+                NodeID node = lowDegree.front();
+                lowDegree.pop();
+                if (alive[node]) {
+                    remove(node);
+                }
+            }
+        };
+        peel();
+
+        //commonNeighbours[v] = the number of neighbours v shares with the currently tested node
+        std::vector<EdgeID> commonNeighbours(n, 0);
+        std::vector<NodeID> adjacentTo(n, NO_DOMINATOR);
+        std::vector<NodeID> touched;
+        size_t workLimit = DOMINANCE_WORK_FACTOR * (size_t(n) + G.number_of_edges());
+        size_t work = 0;
+        bool changed = true;
+        while (changed && work < workLimit) {
+            changed = false;
+            for (NodeID u = 0; u < n && work < workLimit; u++) {
+                if (!alive[u] || degree[u] == 0) {
+                    continue;
+                }
+                touched.clear();
+                for (auto x : G.neighbours(u)) {
+                    if (!alive[x]) {
+                        continue;
+                    }
+                    adjacentTo[x] = u;
+                    work += G.getNodeDegree(x);
+                    for (auto v : G.neighbours(x)) {
+                        if (alive[v] && v != u) {
+                            if (commonNeighbours[v]++ == 0) {
+                                touched.push_back(v);
+                            }
+                        }
+                    }
+                }
+                NodeID dominatingNode = NO_DOMINATOR;
+                for (auto v : touched) {
+                    if (dominatingNode == NO_DOMINATOR && commonNeighbours[v] == degree[u] && adjacentTo[v] != u) {
+                        dominatingNode = v;
+                    }
+                    commonNeighbours[v] = 0;
+                }
+                if (dominatingNode != NO_DOMINATOR) {
+                    dominator[u] = dominatingNode;
+                    remove(u);
+                    peel();
+                    changed = true;
+                }
+            }
+        }
+
+        for (NodeID node = 0; node < n; node++) {
+            if (alive[node]) {
+                kernelNodes.push_back(node);
+            }
+        }
+        graph_util::inducedSubgraph(G, kernelNodes, m_kernel);
+    }
+
+    Colouring GraphReduction::lift(const Colouring &kernelColouring) const {
+        assert(kernelColouring.size() == kernelNodes.size());
+
+        //Use the colours 0, ..., k - 1 so that the removed nodes do not open additional colour classes
+        std::vector<Color> usedColours;
+        for (auto color : kernelColouring) {
+            if (color != UNCOLORED) {
+                usedColours.push_back(color);
+            }
+        }
+        std::sort(usedColours.begin(), usedColours.end());
+        usedColours.erase(std::unique(usedColours.begin(), usedColours.end()), usedColours.end());
+
+        Colouring s(G.number_of_nodes(), UNCOLORED);
+        for (NodeID i = 0; i < kernelNodes.size(); i++) {
+            if (kernelColouring[i] != UNCOLORED) {
+                s[kernelNodes[i]] = static_cast<Color>(
+                        std::lower_bound(usedColours.begin(), usedColours.end(), kernelColouring[i])
+                        - usedColours.begin());
+            }
+        }
+
+        //A node removed because of its low degree has less than minColours coloured neighbours
+        std::vector<NodeID> blocked(minColours + 1, NO_DOMINATOR);
+        for (auto node = removalOrder.rbegin(); node != removalOrder.rend(); ++node) {
+            if (dominator[*node] != NO_DOMINATOR) {
+                s[*node] = s[dominator[*node]];
+                continue;
+            }
+            for (auto neighbour : G.neighbours(*node)) {
+                if (s[neighbour] < blocked.size()) {
+                    blocked[s[neighbour]] = *node;
+                }
+            }
+            Color color = 0;
+            while (blocked[color] == *node) {
+                color++;
+            }
+            s[*node] = color;
+        }
+        return s;
+    }
+}
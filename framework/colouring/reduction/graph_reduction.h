@@ -0,0 +1,67 @@
+#pragma once
+
+#include "colouring/graph_colouring.h"
+
+#include <vector>
+
+namespace graph_colouring {
+
+    /**
+     * Removes nodes which can be coloured afterwards without introducing new colours or conflicts:
+     * - Nodes with less than minColours neighbours. Such a node always finds one of the first minColours
+     *   colours which is not used by its neighbours.
+     * - Nodes u whose neighbourhood is a subset of the neighbourhood of a non-adjacent node v.
+     *   The node u simply reuses the colour of v.
+     * Both rules are applied until no further node can be removed. The remaining nodes form the kernel graph.
+     * A colouring of the kernel is lifted to the original graph by colouring the removed nodes in the reverse order
+     * of their removal.
+     */
+    class GraphReduction {
+    public:
+        /**
+         * @param G the target graph
+         * @param minColours a lower bound of the number of colours of every lifted colouring
+         * (e.g. the size of a clique of \p G)
+         */
+        GraphReduction(const graph_access &G,
+                       ColorCount minColours);
+
+        /**
+         * @return the graph induced by the remaining nodes
+         */
+        const graph_access &kernel() const {
+            return m_kernel;
+        }
+
+        /**
+         * @return the number of removed nodes
+         */
+        NodeID removedNodes() const {
+            return static_cast<NodeID>(removalOrder.size());
+        }
+
+        /**
+         * @param kernelColouring a colouring of the kernel graph
+         * @return the corresponding colouring of the original graph. It uses at most
+         * max(colorCount(kernelColouring), minColours) colours and is valid if \p kernelColouring is valid.
+         * Otherwise, it keeps the conflicting edges of \p kernelColouring and may contain further ones, since a
+         * dominated node copies the colour of its dominator even if this colour conflicts with its neighbours.
+         * Dominated nodes of uncoloured nodes stay uncoloured.
+         */
+        Colouring lift(const Colouring &kernelColouring) const;
+
+    private:
+        static const NodeID NO_DOMINATOR;
+
+        const graph_access &G;
+        const ColorCount minColours;
+        graph_access m_kernel;
+        /**< kernelNodes[i] = the node of the original graph represented by node i of the kernel */
+        std::vector<NodeID> kernelNodes;
+        /**< The removed nodes in the order of their removal */
+        std::vector<NodeID> removalOrder;
+        /**< dominator[n] = the node whose colour is reused for the removed node n
+         * or NO_DOMINATOR if n has been removed because of its low degree */
+        std::vector<NodeID> dominator;
+    };
+}
@@ -0,0 +1,228 @@
+#include "repair.h"
+
+#include <algorithm>
+
+using namespace graph_colouring;
+
+IncrementalColouring::IncrementalColouring(dynamic_graph_access &G, const Colouring &s)
+        : G(G),
+          s(s) {
+    //map the used colours to 0, 1, ..., k - 1
+    std::vector<Color> labels;
+    for (auto c : this->s) {
+        if (c != UNCOLORED) {
+            if (c >= labels.size()) {
+                labels.resize(c + 1, UNCOLORED);
+            }
+            labels[c] = 0;
+        }
+    }
+    for (auto &label : labels) {
+        if (label != UNCOLORED) {
+            label = static_cast<Color>(classSizes.size());
+            classSizes.push_back(0);
+        }
+    }
+    for (auto &c : this->s) {
+        if (c != UNCOLORED) {
+            c = labels[c];
+            classSizes[c]++;
+        }
+    }
+    for (NodeID n = 0; n < G.number_of_nodes(); n++) {
+        if (this->s[n] == UNCOLORED && !recolour(n, colours())) {
+            classSizes.push_back(0);
+            setColour(n, colours() - 1);
+        }
+    }
+    journal.clear();
+}
+
+void IncrementalColouring::setColour(const NodeID n, const Color c) {
+    journal.emplace_back(n, s[n]);
+    if (s[n] != UNCOLORED) {
+        classSizes[s[n]]--;
+    }
+    s[n] = c;
+    if (c != UNCOLORED) {
+        classSizes[c]++;
+    }
+}
+
+void IncrementalColouring::rollback(const size_t mark) {
+    while (journal.size() > mark) {
+        auto change = journal.back();
+        journal.pop_back();
+        if (s[change.first] != UNCOLORED) {
+            classSizes[s[change.first]]--;
+        }
+        s[change.first] = change.second;
+        if (change.second != UNCOLORED) {
+            classSizes[change.second]++;
+        }
+    }
+}
+
+bool IncrementalColouring::recolour(const NodeID n, const Color limit) {
+    neighbourColours.assign(limit, 0);
+    for (auto neighbour : G.neighbours(n)) {
+        if (s[neighbour] < limit) {
+            neighbourColours[s[neighbour]]++;
+        }
+    }
+    for (Color c = 0; c < limit; c++) {
+        if (neighbourColours[c] == 0) {
+            setColour(n, c);
+            return true;
+        }
+    }
+    //a colour blocked by a single neighbour becomes free if the neighbour can move to another colour
+    std::vector<bool> blocked(limit);
+    for (Color c = 0; c < limit; c++) {
+        if (neighbourColours[c] != 1) {
+            continue;
+        }
+        NodeID blocking = 0;
+        for (auto neighbour : G.neighbours(n)) {
+            if (s[neighbour] == c) {
+                blocking = neighbour;
+                break;
+            }
+        }
+        std::fill(blocked.begin(), blocked.end(), false);
+        blocked[c] = true;
+        for (auto neighbour : G.neighbours(blocking)) {
+            if (s[neighbour] < limit) {
+                blocked[s[neighbour]] = true;
+            }
+        }
+        auto free = std::find(blocked.begin(), blocked.end(), false);
+        if (free != blocked.end()) {
+            setColour(blocking, static_cast<Color>(free - blocked.begin()));
+            setColour(n, c);
+            return true;
+        }
+    }
+    return false;
+}
+
+void IncrementalColouring::relabel(const Color from, const Color to) {
+    for (NodeID n = 0; n < G.number_of_nodes(); n++) {
+        if (s[n] == from) {
+            setColour(n, to);
+        }
+    }
+}
+
+bool IncrementalColouring::dissolveClass(const Color c) {
+    const size_t mark = journal.size();
+    const Color last = colours() - 1;
+    std::vector<NodeID> members;
+    for (NodeID n = 0; n < G.number_of_nodes(); n++) {
+        if (s[n] == c) {
+            members.push_back(n);
+        }
+    }
+    if (c != last) {
+        relabel(last, c);
+    }
+    for (auto n : members) {
+        setColour(n, UNCOLORED);
+    }
+    std::sort(members.begin(), members.end(), [this](NodeID a, NodeID b) {
+        return G.getNodeDegree(a) > G.getNodeDegree(b);
+    });
+    for (auto n : members) {
+        if (!recolour(n, last)) {
+            rollback(mark);
+            return false;
+        }
+    }
+    classSizes.pop_back();
+    return true;
+}
+
+void IncrementalColouring::reduceColours() {
+    //fill empty classes with the last class
+    for (Color c = 0; c < colours();) {
+        if (classSizes[c] > 0) {
+            c++;
+            continue;
+        }
+        if (c + 1 < colours()) {
+            relabel(colours() - 1, c);
+        }
+        classSizes.pop_back();
+    }
+    while (colours() > 1) {
+        auto smallest = std::min_element(classSizes.begin(), classSizes.end());
+        if (*smallest > maxDissolvedClass || !dissolveClass(static_cast<Color>(smallest - classSizes.begin()))) {
+            break;
+        }
+    }
+}
+
+RepairStats IncrementalColouring::summarize(const NodeID conflictingNodes) {
+    RepairStats stats;
+    stats.conflictingNodes = conflictingNodes;
+    stats.k = colours();
+    //the first journal entry of a node holds its colour before the update
+    std::stable_sort(journal.begin(), journal.end(), [](const std::pair<NodeID, Color> &a,
+                                                        const std::pair<NodeID, Color> &b) {
+        return a.first < b.first;
+    });
+    for (size_t i = 0; i < journal.size(); i++) {
+        if ((i == 0 || journal[i].first != journal[i - 1].first) && s[journal[i].first] != journal[i].second) {
+            stats.recolouredNodes++;
+        }
+    }
+    journal.clear();
+    return stats;
+}
+
+RepairStats IncrementalColouring::insertEdges(const std::vector<std::pair<NodeID, NodeID>> &edges) {
+    G.insert_edges(edges);
+    std::vector<NodeID> uncoloured;
+    for (auto &edge : edges) {
+        const NodeID u = edge.first;
+        const NodeID v = edge.second;
+        if (u >= G.number_of_nodes() || v >= G.number_of_nodes() || u == v
+            || s[u] == UNCOLORED || s[u] != s[v]) {
+            continue;
+        }
+        const NodeID n = G.getNodeDegree(u) <= G.getNodeDegree(v) ? u : v;
+        setColour(n, UNCOLORED);
+        uncoloured.push_back(n);
+    }
+    std::stable_sort(uncoloured.begin(), uncoloured.end(), [this](NodeID a, NodeID b) {
+        return G.getNodeDegree(a) > G.getNodeDegree(b);
+    });
+    for (auto n : uncoloured) {
+        if (!recolour(n, colours())) {
+            classSizes.push_back(0);
+            setColour(n, colours() - 1);
+        }
+    }
+    reduceColours();
+    return summarize(static_cast<NodeID>(uncoloured.size()));
+}
+
+RepairStats IncrementalColouring::removeEdges(const std::vector<std::pair<NodeID, NodeID>> &edges) {
+    G.remove_edges(edges);
+    for (auto &edge : edges) {
+        for (auto n : {edge.first, edge.second}) {
+            if (n >= G.number_of_nodes() || s[n] == 0) {
+                continue;
+            }
+            //move to the smallest free colour
+            const size_t mark = journal.size();
+            const Color current = s[n];
+            setColour(n, UNCOLORED);
+            if (!recolour(n, current)) {
+                rollback(mark);
+            }
+        }
+    }
+    reduceColours();
+    return summarize(0);
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "graph_colouring.h"
+#include "data_structure/dynamic_graph.h"
+
+#include <utility>
+#include <vector>
+
+namespace graph_colouring {
+
+    /**
+     * Summary of a single update of an IncrementalColouring
+     */
+    struct RepairStats {
+        /**< The number of nodes uncoloured because of conflicts with inserted edges */
+        NodeID conflictingNodes = 0;
+        /**< The number of colour changes (including the relabeling of colour classes) */
+        NodeID recolouredNodes = 0;
+        /**< The number of colours after the update */
+        ColorCount k = 0;
+    };
+
+    /**
+     * Keeps a valid colouring of a dynamic graph up to date while edges are inserted and removed.
+     * Inserted edges only touch their endpoints: of every conflicting edge, the endpoint with the smaller degree is
+     * uncoloured and recoloured with a free colour, by moving a single blocking neighbour to another colour, or with
+     * a new colour. After removals, the endpoints move to the smallest free colour and the smallest colour classes
+     * are dissolved as long as all their nodes can be recoloured this way.
+     * An update costs O(affected nodes * (degree + k)) plus O(V) for every attempt to dissolve a colour class.
+     */
+    class IncrementalColouring {
+    public:
+        /**< Colour classes with at most this many nodes are dissolved after an update if possible */
+        NodeID maxDissolvedClass = 64;
+
+        /**
+         * @param G the dynamic graph, which has to be updated through this object only
+         * @param s a valid colouring of \p G
+         */
+        IncrementalColouring(dynamic_graph_access &G, const Colouring &s);
+
+        /**
+         * Inserts edges into the graph and repairs the colouring
+         * @param edges the undirected edges (see dynamic_graph_access::insert_edges)
+         */
+        RepairStats insertEdges(const std::vector<std::pair<NodeID, NodeID>> &edges);
+
+        /**
+         * Removes edges from the graph and tries to reduce the number of colours
+         * @param edges the undirected edges (see dynamic_graph_access::remove_edges)
+         */
+        RepairStats removeEdges(const std::vector<std::pair<NodeID, NodeID>> &edges);
+
+        /**
+         * @return the current colouring, which uses the colours 0, ..., colours() - 1
+         */
+        const Colouring &colouring() const {
+            return s;
+        }
+
+        /**
+         * @return the current number of colours
+         */
+        ColorCount colours() const {
+            return static_cast<ColorCount>(classSizes.size());
+        }
+
+    private:
+        /**
+         * Changes the colour of a node and records the change in the journal
+         */
+        void setColour(NodeID n, Color c);
+
+        /**
+         * Undoes the journal entries after \p mark
+         */
+        void rollback(size_t mark);
+
+        /**
+         * Colours an uncoloured node with a colour < \p limit which is free or blocked by a single neighbour
+         * that can move to another colour < \p limit
+         * @return false if no such colour exists (nothing is changed)
+         */
+        bool recolour(NodeID n, Color limit);
+
+        /**
+         * Gives all nodes of colour \p from the colour \p to
+         */
+        void relabel(Color from, Color to);
+
+        /**
+         * Recolours all nodes of colour class \p c with the other colours and removes the class,
+         * or leaves the colouring unchanged if this is not possible
+         * @return true if the class has been removed
+         */
+        bool dissolveClass(Color c);
+
+        /**
+         * Removes empty colour classes and dissolves the smallest classes as long as possible
+         */
+        void reduceColours();
+
+        /**
+         * @return the statistics of the current update, clears the journal
+         */
+        RepairStats summarize(NodeID conflictingNodes);
+
+        dynamic_graph_access &G;
+        Colouring s;
+        /**< classSizes[c] = the number of nodes with colour c */
+        std::vector<NodeID> classSizes;
+        /**< The colour changes of the current update (node, previous colour), used to roll back */
+        std::vector<std::pair<NodeID, Color>> journal;
+        /**< Scratch space: the number of neighbours per colour */
+        std::vector<NodeID> neighbourColours;
+    };
+}
@@ -0,0 +1,48 @@
+#include "tracing.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+namespace graph_colouring {
+
+    TraceBuffer *Tracer::createBuffer(const uint32_t processId,
+                                      const uint32_t threadId,
+                                      const std::string &threadName) {
+        std::lock_guard<std::mutex> guard(buffersMutex);
+        buffers.emplace_back(new TraceBuffer(std::max<size_t>(capacity, 1), processId, threadId, threadName));
+        return buffers.back().get();
+    }
+
+    int Tracer::write(const std::string &filename) const {
+        FILE *file = fopen(filename.c_str(), "w");
+        if (file == nullptr) {
+            std::cerr << "Error opening " << filename << std::endl;
+            return 1;
+        }
+        fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+        bool first = true;
+        for (auto &buffer : buffers) {
+            fprintf(file, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %u, \"tid\": %u, "
+                          "\"args\": {\"name\": \"%s\"}}",
+                    first ? "" : ",\n", buffer->processId, buffer->threadId, buffer->threadName.c_str());
+            first = false;
+            const size_t recorded = buffer->recorded.load(std::memory_order_acquire);
+            const size_t size = buffer->events.size();
+            for (size_t i = recorded > size ? recorded - size : 0; i < recorded; i++) {
+                const TraceEvent &event = buffer->events[i % size];
+                fprintf(file, ",\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": %u, \"tid\": %u, "
+                              "\"ts\": %.3f, \"dur\": %.3f, \"args\": {\"strategy\": %u, \"value\": %llu}}",
+                        event.name, buffer->processId, buffer->threadId,
+                        event.begin / 1000.0, (event.end - event.begin) / 1000.0,
+                        event.strategyId, static_cast<unsigned long long>(event.value));
+            }
+        }
+        fprintf(file, "\n]}\n");
+        if (fclose(file) != 0) {
+            std::cerr << "Error writing " << filename << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace graph_colouring {
+
+    /**
+     * A single timeline event. Times are measured in nanoseconds since the creation of the Tracer.
+     */
+    struct TraceEvent {
+        /**< A static string naming the event */
+        const char *name;
+        uint64_t begin;
+        uint64_t end;
+        /**< The colouring strategy the event belongs to */
+        uint32_t strategyId;
+        /**< An event specific value, e.g. the iteration of a working package or the number of colours */
+        uint64_t value;
+    };
+
+    /**
+     * Ring buffer of the events of one thread. Only the owning thread records events, so recording needs no
+     * synchronization. If the buffer is full, the oldest events are overwritten.
+     */
+    class TraceBuffer {
+    public:
+        TraceBuffer(size_t capacity,
+                    uint32_t processId,
+                    uint32_t threadId,
+                    std::string threadName)
+                : events(capacity), processId(processId), threadId(threadId), threadName(std::move(threadName)) {}
+
+        void record(const TraceEvent &event) {
+            size_t n = recorded.load(std::memory_order_relaxed);
+            events[n % events.size()] = event;
+            recorded.store(n + 1, std::memory_order_release);
+        }
+
+    private:
+        friend class Tracer;
+
+        std::vector<TraceEvent> events;
+        std::atomic<size_t> recorded{0};
+        uint32_t processId;
+        uint32_t threadId;
+        std::string threadName;
+    };
+
+    /**
+     * Collects the events of all threads of a run and writes them in the Chrome trace event format,
+     * which can be opened with chrome://tracing or Perfetto.
+     */
+    class Tracer {
+    public:
+        /**
+         * @param capacity the number of events kept per thread
+         */
+        explicit Tracer(size_t capacity)
+                : capacity(capacity), start(std::chrono::steady_clock::now()) {}
+
+        /**
+         * @return the nanoseconds since the creation of the tracer
+         */
+        uint64_t now() const {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count());
+        }
+
+        /**
+         * @return a new process id, used to separate concurrently running searches (e.g. graph components)
+         */
+        uint32_t newProcess() {
+            return nextProcessId.fetch_add(1);
+        }
+
+        /**
+         * Thread-safe. The buffer stays valid until the tracer is destroyed.
+         * @return a new buffer for the given thread
+         */
+        TraceBuffer *createBuffer(uint32_t processId,
+                                  uint32_t threadId,
+                                  const std::string &threadName);
+
+        /**
+         * Writes all recorded events. Must not be called while events are being recorded.
+         * @param filename the target file
+         * @return 0 on success, 1 otherwise
+         */
+        int write(const std::string &filename) const;
+
+    private:
+        const size_t capacity;
+        const std::chrono::steady_clock::time_point start;
+        std::atomic<uint32_t> nextProcessId{0};
+        std::mutex buffersMutex;
+        std::vector<std::unique_ptr<TraceBuffer>> buffers;
+    };
+
+    /**
+     * Records the time between its construction and destruction as an event, if a buffer is given
+     */
+    class TraceScope {
+    public:
+        TraceScope(const Tracer *tracer,
+                   TraceBuffer *buffer,
+                   const char *name,
+                   uint32_t strategyId = 0,
+                   uint64_t value = 0)
+                : tracer(tracer),
+                  buffer(buffer),
+                  event{name, buffer != nullptr ? tracer->now() : 0, 0, strategyId, value} {}
+
+        ~TraceScope() {
+            if (buffer != nullptr) {
+                event.end = tracer->now();
+                buffer->record(event);
+            }
+        }
+
+    private:
+        const Tracer *tracer;
+        TraceBuffer *buffer;
+        TraceEvent event;
+    };
+}
@@ -0,0 +1,92 @@
+#include "verification.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace graph_colouring {
+
+    /**< The minimal number of edges a thread has to check */
+    static const EdgeID MIN_EDGES_PER_THREAD = 1 << 16;
+
+    /**
+     * Analyzes the nodes first, ..., last - 1
+     */
+    static void analyzeRange(const graph_access &G,
+                             const Colouring &s,
+                             const NodeID first,
+                             const NodeID last,
+                             ColouringStats &stats) {
+        for (NodeID n = first; n < last; n++) {
+            const Color color = s[n];
+            if (color == UNCOLORED) {
+                stats.uncolouredNodes++;
+                continue;
+            }
+            if (color >= stats.classSizes.size()) {
+                stats.classSizes.resize(color + 1, 0);
+            }
+            stats.classSizes[color]++;
+
+            //Branch-free inner loop, so the compiler can vectorize the colour comparisons
+            size_t conflicts = 0;
+            for (EdgeID e = G.get_first_edge(n), end = G.get_first_invalid_edge(n); e < end; e++) {
+                conflicts += s[G.getEdgeTarget(e)] == color;
+            }
+            stats.conflictingEdges += conflicts;
+            stats.conflictingNodes += conflicts > 0;
+        }
+    }
+
+    ColouringStats analyzeColouring(const graph_access &G,
+                                    const Colouring &s,
+                                    size_t threadCount) {
+        assert(s.size() == G.number_of_nodes());
+        const NodeID nodes = G.number_of_nodes();
+        const EdgeID edges = G.number_of_edges();
+        threadCount = std::max<size_t>(1, std::min<size_t>(threadCount, 1 + edges / MIN_EDGES_PER_THREAD));
+
+        std::vector<ColouringStats> localStats(threadCount);
+        std::vector<NodeID> rangeStart(threadCount + 1, nodes);
+        rangeStart[0] = 0;
+        //Every range starts at the first node whose edges begin after its share of the edges
+        NodeID n = 0;
+        for (size_t t = 1; t < threadCount; t++) {
+            const EdgeID target = edges / threadCount * t;
+            while (n < nodes && G.get_first_edge(n) < target) {
+                n++;
+            }
+            rangeStart[t] = n;
+        }
+
+        std::vector<std::thread> threads;
+        for (size_t t = 1; t < threadCount; t++) {
+            threads.emplace_back(analyzeRange, std::cref(G), std::cref(s), rangeStart[t], rangeStart[t + 1],
+                                 std::ref(localStats[t]));
+        }
+        analyzeRange(G, s, rangeStart[0], rangeStart[1], localStats[0]);
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        ColouringStats stats = std::move(localStats[0]);
+        for (size_t t = 1; t < threadCount; t++) {
+            auto &local = localStats[t];
+            stats.conflictingEdges += local.conflictingEdges;
+            stats.conflictingNodes += local.conflictingNodes;
+            stats.uncolouredNodes += local.uncolouredNodes;
+            if (local.classSizes.size() > stats.classSizes.size()) {
+                stats.classSizes.resize(local.classSizes.size(), 0);
+            }
+            for (size_t c = 0; c < local.classSizes.size(); c++) {
+                stats.classSizes[c] += local.classSizes[c];
+            }
+        }
+        //Every conflicting edge has been seen from both endpoints
+        stats.conflictingEdges /= 2;
+        for (auto size : stats.classSizes) {
+            stats.k += size > 0;
+            stats.squaredClassSizes += static_cast<int64_t>(size) * size;
+        }
+        return stats;
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "graph_colouring.h"
+
+#include <thread>
+
+namespace graph_colouring {
+
+    /**
+     * Summary of a (possibly partial) colouring, computed by analyzeColouring
+     */
+    struct ColouringStats {
+        /**< The number of edges whose endpoints have the same colour. Uncoloured nodes never conflict. */
+        size_t conflictingEdges = 0;
+        /**< The number of coloured nodes having a neighbour with the same colour */
+        size_t conflictingNodes = 0;
+        /**< The number of nodes without a colour */
+        size_t uncolouredNodes = 0;
+        /**< The number of distinct colours */
+        ColorCount k = 0;
+        /**< classSizes[c] = the number of nodes with colour c (the size is the largest colour + 1) */
+        std::vector<NodeID> classSizes;
+        /**< The sum of the squared colour class sizes */
+        int64_t squaredClassSizes = 0;
+
+        /**
+         * @return true if the colouring is complete and has no conflicts
+         */
+        bool isValid() const {
+            return conflictingEdges == 0 && uncolouredNodes == 0;
+        }
+    };
+
+    /**
+     * Computes all statistics of a colouring in a single pass over the graph.
+     * The nodes are split into ranges of roughly equal edge count, one per thread.
+     * @param G the target graph
+     * @param s the colouring of graph \p G
+     * @param threadCount the maximal number of used threads (small graphs are checked by the calling thread)
+     * @return the statistics of \p s
+     */
+    ColouringStats analyzeColouring(const graph_access &G,
+                                    const Colouring &s,
+                                    size_t threadCount = std::thread::hardware_concurrency());
+}
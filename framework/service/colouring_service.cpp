@@ -0,0 +1,574 @@
+#include "colouring_service.h"
+#include "colouring/hca.h"
+#include "colouring/init/dsatur.h"
+#include "colouring/verification.h"
+#include "data_structure/io/graph_cache.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+
+using namespace graph_colouring;
+
+namespace {
+    /**< Larger payloads are rejected */
+    const size_t MAX_PAYLOAD = size_t(1) << 30;
+    /**< Longer request lines are rejected */
+    const size_t MAX_REQUEST_LINE = size_t(1) << 12;
+    /**< Longer message lines are rejected by the client (a colouring line has up to 11 characters per node) */
+    const size_t MAX_MESSAGE_LINE = size_t(1) << 30;
+
+    /**
+     * Buffered reading and complete writing of a stream socket
+     */
+    class Connection {
+    public:
+        explicit Connection(int fd) : fd(fd) {}
+
+        ~Connection() {
+            close(fd);
+        }
+
+        /**
+         * Reads the next line without the trailing newline
+         * @param maxLength the maximum number of buffered bytes without a newline
+         * @return false on end of stream, errors or overlong lines
+         */
+        bool readLine(std::string &line, const size_t maxLength) {
+            while (true) {
+                auto end = buffer.find('\n', position);
+                if (end != std::string::npos) {
+                    if (end - position > maxLength) {
+                        return false;
+                    }
+                    line.assign(buffer, position, end - position);
+                    position = end + 1;
+                    return true;
+                }
+                if (buffer.size() - position > maxLength || !fill()) {
+                    return false;
+                }
+            }
+        }
+
+        /**
+         * Reads exactly \p size bytes
+         */
+        bool readBytes(std::string &data, const size_t size) {
+            while (buffer.size() - position < size) {
+                if (!fill()) {
+                    return false;
+                }
+            }
+            data.assign(buffer, position, size);
+            position += size;
+            return true;
+        }
+
+        bool write(const std::string &data) {
+            size_t written = 0;
+            while (written < data.size()) {
+                auto n = send(fd, data.data() + written, data.size() - written, MSG_NOSIGNAL);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    return false;
+                }
+                written += size_t(n);
+            }
+            return true;
+        }
+
+    private:
+        bool fill() {
+            if (position > 0) {
+                buffer.erase(0, position);
+                position = 0;
+            }
+            char chunk[1 << 16];
+            while (true) {
+                auto n = recv(fd, chunk, sizeof(chunk), 0);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    return false;
+                }
+                buffer.append(chunk, size_t(n));
+                return true;
+            }
+        }
+
+        int fd;
+        std::string buffer;
+        size_t position = 0;
+    };
+
+    bool socketAddress(const std::string &socketPath, sockaddr_un &address) {
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+            std::cerr << "Invalid socket path " << socketPath << std::endl;
+            return false;
+        }
+        std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+        return true;
+    }
+
+    std::string formatRequest(const ServiceRequest &request) {
+        std::ostringstream out;
+        out.precision(17);
+        out << "COLOUR\n"
+            << "algorithm " << request.algorithm << "\n"
+            << "format " << request.format << "\n"
+            << "graph " << request.graphId << "\n"
+            << "k " << request.k << "\n"
+            << "population " << request.populationSize << "\n"
+            << "iterations " << request.maxItr << "\n"
+            << "L " << request.L << "\n"
+            << "A " << request.A << "\n"
+            << "alpha " << request.alpha << "\n"
+            << "threads " << request.threadCount << "\n"
+            << "seed " << request.seed << "\n"
+            << "deadline " << request.deadline << "\n"
+            << "payload " << request.payload.size() << "\n";
+        return out.str() + request.payload;
+    }
+
+    bool readRequest(Connection &connection, ServiceRequest &request, std::string &error) {
+        std::string line;
+        if (!connection.readLine(line, MAX_REQUEST_LINE) || line != "COLOUR") {
+            error = "expected COLOUR";
+            return false;
+        }
+        while (connection.readLine(line, MAX_REQUEST_LINE)) {
+            std::istringstream in(line);
+            std::string key;
+            in >> key;
+            bool ok = true;
+            if (key == "payload") {
+                size_t size = 0;
+                if (!(in >> size) || size > MAX_PAYLOAD) {
+                    error = "invalid payload size";
+                    return false;
+                }
+                if (!connection.readBytes(request.payload, size)) {
+                    error = "truncated payload";
+                    return false;
+                }
+                return true;
+            } else if (key == "algorithm") {
+                ok = bool(in >> request.algorithm);
+            } else if (key == "format") {
+                ok = bool(in >> request.format);
+            } else if (key == "graph") {
+                ok = bool(in >> request.graphId);
+            } else if (key == "k") {
+                ok = bool(in >> request.k);
+            } else if (key == "population") {
+                ok = bool(in >> request.populationSize);
+            } else if (key == "iterations") {
+                ok = bool(in >> request.maxItr);
+            } else if (key == "L") {
+                ok = bool(in >> request.L);
+            } else if (key == "A") {
+                ok = bool(in >> request.A);
+            } else if (key == "alpha") {
+                ok = bool(in >> request.alpha);
+            } else if (key == "threads") {
+                ok = bool(in >> request.threadCount);
+            } else if (key == "seed") {
+                ok = bool(in >> request.seed);
+            } else if (key == "deadline") {
+                ok = bool(in >> request.deadline);
+            } else {
+                ok = false;
+            }
+            if (!ok) {
+                error = "invalid request line: " + line;
+                return false;
+            }
+        }
+        error = "missing payload";
+        return false;
+    }
+
+    std::string formatMessage(const ServiceMessage &message) {
+        std::ostringstream out;
+        out << message.type;
+        if (message.type == "GRAPH") {
+            out << " " << message.graphId << " " << message.nodes << " " << message.edges << "\n";
+        } else if (message.type == "ERROR") {
+            out << " " << message.error << "\n";
+        } else if (message.type == "COLOURING") {
+            out << " " << message.k << " " << message.milliseconds << " " << message.s.size() << "\n";
+            for (size_t n = 0; n < message.s.size(); n++) {
+                out << (n > 0 ? " " : "") << message.s[n];
+            }
+            out << "\n";
+        } else {
+            out << " " << message.k << " " << message.milliseconds << "\n";
+        }
+        return out.str();
+    }
+
+    bool readMessage(Connection &connection, ServiceMessage &message) {
+        std::string line;
+        if (!connection.readLine(line, MAX_MESSAGE_LINE)) {
+            return false;
+        }
+        std::istringstream in(line);
+        in >> message.type;
+        if (message.type == "GRAPH") {
+            return bool(in >> message.graphId >> message.nodes >> message.edges);
+        } else if (message.type == "ERROR") {
+            std::getline(in >> std::ws, message.error);
+            return true;
+        } else if (message.type == "COLOURING") {
+            size_t nodes = 0;
+            if (!(in >> message.k >> message.milliseconds >> nodes) || !connection.readLine(line, MAX_MESSAGE_LINE)) {
+                return false;
+            }
+            std::istringstream colours(line);
+            message.s.resize(nodes);
+            for (auto &c : message.s) {
+                if (!(colours >> c)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        return bool(in >> message.k >> message.milliseconds);
+    }
+}
+
+ColouringService::ColouringService(const size_t threadCount, const size_t maxGraphs, const size_t maxConnections)
+        : threadCount(std::max<size_t>(1, threadCount)),
+          maxGraphs(std::max<size_t>(1, maxGraphs)),
+          maxConnections(std::max<size_t>(1, maxConnections)),
+          pool(threadCount),
+          stopping(false) {}
+
+ColouringService::~ColouringService() {
+    stop();
+    std::unique_lock<std::mutex> lock(connectionMutex);
+    connectionsFinished.wait(lock, [this] { return activeConnections == 0; });
+    if (listenFd >= 0) {
+        close(listenFd);
+        unlink(socketPath.c_str());
+    }
+}
+
+int ColouringService::listen(const std::string &socketPath) {
+    sockaddr_un address;
+    if (!socketAddress(socketPath, address)) {
+        return 1;
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << "Error creating socket: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    unlink(socketPath.c_str());
+    if (bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || ::listen(fd, 64) != 0) {
+        std::cerr << "Error listening on " << socketPath << ": " << std::strerror(errno) << std::endl;
+        close(fd);
+        return 1;
+    }
+    this->socketPath = socketPath;
+    listenFd = fd;
+    return 0;
+}
+
+void ColouringService::serve() {
+    while (!stopping) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            //stop shuts the socket down, which lets accept fail
+            break;
+        }
+        if (stopping) {
+            close(fd);
+            break;
+        }
+        {
+            std::lock_guard<std::mutex> guard(connectionMutex);
+            if (activeConnections == maxConnections) {
+                //The socket buffer of a new connection always has room for this message
+                ServiceMessage busy;
+                busy.type = "ERROR";
+                busy.error = "too many connections";
+                Connection(fd).write(formatMessage(busy));
+                continue;
+            }
+            activeConnections++;
+        }
+        std::thread([this, fd] {
+            handleConnection(fd);
+            std::lock_guard<std::mutex> guard(connectionMutex);
+            if (--activeConnections == 0) {
+                connectionsFinished.notify_all();
+            }
+        }).detach();
+    }
+}
+
+void ColouringService::stop() {
+    stopping = true;
+    if (listenFd >= 0) {
+        shutdown(listenFd, SHUT_RDWR);
+    }
+}
+
+size_t ColouringService::cachedGraphs() {
+    std::lock_guard<std::mutex> guard(graphMutex);
+    return graphs.size();
+}
+
+std::shared_ptr<const graph_access> ColouringService::loadGraph(const ServiceRequest &request,
+                                                                uint64_t &graphId,
+                                                                std::string &error) {
+    if (request.payload.empty()) {
+        std::lock_guard<std::mutex> guard(graphMutex);
+        auto cached = graphs.find(request.graphId);
+        if (cached == graphs.end()) {
+            error = "unknown graph " + std::to_string(request.graphId);
+            return nullptr;
+        }
+        graphId = request.graphId;
+        return cached->second;
+    }
+
+    graphId = std::hash<std::string>()(request.format + "\n" + request.payload);
+    std::shared_ptr<const graph_access> G;
+    if (request.format == "file") {
+        //the cache detects modified files
+        G = files.get(request.payload);
+        if (!G) {
+            error = "cannot read " + request.payload;
+            return nullptr;
+        }
+    } else {
+        {
+            std::lock_guard<std::mutex> guard(graphMutex);
+            auto cached = graphs.find(graphId);
+            if (cached != graphs.end()) {
+                return cached->second;
+            }
+        }
+        auto parsed = std::make_shared<graph_access>();
+        int status = 1;
+        if (request.format == "metis") {
+            status = graph_io::parseGraphMetis(*parsed, request.payload);
+        } else if (request.format == "csr") {
+            status = graph_io::parseGraphBinary(*parsed, request.payload);
+        } else {
+            error = "unknown format " + request.format;
+            return nullptr;
+        }
+        if (status != 0) {
+            error = "malformed " + request.format + " graph";
+            return nullptr;
+        }
+        G = parsed;
+    }
+
+    std::lock_guard<std::mutex> guard(graphMutex);
+    if (graphs.find(graphId) == graphs.end()) {
+        graphOrder.push_back(graphId);
+    }
+    graphs[graphId] = G;
+    if (request.format == "file") {
+        graphFiles[graphId] = request.payload;
+    }
+    while (graphs.size() > maxGraphs) {
+        auto evicted = graphOrder.front();
+        graphOrder.pop_front();
+        graphs.erase(evicted);
+        auto file = graphFiles.find(evicted);
+        if (file != graphFiles.end()) {
+            files.release(file->second);
+            graphFiles.erase(file);
+        }
+    }
+    return G;
+}
+
+void ColouringService::handleConnection(const int fd) {
+    typedef std::chrono::steady_clock Clock;
+    auto start = Clock::now();
+    auto elapsed = [start] {
+        return size_t(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count());
+    };
+
+    Connection connection(fd);
+    std::mutex writeMutex;
+    auto send = [&](const ServiceMessage &message) {
+        std::lock_guard<std::mutex> guard(writeMutex);
+        return connection.write(formatMessage(message));
+    };
+    auto fail = [&](const std::string &error) {
+        ServiceMessage message;
+        message.type = "ERROR";
+        message.error = error;
+        send(message);
+    };
+
+    ServiceRequest request;
+    std::string error;
+    if (!readRequest(connection, request, error)) {
+        fail(error);
+        return;
+    }
+    if (request.algorithm != "hca" && request.algorithm != "batch" && request.algorithm != "dsatur") {
+        fail("unknown algorithm " + request.algorithm);
+        return;
+    }
+    if (request.A == 0 || request.maxItr == 0) {
+        fail("A and iterations have to be positive");
+        return;
+    }
+    uint64_t graphId;
+    auto G = loadGraph(request, graphId, error);
+    if (!G) {
+        fail(error);
+        return;
+    }
+    ServiceMessage message;
+    message.type = "GRAPH";
+    message.graphId = graphId;
+    message.nodes = G->number_of_nodes();
+    message.edges = G->number_of_edges() / 2;
+    if (!send(message)) {
+        return;
+    }
+
+    ServiceMessage best;
+    best.type = "COLOURING";
+    if (request.algorithm == "batch") {
+        BatchParameters parameters;
+        parameters.L = request.L;
+        parameters.A = request.A;
+        parameters.alpha = request.alpha;
+        parameters.seed = request.seed;
+        best.s = pool.colourBatch({G.get()}, parameters)[0].s;
+    } else {
+        best.s = dsaturColouring(*G);
+    }
+    best.k = colorCount(best.s);
+    best.milliseconds = elapsed();
+    if (!send(best)) {
+        return;
+    }
+
+    if (request.algorithm == "hca" && best.k > 1) {
+        auto threads = request.threadCount > 0 ? request.threadCount : threadCount;
+        std::vector<std::unique_ptr<ColouringStrategy>> strategies;
+        strategies.push_back(hcaStrategy(request.L, request.A, request.alpha));
+
+        ColouringAlgorithm algorithm;
+        algorithm.timeLimit = std::chrono::milliseconds(request.deadline);
+        algorithm.seed = request.seed;
+        //The streamed colourings have to colour the whole graph
+        algorithm.cliqueTimeLimit = std::chrono::milliseconds(0);
+        algorithm.reduceGraph = false;
+        algorithm.decomposeComponents = false;
+        //There is nobody left to receive the results if the client is gone
+        bool disconnected = false;
+        algorithm.onColouringFound = [&](ColorCount k, size_t) {
+            ServiceMessage found;
+            found.type = "FOUND";
+            found.k = k;
+            found.milliseconds = elapsed();
+            if (!send(found)) {
+                disconnected = true;
+                algorithm.stop();
+            }
+        };
+        algorithm.onValidColouring = [&](const Colouring &s, size_t) {
+            if (disconnected || colorCount(s) >= best.k || !analyzeColouring(*G, s).isValid()) {
+                return;
+            }
+            best.s = s;
+            best.k = colorCount(s);
+            best.milliseconds = elapsed();
+            if (!send(best)) {
+                disconnected = true;
+                algorithm.stop();
+            }
+        };
+        try {
+            auto result = algorithm.perform(strategies,
+                                            *G,
+                                            request.k > 0 ? request.k : best.k,
+                                            std::max(request.populationSize, 4 * threads),
+                                            request.maxItr,
+                                            threads)[0];
+            if (disconnected) {
+                return;
+            }
+            if (result.isValid && analyzeColouring(*G, result.s).isValid() && colorCount(result.s) < best.k) {
+                best.s = result.s;
+                best.k = colorCount(result.s);
+                best.milliseconds = elapsed();
+                if (!send(best)) {
+                    return;
+                }
+            }
+        } catch (const char *exception) {
+            fail(exception);
+            return;
+        }
+    }
+
+    ServiceMessage done;
+    done.type = "DONE";
+    done.k = best.k;
+    done.milliseconds = elapsed();
+    send(done);
+}
+
+int graph_colouring::requestColouring(const std::string &socketPath,
+                                      const ServiceRequest &request,
+                                      const std::function<void(const ServiceMessage &)> &onMessage) {
+    sockaddr_un address;
+    if (!socketAddress(socketPath, address)) {
+        return 1;
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << "Error creating socket: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    Connection connection(fd);
+    if (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+        std::cerr << "Error connecting to " << socketPath << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    if (!connection.write(formatRequest(request))) {
+        std::cerr << "Error sending the request to " << socketPath << std::endl;
+        return 1;
+    }
+    ServiceMessage message;
+    while (readMessage(connection, message)) {
+        onMessage(message);
+        if (message.type == "DONE") {
+            return 0;
+        }
+        if (message.type == "ERROR") {
+            return 1;
+        }
+        message = ServiceMessage();
+    }
+    std::cerr << "The connection to " << socketPath << " was closed unexpectedly" << std::endl;
+    return 1;
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "colouring/batch.h"
+#include "data_structure/io/graph_cache.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace graph_colouring {
+
+    /**
+     * A colouring request sent to a ColouringService.
+     *
+     * Wire format (client to service): the line "COLOUR", followed by "<key> <value>" lines for every parameter
+     * (algorithm, format, graph, k, population, iterations, L, A, alpha, threads, seed, deadline) and finally the
+     * line "payload <bytes>" followed by the raw payload. Request lines longer than 4 KiB are rejected.
+     */
+    struct ServiceRequest {
+        /**< "hca" (genetic algorithm started with a DSatur colouring), "batch" (see colourSmallGraph) or "dsatur" */
+        std::string algorithm = "hca";
+        /**< "metis" or "csr" (see graph_io::writeGraphBinary) for an inline graph, "file" if the payload is the
+         * path of a graph file readable by the service */
+        std::string format = "metis";
+        /**< The graph data, a file name or empty if graphId is set */
+        std::string payload;
+        /**< The id of a graph the service has already loaded (reported by a GRAPH message). Ignored if the
+         * payload is not empty. */
+        uint64_t graphId = 0;
+        /**< The initial k of hca, 0 = the number of colours of the DSatur colouring */
+        ColorCount k = 0;
+        /**< hca only: the population size, raised to at least 4 * threads */
+        size_t populationSize = 0;
+        /**< hca only: the maximum number of iterations */
+        size_t maxItr = 1000;
+        /**< Number of tabu search iterations */
+        size_t L = 100;
+        /**< Tuning parameter for the tabu list length */
+        size_t A = 2;
+        /**< Tuning parameter for the tabu list length */
+        double alpha = 0.6;
+        /**< hca only: the number of worker threads, 0 = the thread count of the service */
+        size_t threadCount = 0;
+        /**< Seeds the random number generators */
+        uint64_t seed = 0;
+        /**< hca only: if positive, the search stops after this many milliseconds */
+        size_t deadline = 0;
+    };
+
+    /**
+     * A message sent by the service while processing a request. Every message starts with a line
+     * "<type> <arguments>"; COLOURING messages are followed by a line with the colour of every node.
+     *   GRAPH <id> <nodes> <edges>           the graph has been loaded (the id can be used in later requests)
+     *   FOUND <k> <milliseconds>             the search found a colouring with k colours
+     *   COLOURING <k> <milliseconds> <nodes> a complete valid colouring which is better than all previous ones,
+     *                                        sent as soon as the search reports it
+     *   DONE <k> <milliseconds>              the request is finished, k is the size of the last COLOURING
+     *   ERROR <message>                      the request failed
+     */
+    struct ServiceMessage {
+        std::string type;
+        /**< The number of colours (FOUND, COLOURING, DONE) */
+        ColorCount k = 0;
+        /**< The time since the service received the request */
+        size_t milliseconds = 0;
+        /**< The graph id (GRAPH) */
+        uint64_t graphId = 0;
+        /**< The graph size (GRAPH) */
+        NodeID nodes = 0;
+        EdgeID edges = 0;
+        /**< The colouring (COLOURING) */
+        Colouring s;
+        /**< The error message (ERROR) */
+        std::string error;
+    };
+
+    /**
+     * Long running colouring service listening on a Unix domain socket. Every connection carries one request,
+     * which is processed by a thread of its own. Loaded graphs are kept by their payload (or file) hash and the
+     * worker pool of the batch requests is started only once. The worker threads of an hca request are started
+     * by ColouringAlgorithm::perform for this request, since their shared state belongs to the search; starting
+     * them takes microseconds compared with the search itself. If the client disconnects, the search is stopped.
+     */
+    class ColouringService {
+    public:
+        /**
+         * @param threadCount the size of the batch pool and the default thread count of hca requests
+         * @param maxGraphs the number of loaded graphs kept by the service (the oldest are released first)
+         * @param maxConnections the number of concurrently processed connections; further clients receive an ERROR
+         */
+        explicit ColouringService(size_t threadCount = std::thread::hardware_concurrency(),
+                                  size_t maxGraphs = 64,
+                                  size_t maxConnections = 64);
+
+        /**
+         * Stops the service and waits for the running requests
+         */
+        ~ColouringService();
+
+        ColouringService(const ColouringService &) = delete;
+
+        ColouringService &operator=(const ColouringService &) = delete;
+
+        /**
+         * Creates the socket (an existing socket file is replaced)
+         * @param socketPath the file system path of the socket
+         * @return 0 on success, 1 otherwise
+         */
+        int listen(const std::string &socketPath);
+
+        /**
+         * Accepts connections until stop is called
+         */
+        void serve();
+
+        /**
+         * Makes serve return. Thread-safe and async-signal-safe.
+         */
+        void stop();
+
+        /**
+         * @return the number of graphs kept by the service
+         */
+        size_t cachedGraphs();
+
+    private:
+        void handleConnection(int fd);
+
+        std::shared_ptr<const graph_access> loadGraph(const ServiceRequest &request,
+                                                      uint64_t &graphId,
+                                                      std::string &error);
+
+        size_t threadCount;
+        size_t maxGraphs;
+        size_t maxConnections;
+        ColouringPool pool;
+        /**< Parses the graphs of "file" requests. Graphs released by the service are released here as well. */
+        graph_io::graph_cache files;
+        std::mutex graphMutex;
+        std::unordered_map<uint64_t, std::shared_ptr<const graph_access>> graphs;
+        /**< The file names of the kept graphs loaded from files */
+        std::unordered_map<uint64_t, std::string> graphFiles;
+        /**< The ids of the kept graphs, oldest first */
+        std::deque<uint64_t> graphOrder;
+        std::string socketPath;
+        int listenFd = -1;
+        std::atomic<bool> stopping;
+        std::mutex connectionMutex;
+        std::condition_variable connectionsFinished;
+        /**< The number of connections whose (detached) thread has not finished yet */
+        size_t activeConnections = 0;
+    };
+
+    /**
+     * Sends a request to a ColouringService and receives its messages until DONE or ERROR
+     * @param socketPath the socket of the service
+     * @param request the request
+     * @param onMessage called for every received message
+     * @return 0 if the request was finished with DONE, 1 otherwise
+     */
+    int requestColouring(const std::string &socketPath,
+                         const ServiceRequest &request,
+                         const std::function<void(const ServiceMessage &)> &onMessage);
+}
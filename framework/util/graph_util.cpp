@@ -1,68 +1,454 @@
 #include "util/graph_util.h"
 
+#include "data_structure/io/graph_io.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <queue>
 #include <sstream>
 #include <iomanip>
+#include <limits>
 
-std::string graph_util::toGraphvizStrig(const graph_access &G,
-                                        const std::string &label) {
-    std::stringstream ss;
-    ss << "graph " << label << " {\n";
-    std::vector<bool> covered_edges(G.number_of_nodes() * G.number_of_nodes(), false);
-    for (NodeID n = 0; n < G.number_of_nodes(); ++n) {
-        for (auto neighbour : G.neighbours(n)) {
-            if (!covered_edges[n * G.number_of_nodes() + neighbour]) {
-                ss << "    " << n << " -- " << neighbour << ";\n";
-                covered_edges[n * G.number_of_nodes() + neighbour] = true;
-                covered_edges[neighbour * G.number_of_nodes() + n] = true;
+namespace {
+    /**
+     * Output buffer which is either flushed into a file in large blocks or appended to a string
+     */
+    class OutputBuffer {
+    public:
+        explicit OutputBuffer(FILE *file) : file(file), target(nullptr) {
+            buffer.reserve(CAPACITY);
+        }
+
+        explicit OutputBuffer(std::string &target) : file(nullptr), target(&target) {
+            buffer.reserve(CAPACITY);
+        }
+
+        OutputBuffer &operator<<(const char *s) {
+            return append(s, std::strlen(s));
+        }
+
+        OutputBuffer &operator<<(const std::string &s) {
+            return append(s.data(), s.size());
+        }
+
+        OutputBuffer &operator<<(uint64_t value) {
+            char digits[20];
+            size_t length = 0;
+            do {
+                digits[sizeof(digits) - ++length] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value > 0);
+            return append(digits + sizeof(digits) - length, length);
+        }
+
+        /**
+         * @return false if writing the file failed
+         */
+        bool flush() {
+            if (file != nullptr) {
+                ok = ok && fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+            } else {
+                target->append(buffer.data(), buffer.size());
+            }
+            buffer.clear();
+            return ok;
+        }
+
+    private:
+        static const size_t CAPACITY = 1 << 20;
+
+        OutputBuffer &append(const char *s, const size_t length) {
+            buffer.insert(buffer.end(), s, s + length);
+            if (buffer.size() >= CAPACITY) {
+                flush();
+            }
+            return *this;
+        }
+
+        FILE *file;
+        std::string *target;
+        std::vector<char> buffer;
+        bool ok = true;
+    };
+
+    /**
+     * Deterministic node sample (splitmix64 of the node id and the seed)
+     */
+    bool sampled(const NodeID n, const graph_util::GraphvizOptions &options) {
+        if (options.sampleRate >= 1.0) {
+            return true;
+        }
+        uint64_t z = n + options.sampleSeed * 0x9e3779b97f4a7c15ULL + 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        z = z ^ (z >> 31);
+        return (z >> 11) * (1.0 / 9007199254740992.0) < options.sampleRate;
+    }
+
+    void writeGraphviz(OutputBuffer &out,
+                       const graph_access &G,
+                       const graph_colouring::Colouring &configuration,
+                       const graph_util::GraphvizOptions &options) {
+        const bool coloured = !configuration.empty();
+        std::vector<bool> shown(G.number_of_nodes(), false);
+        for (NodeID n = 0; n < G.number_of_nodes(); ++n) {
+            shown[n] = sampled(n, options)
+                       && (options.colourClass == UNCOLORED
+                           || (coloured && configuration[n] == options.colourClass));
+        }
+
+        //The hue of a colour only depends on the number of colours, so sparse colourings stay in range
+        std::vector<std::string> colors;
+        if (coloured) {
+            Color maxColor = 0;
+            for (auto color : configuration) {
+                if (color != UNCOLORED) {
+                    maxColor = std::max(maxColor, color);
+                }
+            }
+            graph_colouring::ColorCount k = graph_colouring::colorCount(configuration);
+            colors.resize(k > 0 ? std::max<size_t>(k, maxColor + 1) : 0);
+            double hueFactor = 1.0 / k;
+            for (size_t i = 0; i < colors.size(); i++) {
+                std::stringstream colorSS;
+                colorSS << std::setprecision(3) << '"' << i * hueFactor / 1.0 << " " << 0.5 << " " << 0.5 << '"';
+                colors[i] = colorSS.str();
+            }
+        }
+
+        auto writeNode = [&](const NodeID n, const char *indentation) {
+            out << indentation << n;
+            if (configuration[n] != UNCOLORED) {
+                out << " [penwidth=3 color=" << colors[configuration[n]] << "]";
+            }
+            out << ";\n";
+        };
+
+        out << "graph " << options.label << " {\n";
+        if (coloured && options.partitioned) {
+            //Counting sort of the shown nodes by colour
+            std::vector<NodeID> classStart(colors.size() + 1, 0);
+            for (NodeID n = 0; n < configuration.size(); n++) {
+                if (shown[n] && configuration[n] != UNCOLORED) {
+                    classStart[configuration[n] + 1]++;
+                }
+            }
+            for (size_t i = 0; i < colors.size(); i++) {
+                classStart[i + 1] += classStart[i];
+            }
+            std::vector<NodeID> classNodes(classStart.back());
+            std::vector<NodeID> next(classStart.begin(), classStart.end() - 1);
+            for (NodeID n = 0; n < configuration.size(); n++) {
+                if (shown[n] && configuration[n] != UNCOLORED) {
+                    classNodes[next[configuration[n]]++] = n;
+                }
+            }
+            for (size_t i = 0; i < colors.size(); i++) {
+                if (classStart[i] == classStart[i + 1]) {
+                    continue;
+                }
+                out << "    subgraph cluster_" << i << " {\n";
+                for (NodeID j = classStart[i]; j < classStart[i + 1]; j++) {
+                    writeNode(classNodes[j], "        ");
+                }
+                out << "    }\n";
+            }
+            for (NodeID n = 0; n < configuration.size(); n++) {
+                if (shown[n] && configuration[n] == UNCOLORED) {
+                    writeNode(n, "    ");
+                }
+            }
+        } else if (coloured) {
+            for (NodeID n = 0; n < configuration.size(); n++) {
+                if (shown[n]) {
+                    writeNode(n, "    ");
+                }
             }
         }
+
+        for (NodeID n = 0; n < G.number_of_nodes(); ++n) {
+            if (!shown[n]) {
+                continue;
+            }
+            for (auto neighbour : G.neighbours(n)) {
+                if (n <= neighbour && shown[neighbour]) {
+                    out << "    " << n << " -- " << neighbour << ";\n";
+                }
+            }
+        }
+        out << "}\n";
     }
-    ss << "}\n";
-    return ss.str();
+}
+
+std::string graph_util::toGraphvizStrig(const graph_access &G,
+                                        const std::string &label) {
+    GraphvizOptions options;
+    options.label = label;
+    std::string result;
+    OutputBuffer out(result);
+    writeGraphviz(out, G, graph_colouring::Colouring(), options);
+    out.flush();
+    return result;
 }
 
 std::string graph_util::toGraphvizStrig(const graph_access &G,
                                         const graph_colouring::Colouring &configuration,
                                         const bool partitioned,
                                         const std::string &label) {
-    std::stringstream ss;
-
-    std::vector<std::string> colors;
-    colors.resize(graph_colouring::colorCount(configuration));
-    double hueFactor = 1.0 / colors.size();
-    for (int i = 0; i < colors.size(); i++) {
-        std::stringstream colorSS;
-        colorSS << std::setprecision(3) << '"' << i * hueFactor / 1.0 << " " << 0.5 << " " << 0.5 << '"';
-        colors[i] = colorSS.str();
-    }
-
-    ss << "graph " << label << " {\n";
-    if (partitioned) {
-        for (int i = 0; i < colors.size(); i++) {
-            ss << "    subgraph cluster_" << i << " {\n";
-            for (size_t n = 0; n < configuration.size(); n++) {
-                if (configuration[n] == i) {
-                    ss << "        " << n << " [penwidth=3 color=" << colors[configuration[n]] << "];\n";
-                }
+    GraphvizOptions options;
+    options.label = label;
+    options.partitioned = partitioned;
+    std::string result;
+    OutputBuffer out(result);
+    writeGraphviz(out, G, configuration, options);
+    out.flush();
+    return result;
+}
+
+int graph_util::writeGraphviz(const std::string &filename,
+                              const graph_access &G,
+                              const graph_colouring::Colouring &configuration,
+                              const GraphvizOptions &options) {
+    FILE *file = fopen(filename.c_str(), "w");
+    if (file == nullptr) {
+        std::cerr << "Error opening " << filename << std::endl;
+        return 1;
+    }
+    OutputBuffer out(file);
+    ::writeGraphviz(out, G, configuration, options);
+    bool ok = out.flush();
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        std::cerr << "Error writing " << filename << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+void graph_util::copyGraph(const graph_access &G,
+                           graph_access &copy) {
+    copy.start_construction(G.number_of_nodes(), G.number_of_edges());
+    for (NodeID n = 0; n < G.number_of_nodes(); n++) {
+        NodeID node = copy.new_node();
+        for (auto neighbour : G.neighbours(n)) {
+            copy.new_edge(node, neighbour);
+        }
+    }
+    copy.finish_construction();
+}
+
+void graph_util::inducedSubgraph(const graph_access &G,
+                                 const std::vector<NodeID> &nodes,
+                                 graph_access &subgraph) {
+    const NodeID invalid = std::numeric_limits<NodeID>::max();
+    std::vector<NodeID> newId(G.number_of_nodes(), invalid);
+    for (NodeID i = 0; i < nodes.size(); i++) {
+        newId[nodes[i]] = i;
+    }
+
+    EdgeID edgeCount = 0;
+    for (auto n : nodes) {
+        for (auto neighbour : G.neighbours(n)) {
+            edgeCount += newId[neighbour] != invalid;
+        }
+    }
+
+    subgraph.start_construction(static_cast<NodeID>(nodes.size()), edgeCount);
+    for (auto n : nodes) {
+        NodeID node = subgraph.new_node();
+        for (auto neighbour : G.neighbours(n)) {
+            if (newId[neighbour] != invalid) {
+                subgraph.new_edge(node, newId[neighbour]);
             }
-            ss << "    }\n";
         }
-    } else {
-        for (size_t n = 0; n < configuration.size(); n++) {
-            ss << "    " << n << " [penwidth=3 color=" << colors[configuration[n]] << "];\n";
+    }
+    subgraph.finish_construction();
+}
+
+/**
+ * Follows the parent pointers to the root of \p node and halves the path on the way
+ */
+static NodeID findRoot(std::atomic<NodeID> *parent,
+                       NodeID node) {
+    NodeID p = parent[node].load(std::memory_order_relaxed);
+    while (p != node) {
+        NodeID grandparent = parent[p].load(std::memory_order_relaxed);
+        if (grandparent != p) {
+            parent[node].compare_exchange_weak(p, grandparent, std::memory_order_relaxed);
+        }
+        node = p;
+        p = parent[node].load(std::memory_order_relaxed);
+    }
+    return node;
+}
+
+NodeID graph_util::connectedComponents(const graph_access &G,
+                                       std::vector<NodeID> &component,
+                                       size_t threadCount) {
+    const NodeID n = G.number_of_nodes();
+    threadCount = std::max<size_t>(1, std::min<size_t>(threadCount, n));
+    std::unique_ptr<std::atomic<NodeID>[]> parent(new std::atomic<NodeID>[n]);
+    for (NodeID node = 0; node < n; node++) {
+        parent[node] = node;
+    }
+
+    //Roots are always linked to smaller roots, so every root is the smallest node of its component
+    auto unite = [&parent](NodeID u, NodeID v) {
+        while (true) {
+            u = findRoot(parent.get(), u);
+            v = findRoot(parent.get(), v);
+            if (u == v) {
+                return;
+            }
+            if (u < v) {
+                std::swap(u, v);
+            }
+            NodeID expected = u;
+            if (parent[u].compare_exchange_strong(expected, v, std::memory_order_relaxed)) {
+                return;
+            }
         }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t threadId = 0; threadId < threadCount; threadId++) {
+        workers.emplace_back([&, threadId]() {
+            for (NodeID u = threadId; u < n; u += threadCount) {
+                for (auto v : G.neighbours(u)) {
+                    if (u < v) {
+                        unite(u, v);
+                    }
+                }
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
     }
 
-    std::vector<bool> covered_edges(G.number_of_nodes() * G.number_of_nodes(), false);
-    for (NodeID n = 0; n < G.number_of_nodes(); ++n) {
+    component.resize(n);
+    NodeID componentCount = 0;
+    for (NodeID node = 0; node < n; node++) {
+        NodeID root = findRoot(parent.get(), node);
+        component[node] = root == node ? componentCount++ : component[root];
+    }
+    return componentCount;
+}
+
+/**
+ * Appends the nodes of the component of \p start to \p order in breadth first order
+ * @param byDegree if true, the neighbours of a node are visited by increasing degree
+ */
+static void breadthFirstOrder(const graph_access &G,
+                              const NodeID start,
+                              const bool byDegree,
+                              std::vector<bool> &visited,
+                              std::vector<NodeID> &order) {
+    std::vector<NodeID> neighbours;
+    size_t head = order.size();
+    visited[start] = true;
+    order.push_back(start);
+    while (head < order.size()) {
+        NodeID n = order[head++];
+        neighbours.clear();
         for (auto neighbour : G.neighbours(n)) {
-            if (!covered_edges[n * G.number_of_nodes() + neighbour]) {
-                ss << "    " << n << " -- " << neighbour << ";\n";
-                covered_edges[n * G.number_of_nodes() + neighbour] = true;
-                covered_edges[neighbour * G.number_of_nodes() + n] = true;
+            if (!visited[neighbour]) {
+                visited[neighbour] = true;
+                neighbours.push_back(neighbour);
             }
         }
+        if (byDegree) {
+            std::stable_sort(neighbours.begin(), neighbours.end(), [&G](NodeID a, NodeID b) {
+                return G.getNodeDegree(a) < G.getNodeDegree(b);
+            });
+        }
+        order.insert(order.end(), neighbours.begin(), neighbours.end());
+    }
+}
+
+std::vector<NodeID> graph_util::nodeOrdering(const graph_access &G,
+                                             const NodeOrdering ordering) {
+    const NodeID n = G.number_of_nodes();
+    std::vector<NodeID> byDegree(n);
+    for (NodeID node = 0; node < n; node++) {
+        byDegree[node] = node;
     }
-    ss << "}\n";
-    return ss.str();
-}
\ No newline at end of file
+    std::stable_sort(byDegree.begin(), byDegree.end(), [&G](NodeID a, NodeID b) {
+        return G.getNodeDegree(a) > G.getNodeDegree(b);
+    });
+    if (ordering == NodeOrdering::DEGREE_DESCENDING) {
+        return byDegree;
+    }
+
+    std::vector<NodeID> order;
+    order.reserve(n);
+    std::vector<bool> visited(n, false);
+    if (ordering == NodeOrdering::BREADTH_FIRST) {
+        for (auto start : byDegree) {
+            if (!visited[start]) {
+                breadthFirstOrder(G, start, false, visited, order);
+            }
+        }
+        return order;
+    }
+
+    for (auto start = byDegree.rbegin(); start != byDegree.rend(); ++start) {
+        if (!visited[*start]) {
+            breadthFirstOrder(G, *start, true, visited, order);
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+void graph_util::relabel(const graph_access &G,
+                         const std::vector<NodeID> &order,
+                         graph_access &relabeled) {
+    assert(order.size() == G.number_of_nodes());
+    std::vector<NodeID> newId(G.number_of_nodes());
+    for (NodeID i = 0; i < order.size(); i++) {
+        newId[order[i]] = i;
+    }
+
+    relabeled.start_construction(G.number_of_nodes(), G.number_of_edges());
+    std::vector<NodeID> neighbours;
+    for (auto n : order) {
+        NodeID node = relabeled.new_node();
+        neighbours.clear();
+        for (auto neighbour : G.neighbours(n)) {
+            neighbours.push_back(newId[neighbour]);
+        }
+        std::sort(neighbours.begin(), neighbours.end());
+        for (auto neighbour : neighbours) {
+            relabeled.new_edge(node, neighbour);
+        }
+    }
+    relabeled.finish_construction();
+}
+
+graph_colouring::Colouring graph_util::restoreOrder(const graph_colouring::Colouring &s,
+                                                    const std::vector<NodeID> &order) {
+    assert(s.size() == order.size());
+    graph_colouring::Colouring original(s.size());
+    for (NodeID i = 0; i < order.size(); i++) {
+        original[order[i]] = s[i];
+    }
+    return original;
+}
+
+int graph_util::readGraphReordered(graph_access &G,
+                                   const std::string &filename,
+                                   const NodeOrdering ordering,
+                                   std::vector<NodeID> &order) {
+    graph_access original;
+    if (graph_io::readGraphWeighted(original, filename) != 0) {
+        return 1;
+    }
+    order = nodeOrdering(original, ordering);
+    relabel(original, order, G);
+    return 0;
+}
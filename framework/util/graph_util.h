@@ -23,4 +23,122 @@ namespace graph_util {
                                 const graph_colouring::Colouring &configuration,
                                 bool partitioned = false,
                                 const std::string &label = "G");
+
+    /**
+     * Options of writeGraphviz
+     */
+    struct GraphvizOptions {
+        /**< A label used for the graph visualization */
+        std::string label = "G";
+        /**< If true, the nodes are grouped in one cluster per colour class */
+        bool partitioned = false;
+        /**< The probability that a node is shown. Edges are shown if both endpoints are shown. */
+        double sampleRate = 1.0;
+        /**< Seed of the node sample. The same seed always selects the same nodes. */
+        uint64_t sampleSeed = 0;
+        /**< If set, only the nodes of this colour class (and the conflicts between them) are shown */
+        Color colourClass = UNCOLORED;
+    };
+
+    /**
+     * Writes the graph in GraphViz format without materializing the output in memory.
+     * Every undirected edge {u, v} is written once, when visiting u < v. The output of the full graph
+     * is identical to toGraphvizStrig.
+     * @param filename the target file
+     * @param G the target graph
+     * @param configuration the colouring of the graph \p G (empty = no colours). Uncoloured nodes are drawn without colour.
+     * @param options the visualization options
+     * @return 0 on success, 1 otherwise
+     */
+    int writeGraphviz(const std::string &filename,
+                      const graph_access &G,
+                      const graph_colouring::Colouring &configuration = graph_colouring::Colouring(),
+                      const GraphvizOptions &options = GraphvizOptions());
+
+    /**
+     * Copies a graph. The arrays of the copy are allocated and first written by the calling thread, so that
+     * they are placed on the NUMA node of the calling thread.
+     * @param G the target graph
+     * @param copy an empty graph that will store the copy
+     */
+    void copyGraph(const graph_access &G,
+                   graph_access &copy);
+
+    /**
+     * Builds the subgraph induced by the given nodes.
+     * The node nodes[i] of \p G becomes the node i of \p subgraph.
+     * @param G the target graph
+     * @param nodes the distinct nodes of the subgraph
+     * @param subgraph an empty graph that will store the induced subgraph
+     */
+    void inducedSubgraph(const graph_access &G,
+                         const std::vector<NodeID> &nodes,
+                         graph_access &subgraph);
+
+    /**
+     * Computes the connected components of a graph. The edges are distributed among \p threadCount threads
+     * which merge the components of their endpoints in a shared lock-free union-find structure.
+     * @param G the target graph
+     * @param component component[n] = the component of the node n. The components are numbered in the order
+     * of their smallest nodes.
+     * @param threadCount the number of used threads
+     * @return the number of connected components
+     */
+    NodeID connectedComponents(const graph_access &G,
+                               std::vector<NodeID> &component,
+                               size_t threadCount = std::thread::hardware_concurrency());
+
+    /**
+     * Node orderings which improve the locality of the neighbour lists
+     */
+    enum class NodeOrdering {
+        /**< Nodes sorted by decreasing degree */
+        DEGREE_DESCENDING,
+        /**< Reverse Cuthill-McKee: breadth first search starting at a node of minimal degree and visiting
+         * the neighbours by increasing degree. The resulting order is reversed. */
+        REVERSE_CUTHILL_MCKEE,
+        /**< Breadth first search starting at a node of maximal degree */
+        BREADTH_FIRST
+    };
+
+    /**
+     * @param G the target graph
+     * @param ordering the requested ordering
+     * @return the permutation order, where order[i] = the node placed at position i
+     */
+    std::vector<NodeID> nodeOrdering(const graph_access &G,
+                                     NodeOrdering ordering);
+
+    /**
+     * Relabels the nodes of a graph. The node order[i] of \p G becomes the node i of \p relabeled.
+     * Every neighbour list of \p relabeled is sorted by the new node ids.
+     * @param G the target graph
+     * @param order a permutation of the nodes of \p G
+     * @param relabeled an empty graph that will store the relabeled graph
+     */
+    void relabel(const graph_access &G,
+                 const std::vector<NodeID> &order,
+                 graph_access &relabeled);
+
+    /**
+     * Maps a colouring of a relabeled graph back to the original graph
+     * @param s the colouring of the relabeled graph
+     * @param order the permutation passed to relabel
+     * @return the corresponding colouring of the original graph
+     */
+    graph_colouring::Colouring restoreOrder(const graph_colouring::Colouring &s,
+                                            const std::vector<NodeID> &order);
+
+    /**
+     * Reads a graph (see graph_io::readGraphWeighted) and relabels its nodes
+     * @param G an empty graph that will store the relabeled graph
+     * @param filename the graph file
+     * @param ordering the applied node ordering
+     * @param order the applied permutation (see relabel)
+     * @return 0 on success, 1 otherwise
+     */
+    int readGraphReordered(graph_access &G,
+                           const std::string &filename,
+                           NodeOrdering ordering,
+                           std::vector<NodeID> &order);
 }
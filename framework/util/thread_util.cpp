@@ -0,0 +1,104 @@
+#include "thread_util.h"
+
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace thread_util {
+
+    std::vector<int> availableCpus() {
+        std::vector<int> cpus;
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+                if (CPU_ISSET(cpu, &set)) {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+#endif
+        if (cpus.empty()) {
+            for (int cpu = 0; cpu < static_cast<int>(std::thread::hardware_concurrency()); cpu++) {
+                cpus.push_back(cpu);
+            }
+        }
+        return cpus;
+    }
+
+    int pinCurrentThread(const int cpu) {
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0 ? 0 : 1;
+#else
+        return 1;
+#endif
+    }
+
+    std::vector<int> parseCpuList(const std::string &list) {
+        std::vector<int> cpus;
+        size_t pos = 0;
+        while (pos < list.size() && list[pos] != '\n') {
+            size_t end = list.find_first_of(",\n", pos);
+            if (end == std::string::npos) {
+                end = list.size();
+            }
+            std::string range = list.substr(pos, end - pos);
+            size_t dash = range.find('-');
+            try {
+                int first = std::stoi(range.substr(0, dash));
+                int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                if (first < 0 || last < first) {
+                    return {};
+                }
+                for (int cpu = first; cpu <= last; cpu++) {
+                    cpus.push_back(cpu);
+                }
+            } catch (const std::exception &) {
+                return {};
+            }
+            pos = end < list.size() && list[end] == ',' ? end + 1 : end;
+        }
+        return cpus;
+    }
+
+    std::vector<std::vector<int>> numaNodes() {
+        auto available = availableCpus();
+        std::vector<std::vector<int>> nodes;
+        std::vector<int> assigned;
+        //Node ids may have gaps, stop after a few missing nodes
+        for (int node = 0, missing = 0; missing < 8; node++) {
+            std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            std::string list;
+            if (!in || !std::getline(in, list)) {
+                missing++;
+                continue;
+            }
+            missing = 0;
+            std::vector<int> cpus;
+            for (int cpu : parseCpuList(list)) {
+                if (std::binary_search(available.begin(), available.end(), cpu)) {
+                    cpus.push_back(cpu);
+                    assigned.push_back(cpu);
+                }
+            }
+            if (!cpus.empty()) {
+                nodes.push_back(cpus);
+            }
+        }
+        std::sort(assigned.begin(), assigned.end());
+        if (assigned != available) {
+            //Unknown or inconsistent topology
+            nodes.assign(1, available);
+        }
+        return nodes;
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace thread_util {
+    /**
+     * @return the ids of the CPUs the calling thread is allowed to run on (usually inherited from the process),
+     * in ascending order
+     */
+    std::vector<int> availableCpus();
+
+    /**
+     * Restricts the calling thread to a single CPU
+     * @param cpu the target CPU id
+     * @return 0 on success, 1 otherwise (e.g. on systems without thread affinities)
+     */
+    int pinCurrentThread(int cpu);
+
+    /**
+     * Parses a CPU list of the Linux sysfs, e.g. "0-3,8,10-11"
+     * @return the listed CPU ids, or an empty vector if the list is malformed
+     */
+    std::vector<int> parseCpuList(const std::string &list);
+
+    /**
+     * Reads the NUMA topology from /sys/devices/system/node.
+     * Only the CPUs the calling thread may run on are listed and nodes without such CPUs are omitted.
+     * @return nodes[i] = the CPUs of the i-th NUMA node, or a single node with all available CPUs if
+     * the topology is unknown
+     */
+    std::vector<std::vector<int>> numaNodes();
+}
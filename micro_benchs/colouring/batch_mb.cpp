@@ -0,0 +1,66 @@
+#include "benchmark/benchmark.h"
+
+#include "data_structure/io/graph_cache.h"
+#include "colouring/batch.h"
+
+#include <algorithm>
+
+using namespace graph_colouring;
+
+/**
+ * Colours the small graphs of input/xrlf (n.density.i.graph, density 1, 5 or 9) up to the given number of nodes as a single batch
+ * on a pool which is started once per benchmark run.
+ * Arguments: threadCount, maximum number of nodes, tabu search iterations
+ * Reports the coloured graphs per second.
+ */
+void BM_batch(benchmark::State &state) {
+    auto threadCount = size_t(state.range(0));
+    auto maxNodes = int(state.range(1));
+
+    std::vector<std::shared_ptr<const graph_access>> graphs;
+    std::vector<const graph_access *> batch;
+    for (int n = 10; n <= maxNodes; n += 10) {
+        for (int density : {1, 5, 9}) {
+            for (int i = 1; i <= 10; i++) {
+                auto file = "../../input/xrlf/" + std::to_string(n) + "." + std::to_string(density) + "."
+                            + std::to_string(i) + ".graph";
+                auto G = graph_io::graph_cache::global().get(file);
+                if (!G) {
+                    state.SkipWithError("could not read the graphs");
+                    return;
+                }
+                graphs.push_back(G);
+                batch.push_back(G.get());
+            }
+        }
+    }
+
+    BatchParameters parameters;
+    parameters.L = size_t(state.range(2));
+    ColouringPool pool(threadCount);
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(pool.colourBatch(batch, parameters));
+    }
+    state.counters["graphs_per_s"] = benchmark::Counter(double(batch.size()) * state.iterations(),
+                                                        benchmark::Counter::kIsRate);
+}
+
+/**
+ * Thread counts 1, 2, 4, ... and all hardware threads
+ */
+static void BatchArguments(benchmark::internal::Benchmark *b) {
+    const int maxNodes = 200;
+    const int L = 1000;
+    const int maxThreads = std::max(1, int(std::thread::hardware_concurrency()));
+    for (int threads = 1; threads < maxThreads; threads *= 2) {
+        b->Args({threads, maxNodes, L});
+    }
+    b->Args({maxThreads, maxNodes, L});
+}
+
+BENCHMARK(BM_batch)
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime()
+        ->Apply(BatchArguments);
+
+BENCHMARK_MAIN()
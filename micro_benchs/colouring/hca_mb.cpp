@@ -1,18 +1,52 @@
 #include "benchmark/benchmark.h"
 
-#include "data_structure/io/graph_io.h"
+#include "data_structure/io/graph_cache.h"
 #include "util/graph_util.h"
 #include "colouring/hca.h"
+#include "../util/perf_counters.h"
 
 using namespace graph_colouring;
 
+/**
+ * Wraps every operator of \p strategy such that its hardware counters are added to the corresponding region
+ */
+static void measureOperators(ColouringStrategy &strategy,
+                             perf_counters::Region &init,
+                             perf_counters::Region &crossover,
+                             perf_counters::Region &ls) {
+    for (auto &op : strategy.initOperators) {
+        op = [op, &init](const graph_access &graph, const ColorCount colors, std::mt19937 &generator) {
+            return init.measure([&] { return op(graph, colors, generator); });
+        };
+    }
+    for (auto &op : strategy.crossoverOperators) {
+        op = [op, &crossover](const Colouring &s1, const Colouring &s2, const graph_access &graph,
+                              std::mt19937 &generator) {
+            return crossover.measure([&] { return op(s1, s2, graph, generator); });
+        };
+    }
+    for (auto &op : strategy.lsOperators) {
+        op = [op, &ls](const Colouring &s, const graph_access &graph, std::mt19937 &generator) {
+            return ls.measure([&] { return op(s, graph, generator); });
+        };
+    }
+}
 
+/**
+ * @param operatorCounters if true, the counters of every operator call are read as well. This adds two read()
+ * calls per operator call to the measured time, so the timings of these runs are not comparable to the others.
+ */
 void BM_hca(benchmark::State &state,
-            const char *graphFile) {
+            const char *graphFile,
+            const bool operatorCounters) {
+    auto G = graph_io::graph_cache::global().get(graphFile);
+    if (!G) {
+        state.SkipWithError("could not read the graph");
+        return;
+    }
+    perf_counters::checkAvailable();
+    perf_counters::Region init("init"), crossover("crossover"), ls("ls"), total("total");
     while (state.KeepRunning()) {
-        graph_access G;
-        graph_io::readGraphWeighted(G, graphFile);
-
         auto threadCount = size_t(state.range(0));
         auto min_k = ColorCount(state.range(1));
         auto k = ColorCount(state.range(2));
@@ -21,7 +55,15 @@ void BM_hca(benchmark::State &state,
         auto L = size_t(state.range(5));
         auto A = size_t(state.range(6));
         const double alpha = double(state.range(7)) / 10;
-        auto result = hybridColouringAlgorithm(G, k, population_size, maxItr, L, A, alpha, threadCount);
+        std::vector<std::unique_ptr<ColouringStrategy>> strategies;
+        strategies.push_back(hcaStrategy(L, A, alpha));
+        if (operatorCounters) {
+            measureOperators(*strategies[0], init, crossover, ls);
+        }
+        //Inherited counters include the worker threads started by perform
+        perf_counters::Counters counters(true);
+        auto result = ColouringAlgorithm().perform(strategies, *G, k, population_size, maxItr, threadCount)[0];
+        total.add(counters.read());
         auto result_k = graph_colouring::colorCount(result.s);
         if (result_k > min_k) {
             std::cerr << "Should return a colouring with k = "
@@ -31,19 +73,31 @@ void BM_hca(benchmark::State &state,
             std::cerr << "Should return a valid colouring\n";
         }
     }
+    if (operatorCounters) {
+        init.report(state);
+        crossover.report(state);
+        ls.report(state);
+    }
+    total.report(state);
 }
 
 BENCHMARK_CAPTURE(BM_hca, miles250,
-                  "../../input/miles250-sorted.graph")
+                  "../../input/miles250-sorted.graph", false)
         ->Unit(benchmark::kMillisecond)
         ->Args({1, 8, 9, 100,  20, 5, 2, 6})
         ->Args({2, 8, 9, 100,  20, 5, 2, 6})
         ->Args({1, 8, 9, 1000, 20, 5, 2, 6})
         ->Args({2, 8, 9, 1000, 20, 5, 2, 6});
 
+BENCHMARK_CAPTURE(BM_hca, miles250_operator_counters,
+                  "../../input/miles250-sorted.graph", true)
+        ->Unit(benchmark::kMillisecond)
+        ->Args({1, 8, 9, 100,  20, 5, 2, 6})
+        ->Args({2, 8, 9, 100,  20, 5, 2, 6});
+
 /*
 BENCHMARK_CAPTURE(BM_hca, DSJC250_5,
-                  "../../input/DSJC250.5-sorted.graph")
+                  "../../input/DSJC250.5-sorted.graph", false)
         ->Unit(benchmark::kMillisecond)
         ->Args({1, 28, 30, 100, 20, 250, 2, 6})
         ->Args({2, 28, 30, 100, 20, 250, 2, 6});
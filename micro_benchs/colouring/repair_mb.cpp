@@ -0,0 +1,69 @@
+#include "benchmark/benchmark.h"
+
+#include "data_structure/io/graph_cache.h"
+#include "colouring/init/dsatur.h"
+#include "colouring/repair.h"
+
+#include <random>
+
+using namespace graph_colouring;
+
+/**
+ * Inserts a batch of random edges into a DSatur coloured graph and removes them again, repairing the colouring
+ * after both updates.
+ * Arguments: number of edges per batch
+ */
+void BM_repair(benchmark::State &state, const char *graphFile) {
+    auto G = graph_io::graph_cache::global().get(graphFile);
+    if (!G) {
+        state.SkipWithError("could not read the graph");
+        return;
+    }
+    dynamic_graph_access D(*G);
+    IncrementalColouring colouring(D, dsaturColouring(*G));
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<NodeID> node(0, G->number_of_nodes() - 1);
+
+    size_t conflictingNodes = 0;
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        std::vector<std::pair<NodeID, NodeID>> edges;
+        for (int64_t i = 0; i < state.range(0); i++) {
+            NodeID u = node(generator);
+            NodeID v = node(generator);
+            if (u != v && !D.has_edge(u, v)) {
+                edges.emplace_back(u, v);
+            }
+        }
+        state.ResumeTiming();
+        conflictingNodes += colouring.insertEdges(edges).conflictingNodes;
+        colouring.removeEdges(edges);
+    }
+    state.counters["k"] = colouring.colours();
+    state.counters["conflicting_nodes"] = benchmark::Counter(double(conflictingNodes),
+                                                             benchmark::Counter::kAvgIterations);
+}
+
+/**
+ * Reference: colouring the graph from scratch with DSatur
+ */
+void BM_recolour(benchmark::State &state, const char *graphFile) {
+    auto G = graph_io::graph_cache::global().get(graphFile);
+    if (!G) {
+        state.SkipWithError("could not read the graph");
+        return;
+    }
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(dsaturColouring(*G));
+    }
+}
+
+BENCHMARK_CAPTURE(BM_repair, DSJC1000_5, "../../input/DSJC1000.5-sorted.graph")
+        ->Unit(benchmark::kMicrosecond)
+        ->Arg(10)
+        ->Arg(100)
+        ->Arg(1000);
+BENCHMARK_CAPTURE(BM_recolour, DSJC1000_5, "../../input/DSJC1000.5-sorted.graph")
+        ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN()
@@ -0,0 +1,109 @@
+#include "benchmark/benchmark.h"
+
+#include "data_structure/io/graph_cache.h"
+#include "colouring/hca.h"
+
+#include <algorithm>
+#include <map>
+
+using namespace graph_colouring;
+
+/**
+ * The population size of every run. perform requires at least four colourings per worker thread and
+ * the population has to be the same for every thread count to keep the amount of work fixed.
+ */
+static size_t populationSize() {
+    return 4 * std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+/**
+ * Runs perform with a fixed number of generations (crossover + local search applications) and k below the
+ * chromatic number, so that no k-restart shortens the run. The generations are distributed over the lanes of the
+ * mating population (populationSize / 2 lanes with maxItr generations each).
+ * Arguments: threadCount, placement (0 = unpinned, 1 = pinned, 2 = NUMA aware with graph replicas),
+ * total generations, tabu search iterations
+ * Reports the generations per second and the parallel efficiency relative to the single threaded run of the same
+ * mode. With COLOURING_INSTRUMENTATION, the time spent in queue operations and in parent selection (including the
+ * retries of locked parents) is reported as well, summed over all worker threads.
+ */
+void BM_scaling(benchmark::State &state,
+                const char *graphFile,
+                const ColorCount k) {
+    //Single threaded throughput per mode, used to compute the parallel efficiency
+    static std::map<std::pair<std::string, int>, double> baseline;
+
+    auto G = graph_io::graph_cache::global().get(graphFile);
+    if (!G) {
+        state.SkipWithError("could not read the graph");
+        return;
+    }
+    auto threadCount = size_t(state.range(0));
+    auto placement = int(state.range(1));
+    auto generations = size_t(state.range(2));
+    auto L = size_t(state.range(3));
+    auto matingPopulationSize = populationSize() / 2;
+    auto maxItr = std::max<size_t>(1, (generations + matingPopulationSize - 1) / matingPopulationSize);
+    generations = maxItr * matingPopulationSize;
+
+    std::vector<std::unique_ptr<ColouringStrategy>> strategies;
+    strategies.push_back(hcaStrategy(L, 2, 0.6));
+
+    InstrumentationStats stats;
+    double seconds = 0;
+    while (state.KeepRunning()) {
+        ColouringAlgorithm algorithm;
+        algorithm.cliqueTimeLimit = std::chrono::milliseconds(0);
+        algorithm.reduceGraph = false;
+        algorithm.pinThreads = placement == 1;
+        algorithm.numaAware = placement == 2;
+        algorithm.replicateGraph = placement == 2;
+        auto start = std::chrono::steady_clock::now();
+        auto result = algorithm.perform(strategies, *G, k, populationSize(), maxItr, threadCount)[0];
+        seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (result.isValid) {
+            state.SkipWithError("k has to be below the chromatic number to keep the amount of work fixed");
+        }
+        stats += result.stats;
+    }
+
+    double generationsPerSecond = generations * state.iterations() / seconds;
+    state.counters["generations_per_s"] = generationsPerSecond;
+    auto key = std::make_pair(std::string(graphFile), placement);
+    if (threadCount == 1) {
+        baseline[key] = generationsPerSecond;
+    }
+    if (baseline.count(key) > 0) {
+        state.counters["efficiency"] = generationsPerSecond / (threadCount * baseline[key]);
+    }
+    if (stats.enabled) {
+        state.counters["queue_s"] = benchmark::Counter(stats.seconds[REGION_QUEUE],
+                                                       benchmark::Counter::kAvgIterations);
+        state.counters["choose_parent_s"] = benchmark::Counter(stats.seconds[REGION_CHOOSE_PARENT],
+                                                               benchmark::Counter::kAvgIterations);
+        state.counters["parent_retries"] = benchmark::Counter(double(stats.parentRetries),
+                                                              benchmark::Counter::kAvgIterations);
+    }
+}
+
+/**
+ * Thread counts 1, 2, 4, ... and all hardware threads, each with every placement
+ */
+static void ScalingArguments(benchmark::internal::Benchmark *b) {
+    const int generations = 10000;
+    const int L = 20;
+    const int maxThreads = std::max(1, int(std::thread::hardware_concurrency()));
+    for (int placement = 0; placement <= 2; placement++) {
+        for (int threads = 1; threads < maxThreads; threads *= 2) {
+            b->Args({threads, placement, generations, L});
+        }
+        b->Args({maxThreads, placement, generations, L});
+    }
+}
+
+BENCHMARK_CAPTURE(BM_scaling, miles250,
+                  "../../input/miles250-sorted.graph", 7)
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime()
+        ->Apply(ScalingArguments);
+
+BENCHMARK_MAIN()
@@ -1,24 +1,31 @@
 #include "benchmark/benchmark.h"
 
-#include "data_structure/io/graph_io.h"
+#include "data_structure/io/graph_cache.h"
 #include "util/graph_util.h"
 #include "colouring/hca.h"
 #include "colouring/init/xrlf.h"
+#include "../util/perf_counters.h"
 
 using namespace graph_colouring;
 
 auto BM_xrlf_optimal_colouring = [](benchmark::State &state, const char* _dc) {
     int iterations = 0;
+    std::string graphFile = "../../input/xrlf/" + std::to_string(state.range(0)) + "." + std::to_string(state.range(2)) + "." + std::to_string(state.range(1)) + ".graph";
+    auto cached = graph_io::graph_cache::global().get(graphFile);
+    if (!cached) {
+        state.SkipWithError("could not read the graph");
+        return;
+    }
+    const graph_access &G = *cached;
+    perf_counters::checkAvailable();
+    perf_counters::Region exact("exact");
     while (state.KeepRunning()) {
-        graph_access G;
-        std::string graphFile = "../../input/xrlf/" + std::to_string(state.range(0)) + "." + std::to_string(state.range(2)) + "." + std::to_string(state.range(1)) + ".graph";
         std::cout << "Graph File: " << graphFile << std::endl;
-        graph_io::readGraphWeighted(G, graphFile);
         xrlf::Subgraph s(G);        
         Colouring c(G.number_of_nodes(), std::numeric_limits<NodeID>::max());
         Color offset = 0;
         auto start = std::chrono::high_resolution_clock::now();
-        xrlf::findOptimalColouring(s, c, offset);
+        exact.measure([&] { xrlf::findOptimalColouring(s, c, offset); });
         auto end   = std::chrono::high_resolution_clock::now();
         auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(
         end - start);
@@ -32,21 +39,28 @@ auto BM_xrlf_optimal_colouring = [](benchmark::State &state, const char* _dc) {
         state.SetIterationTime(elapsed_seconds.count());
         std::cout << "Done" << std::endl;
     }
+    exact.report(state);
 };
 
 auto BM_xrlf_independent_set = [](benchmark::State &state, const char* _dc) {
     int iterations = 0;
+    std::string graphFile = "../../input/xrlf/" + std::to_string(state.range(0)) + "." + std::to_string(state.range(2)) + "." + std::to_string(state.range(1)) + ".graph";
+    auto cached = graph_io::graph_cache::global().get(graphFile);
+    if (!cached) {
+        state.SkipWithError("could not read the graph");
+        return;
+    }
+    const graph_access &G = *cached;
+    perf_counters::checkAvailable();
+    perf_counters::Region search("search");
     while (state.KeepRunning()) {
-        graph_access G;
-        std::string graphFile = "../../input/xrlf/" + std::to_string(state.range(0)) + "." + std::to_string(state.range(2)) + "." + std::to_string(state.range(1)) + ".graph";
         std::cout << "Graph File: " << graphFile << std::endl;
-        graph_io::readGraphWeighted(G, graphFile);
         xrlf::Subgraph s(G);        
         std::unordered_set<NodeID> C;
         xrlf::RandomAccessSet<NodeID> W(s.getNodes());
 
         auto start = std::chrono::high_resolution_clock::now();
-        std::unordered_set<NodeID> is = exhaustiveSearch(W, s, C);
+        std::unordered_set<NodeID> is = search.measure([&] { return exhaustiveSearch(W, s, C); });
         auto end   = std::chrono::high_resolution_clock::now();
         auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(
         end - start);
@@ -60,10 +74,19 @@ auto BM_xrlf_independent_set = [](benchmark::State &state, const char* _dc) {
         state.SetIterationTime(elapsed_seconds.count());
         std::cout << "Done" << std::endl;
     }
+    search.report(state);
 };
 
 auto BM_xrlf = [](benchmark::State &state,
             const char *graphFile) {
+    auto cached = graph_io::graph_cache::global().get(graphFile);
+    if (!cached) {
+        state.SkipWithError("could not read the graph");
+        return;
+    }
+    const graph_access &G = *cached;
+    perf_counters::checkAvailable();
+    perf_counters::Region init("xrlf");
     int iterations = 0;
     while (state.KeepRunning()) {
         xrlf::XRLFParameters parameters;
@@ -74,10 +97,8 @@ auto BM_xrlf = [](benchmark::State &state,
         parameters.MODE = xrlf::XRLFMode::IGNORE_COLORCOUNT;
         std::cout << graphFile << ": Exactlim: " << parameters.EXACTLIM << ", Trialnum: " << parameters.TRIALNUM << ", Setlim: " << parameters.SETLIM << ", Candnum: " << parameters.CANDNUM << std::endl; 
         
-        graph_access G;
-        graph_io::readGraphWeighted(G, graphFile);
         auto start = std::chrono::high_resolution_clock::now();
-        Colouring c = xrlf::initByXRLF(G, parameters);
+        Colouring c = init.measure([&] { return xrlf::initByXRLF(G, parameters); });
         auto end   = std::chrono::high_resolution_clock::now();
         auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(
         end - start);
@@ -99,6 +120,7 @@ auto BM_xrlf = [](benchmark::State &state,
     state.counters["TRIALNUM"] = state.range(1);
     state.counters["SETLIM"] = state.range(2);
     state.counters["CANDNUM"] = state.range(3);
+    init.report(state);
 };
 
 static void XRLFArgumentsTENPERCENT(benchmark::internal::Benchmark* b) {
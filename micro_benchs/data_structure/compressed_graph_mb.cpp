@@ -0,0 +1,65 @@
+#include "benchmark/benchmark.h"
+
+#include "data_structure/io/graph_io.h"
+#include "data_structure/compressed_graph.h"
+#include "colouring/graph_colouring.h"
+
+#include <random>
+
+using namespace graph_colouring;
+
+static Colouring randomColouring(const NodeID nodes, const ColorCount k) {
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<Color> colorDist(0, k - 1);
+    Colouring s(nodes);
+    for (auto &color : s) {
+        color = colorDist(generator);
+    }
+    return s;
+}
+
+template<typename Graph>
+static void scanNeighbours(benchmark::State &state, const Graph &G) {
+    auto s = randomColouring(G.number_of_nodes(), ColorCount(state.range(0)));
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(numberOfConflictingEdges(G, s));
+    }
+    state.SetItemsProcessed(state.iterations() * G.number_of_edges());
+}
+
+void BM_csr_scan(benchmark::State &state,
+                 const char *graphFile) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, graphFile);
+    state.counters["bytes"] = G.number_of_edges() * sizeof(NodeID) + (G.number_of_nodes() + 1) * sizeof(EdgeID);
+    scanNeighbours(state, G);
+}
+
+void BM_compressed_scan(benchmark::State &state,
+                        const char *graphFile) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, graphFile);
+    compressed_graph_access C(G);
+    state.counters["bytes"] = C.memory_usage();
+    scanNeighbours(state, C);
+}
+
+BENCHMARK_CAPTURE(BM_csr_scan, DSJC1000_1,
+                  "../../input/DSJC1000.1-sorted.graph")
+        ->Unit(benchmark::kMicrosecond)
+        ->Arg(20);
+BENCHMARK_CAPTURE(BM_compressed_scan, DSJC1000_1,
+                  "../../input/DSJC1000.1-sorted.graph")
+        ->Unit(benchmark::kMicrosecond)
+        ->Arg(20);
+
+BENCHMARK_CAPTURE(BM_csr_scan, cti,
+                  "../../input/cti.graph")
+        ->Unit(benchmark::kMicrosecond)
+        ->Arg(3);
+BENCHMARK_CAPTURE(BM_compressed_scan, cti,
+                  "../../input/cti.graph")
+        ->Unit(benchmark::kMicrosecond)
+        ->Arg(3);
+
+BENCHMARK_MAIN()
@@ -0,0 +1,292 @@
+/**
+ * Time-to-target benchmark suite for the hybrid colouring algorithm.
+ *
+ * Every graph of a directory (METIS .graph or DIMACS .col files) is loaded once and coloured with several seeds.
+ * For every run, the suite records the time until a colouring with at most the target number of colours has been
+ * found and the number of colours reached within the time budget. The median and interquartile range over all
+ * seeds are written as JSON. The time limit is checked between two operator applications, so a run exceeds it by
+ * up to one tabu search.
+ *
+ * Usage: dimacs_suite <directory> [--target <file name>=<k>]... [--seeds <n>] [--time-limit <ms>] [--threads <n>]
+ *                     [--population <n>] [--tabu-iterations <n>] [--output <file>]
+ */
+
+#include "data_structure/io/graph_cache.h"
+#include "colouring/hca.h"
+
+#include <dirent.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace graph_colouring;
+
+struct SuiteParameters {
+    std::string directory;
+    std::map<std::string, ColorCount> targets;
+    size_t seeds = 5;
+    std::chrono::milliseconds timeLimit = std::chrono::seconds(10);
+    size_t threadCount = std::thread::hardware_concurrency();
+    size_t populationSize = 0;
+    size_t tabuIterations = 5;
+    std::string output;
+};
+
+/**
+ * Result of a single run
+ */
+struct RunResult {
+    /**< The number of colours of the best colouring */
+    ColorCount k;
+    /**< Seconds until the target has been reached or a negative value */
+    double timeToTarget;
+    /**< Seconds of the whole run */
+    double time;
+};
+
+/**
+ * Median and interquartile range with linear interpolation
+ */
+struct Summary {
+    double median;
+    double q1;
+    double q3;
+};
+
+static Summary summarize(std::vector<double> values) {
+    if (values.empty()) {
+        return {NAN, NAN, NAN};
+    }
+    std::sort(values.begin(), values.end());
+    auto quantile = [&values](double q) {
+        double position = q * (values.size() - 1);
+        size_t lower = static_cast<size_t>(std::floor(position));
+        size_t upper = std::min(lower + 1, values.size() - 1);
+        return values[lower] + (position - lower) * (values[upper] - values[lower]);
+    };
+    return {quantile(0.5), quantile(0.25), quantile(0.75)};
+}
+
+static bool isGraphFile(const std::string &name) {
+    for (const std::string suffix : {".graph", ".col", ".col.gz", ".col.zst"}) {
+        if (name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @return the number of colours of a first fit colouring in node order, a valid start value for k
+ */
+static ColorCount greedyColourCount(const graph_access &G) {
+    Colouring s(G.number_of_nodes(), UNCOLORED);
+    std::vector<NodeID> usedBy;
+    ColorCount k = 0;
+    for (NodeID n = 0; n < G.number_of_nodes(); n++) {
+        usedBy.assign(k + 1, std::numeric_limits<NodeID>::max());
+        for (auto neighbour : G.neighbours(n)) {
+            if (s[neighbour] != UNCOLORED) {
+                usedBy[s[neighbour]] = n;
+            }
+        }
+        Color c = 0;
+        while (usedBy[c] == n) {
+            c++;
+        }
+        s[n] = c;
+        k = std::max<ColorCount>(k, c + 1);
+    }
+    return k;
+}
+
+static RunResult run(const graph_access &G,
+                     const ColorCount startK,
+                     const ColorCount target,
+                     const uint64_t seed,
+                     const SuiteParameters &parameters) {
+    std::vector<std::unique_ptr<ColouringStrategy>> strategies;
+    strategies.push_back(hcaStrategy(parameters.tabuIterations, 2, 0.6));
+
+    ColouringAlgorithm algorithm;
+    algorithm.timeLimit = parameters.timeLimit;
+    algorithm.seed = seed;
+    //The callback has to report colourings of the whole graph, and the budget is spent on the GA only
+    algorithm.cliqueTimeLimit = std::chrono::milliseconds(0);
+    algorithm.reduceGraph = false;
+    algorithm.decomposeComponents = false;
+
+    auto start = std::chrono::steady_clock::now();
+    double timeToTarget = -1;
+    algorithm.onColouringFound = [&](ColorCount k, size_t) {
+        if (k <= target && timeToTarget < 0) {
+            timeToTarget = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+    };
+    auto result = algorithm.perform(strategies,
+                                    G,
+                                    startK,
+                                    parameters.populationSize,
+                                    std::numeric_limits<size_t>::max(),
+                                    parameters.threadCount)[0];
+    double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ColorCount k = result.s.empty() || numberOfConflictingEdges(G, result.s) > 0 || !isFullyColoured(result.s)
+                   ? startK : colorCount(result.s);
+    if (k <= target && timeToTarget < 0) {
+        timeToTarget = time;
+    }
+    return {k, timeToTarget, time};
+}
+
+static void writeSummary(std::ostream &out, const char *name, const Summary &summary) {
+    out << "\"" << name << "\": ";
+    if (std::isnan(summary.median)) {
+        out << "null";
+    } else {
+        out << "{\"median\": " << summary.median << ", \"q1\": " << summary.q1 << ", \"q3\": " << summary.q3
+            << ", \"iqr\": " << summary.q3 - summary.q1 << "}";
+    }
+}
+
+static bool parseArguments(int argc, const char *argv[], SuiteParameters &parameters) {
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (argument == "--target" && hasValue) {
+            std::string target = argv[++i];
+            auto separator = target.rfind('=');
+            if (separator == std::string::npos) {
+                return false;
+            }
+            parameters.targets[target.substr(0, separator)] = std::stoul(target.substr(separator + 1));
+        } else if (argument == "--seeds" && hasValue) {
+            parameters.seeds = std::stoul(argv[++i]);
+        } else if (argument == "--time-limit" && hasValue) {
+            parameters.timeLimit = std::chrono::milliseconds(std::stoul(argv[++i]));
+        } else if (argument == "--threads" && hasValue) {
+            parameters.threadCount = std::stoul(argv[++i]);
+        } else if (argument == "--population" && hasValue) {
+            parameters.populationSize = std::stoul(argv[++i]);
+        } else if (argument == "--tabu-iterations" && hasValue) {
+            parameters.tabuIterations = std::stoul(argv[++i]);
+        } else if (argument == "--output" && hasValue) {
+            parameters.output = argv[++i];
+        } else if (parameters.directory.empty() && argument[0] != '-') {
+            parameters.directory = argument;
+        } else {
+            return false;
+        }
+    }
+    parameters.threadCount = std::max<size_t>(1, parameters.threadCount);
+    //perform requires at least four colourings per worker thread
+    parameters.populationSize = std::max(parameters.populationSize, 4 * parameters.threadCount);
+    return !parameters.directory.empty() && parameters.seeds > 0 && parameters.timeLimit.count() > 0;
+}
+
+int main(int argc, const char *argv[]) {
+    SuiteParameters parameters;
+    if (!parseArguments(argc, argv, parameters)) {
+        std::cerr << "Usage: " << argv[0] << " <directory> [--target <file name>=<k>]... [--seeds <n>]"
+                  << " [--time-limit <ms>] [--threads <n>] [--population <n>] [--tabu-iterations <n>]"
+                  << " [--output <file>]\n";
+        return 1;
+    }
+
+    std::vector<std::string> files;
+    DIR *dir = opendir(parameters.directory.c_str());
+    if (dir == nullptr) {
+        std::cerr << "Error opening " << parameters.directory << std::endl;
+        return 1;
+    }
+    while (dirent *entry = readdir(dir)) {
+        if (isGraphFile(entry->d_name)) {
+            files.push_back(entry->d_name);
+        }
+    }
+    closedir(dir);
+    std::sort(files.begin(), files.end());
+
+    //Preload every instance, so parsing is never part of a measurement
+    std::vector<std::shared_ptr<const graph_access>> graphs;
+    for (auto &file : files) {
+        graphs.push_back(graph_io::graph_cache::global().get(parameters.directory + "/" + file));
+        if (!graphs.back()) {
+            return 1;
+        }
+    }
+
+    std::ofstream outputFile;
+    if (!parameters.output.empty()) {
+        outputFile.open(parameters.output.c_str());
+        if (!outputFile) {
+            std::cerr << "Error opening " << parameters.output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream &out = parameters.output.empty() ? std::cout : outputFile;
+    out << std::setprecision(6);
+    out << "{\n  \"time_limit_ms\": " << parameters.timeLimit.count()
+        << ",\n  \"seeds\": " << parameters.seeds
+        << ",\n  \"threads\": " << parameters.threadCount
+        << ",\n  \"population\": " << parameters.populationSize
+        << ",\n  \"tabu_iterations\": " << parameters.tabuIterations
+        << ",\n  \"instances\": [";
+
+    for (size_t i = 0; i < files.size(); i++) {
+        const graph_access &G = *graphs[i];
+        const ColorCount startK = greedyColourCount(G);
+        auto target = parameters.targets.find(files[i]);
+        const ColorCount targetK = target != parameters.targets.end() ? target->second : 0;
+
+        std::vector<RunResult> results;
+        for (uint64_t seed = 1; seed <= parameters.seeds; seed++) {
+            results.push_back(run(G, startK, targetK, seed, parameters));
+            std::cerr << files[i] << " seed " << seed << ": k = " << results.back().k
+                      << " (" << results.back().time << " s)\n";
+        }
+
+        std::vector<double> colours, timesToTarget;
+        for (auto &result : results) {
+            colours.push_back(result.k);
+            if (result.timeToTarget >= 0) {
+                timesToTarget.push_back(result.timeToTarget);
+            }
+        }
+        out << (i > 0 ? "," : "") << "\n    {\"name\": \"" << files[i] << "\""
+            << ", \"nodes\": " << G.number_of_nodes()
+            << ", \"edges\": " << G.number_of_edges() / 2
+            << ", \"start_k\": " << startK
+            << ", \"target_k\": ";
+        if (targetK > 0) {
+            out << targetK;
+        } else {
+            out << "null";
+        }
+        out << ", \"target_reached\": " << timesToTarget.size() << ", ";
+        writeSummary(out, "time_to_target_s", summarize(timesToTarget));
+        out << ", ";
+        writeSummary(out, "colours_at_budget", summarize(colours));
+        out << ", \"runs\": [";
+        for (size_t j = 0; j < results.size(); j++) {
+            out << (j > 0 ? ", " : "") << "{\"seed\": " << j + 1 << ", \"k\": " << results[j].k
+                << ", \"time_to_target_s\": ";
+            if (results[j].timeToTarget >= 0) {
+                out << results[j].timeToTarget;
+            } else {
+                out << "null";
+            }
+            out << "}";
+        }
+        out << "]}";
+    }
+    out << "\n  ]\n}\n";
+    return 0;
+}
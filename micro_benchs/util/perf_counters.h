@@ -0,0 +1,218 @@
+#pragma once
+
+#include "benchmark/benchmark.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Hardware performance counters of the micro benchmarks, read via perf_event_open.
+ * The counters only measure user space, so they work with the default perf_event_paranoid setting of 2.
+ * If the counters are not supported (e.g. in virtual machines or non linux systems), all values are zero.
+ */
+namespace perf_counters {
+
+    enum Event {
+        CYCLES,
+        INSTRUCTIONS,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        EVENT_COUNT
+    };
+
+    inline const char *eventName(const Event event) {
+        switch (event) {
+            case CYCLES:
+                return "cycles";
+            case INSTRUCTIONS:
+                return "instructions";
+            case LLC_MISSES:
+                return "llc_misses";
+            case BRANCH_MISSES:
+                return "branch_misses";
+            default:
+                return "unknown";
+        }
+    }
+
+    /**
+     * The counter values at a point in time or the difference of two points in time
+     */
+    struct Sample {
+        std::array<uint64_t, EVENT_COUNT> values{};
+
+        Sample operator-(const Sample &other) const {
+            Sample result;
+            for (size_t i = 0; i < EVENT_COUNT; i++) {
+                result.values[i] = values[i] - other.values[i];
+            }
+            return result;
+        }
+
+        Sample &operator+=(const Sample &other) {
+            for (size_t i = 0; i < EVENT_COUNT; i++) {
+                values[i] += other.values[i];
+            }
+            return *this;
+        }
+    };
+
+    /**
+     * Counts the events of the calling thread from construction until destruction.
+     * The counters are never reset; regions are measured as the difference of two samples.
+     */
+    class Counters {
+    public:
+        /**
+         * @param inherit if true, threads created by the calling thread after the construction are counted as well
+         */
+        explicit Counters(bool inherit = false) {
+            fds.fill(-1);
+#ifdef __linux__
+            const uint64_t configs[EVENT_COUNT] = {PERF_COUNT_HW_CPU_CYCLES,
+                                                   PERF_COUNT_HW_INSTRUCTIONS,
+                                                   PERF_COUNT_HW_CACHE_MISSES,
+                                                   PERF_COUNT_HW_BRANCH_MISSES};
+            for (size_t i = 0; i < EVENT_COUNT; i++) {
+                perf_event_attr attr;
+                memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = configs[i];
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.inherit = inherit ? 1 : 0;
+                //Scale the counts if the kernel has to multiplex the hardware counters
+                attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                fds[i] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+                if (fds[i] < 0) {
+                    close();
+                    return;
+                }
+            }
+#endif
+        }
+
+        ~Counters() {
+            close();
+        }
+
+        Counters(const Counters &) = delete;
+
+        Counters &operator=(const Counters &) = delete;
+
+        /**
+         * @return true if all counters could be opened
+         */
+        bool available() const {
+            return fds[0] >= 0;
+        }
+
+        /**
+         * @return the events counted since the construction
+         */
+        Sample read() const {
+            Sample sample;
+#ifdef __linux__
+            for (size_t i = 0; i < EVENT_COUNT && available(); i++) {
+                uint64_t data[3];
+                if (::read(fds[i], data, sizeof(data)) != sizeof(data) || data[2] == 0) {
+                    continue;
+                }
+                sample.values[i] = data[2] == data[1]
+                                   ? data[0]
+                                   : static_cast<uint64_t>(double(data[0]) * data[1] / data[2]);
+            }
+#endif
+            return sample;
+        }
+
+    private:
+        void close() {
+#ifdef __linux__
+            for (auto &fd : fds) {
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+                fd = -1;
+            }
+#endif
+        }
+
+        std::array<int, EVENT_COUNT> fds;
+    };
+
+    /**
+     * Accumulates the events of a code region executed by arbitrary threads
+     */
+    class Region {
+    public:
+        explicit Region(std::string name) : name(std::move(name)) {}
+
+        /**
+         * Executes \p f and adds the events of the calling thread to this region.
+         * Every thread lazily opens its own counters.
+         */
+        template<typename F>
+        auto measure(F &&f) -> decltype(f()) {
+            static thread_local Counters counters;
+            struct Guard {
+                Region &region;
+                const Counters &counters;
+                const Sample begin;
+
+                ~Guard() {
+                    region.add(counters.read() - begin);
+                }
+            } guard{*this, counters, counters.read()};
+            return f();
+        }
+
+        void add(const Sample &sample) {
+            for (size_t i = 0; i < EVENT_COUNT; i++) {
+                values[i].fetch_add(sample.values[i], std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * Reports the accumulated events as user counters "<region>_<event>", averaged over the benchmark iterations
+         */
+        void report(benchmark::State &state) const {
+            for (size_t i = 0; i < EVENT_COUNT; i++) {
+                state.counters[name + "_" + eventName(Event(i))] =
+                        benchmark::Counter(double(values[i].load()), benchmark::Counter::kAvgIterations);
+            }
+        }
+
+    private:
+        const std::string name;
+        std::array<std::atomic<uint64_t>, EVENT_COUNT> values{};
+    };
+
+    /**
+     * Prints a warning once if the hardware counters are not available
+     * @return true if the counters are available
+     */
+    inline bool checkAvailable() {
+        static const bool available = [] {
+            bool result = Counters().available();
+            if (!result) {
+                std::cerr << "Hardware performance counters are not available "
+                          << "(check /proc/sys/kernel/perf_event_paranoid), reporting zeros\n";
+            }
+            return result;
+        }();
+        return available;
+    }
+}
@@ -0,0 +1,93 @@
+#include "data_structure/compressed_graph.h"
+#include "data_structure/io/graph_io.h"
+#include "colouring/graph_colouring.h"
+#include "colouring/hca.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+
+static void expectSameGraph(const graph_access &G, const compressed_graph_access &C) {
+    ASSERT_EQ(C.number_of_nodes(), G.number_of_nodes());
+    ASSERT_EQ(C.number_of_edges(), G.number_of_edges());
+    for (NodeID n = 0; n < G.number_of_nodes(); n++) {
+        std::vector<NodeID> expected;
+        for (auto neighbour : G.neighbours(n)) {
+            expected.push_back(neighbour);
+        }
+        std::sort(expected.begin(), expected.end());
+        std::vector<NodeID> actual;
+        for (auto neighbour : C.neighbours(n)) {
+            actual.push_back(neighbour);
+        }
+        EXPECT_EQ(C.getNodeDegree(n), G.getNodeDegree(n));
+        EXPECT_EQ(actual, expected);
+    }
+}
+
+TEST(CompressedGraph, SimpleGraph) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/simple.graph");
+    compressed_graph_access C(G);
+    expectSameGraph(G, C);
+
+    graph_colouring::Colouring s = {0, 0, 0, 0, 0, 1};
+    EXPECT_EQ(graph_colouring::numberOfConflictingEdges(C, s), 4);
+    EXPECT_EQ(graph_colouring::numberOfConflictingNodes(C, s), 5);
+}
+
+TEST(CompressedGraph, IsolatedNodesAndLargeGaps) {
+    //0 - 1000, 1 - 999, 500 isolated
+    graph_access G;
+    G.start_construction(1001, 4);
+    for (NodeID n = 0; n < 1001; n++) {
+        G.new_node();
+        if (n == 0) {
+            G.new_edge(0, 1000);
+        } else if (n == 1) {
+            G.new_edge(1, 999);
+        } else if (n == 999) {
+            G.new_edge(999, 1);
+        } else if (n == 1000) {
+            G.new_edge(1000, 0);
+        }
+    }
+    G.finish_construction();
+
+    compressed_graph_access C(G);
+    expectSameGraph(G, C);
+    EXPECT_EQ(C.getNodeDegree(500), 0);
+}
+
+TEST(CompressedGraph, DSJC500_1) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/DSJC500.1-sorted.graph");
+    compressed_graph_access C(G);
+    expectSameGraph(G, C);
+    EXPECT_LT(C.memory_usage(), G.number_of_edges() * sizeof(NodeID));
+}
+
+TEST(CompressedGraph, HybridColouringAlgorithm) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/miles250-sorted.graph");
+    compressed_graph_access C(G);
+
+    std::vector<std::unique_ptr<graph_colouring::BasicColouringStrategy<compressed_graph_access>>> strategies;
+    strategies.push_back(graph_colouring::hcaStrategy<compressed_graph_access>(5, 2, 0.6));
+
+    graph_colouring::ColouringAlgorithm algorithm;
+    algorithm.seed = 1;
+    std::vector<graph_colouring::Colouring> reported;
+    algorithm.onValidColouring = [&reported](const graph_colouring::Colouring &s, size_t) {
+        reported.push_back(s);
+    };
+    auto result = algorithm.perform(strategies, C, 10, 20, 20, 2)[0];
+    EXPECT_TRUE(result.isValid);
+    ASSERT_EQ(result.s.size(), G.number_of_nodes());
+    EXPECT_EQ(graph_colouring::numberOfConflictingEdges(G, result.s), 0);
+    EXPECT_LE(graph_colouring::colorCount(result.s), 10);
+    //the colourings of the compressed graph colour the input graph
+    EXPECT_FALSE(reported.empty());
+}
@@ -0,0 +1,100 @@
+#include "data_structure/dynamic_graph.h"
+#include "data_structure/io/graph_io.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+
+template<typename Graph>
+static std::vector<std::set<NodeID>> adjacencySets(const Graph &G) {
+    std::vector<std::set<NodeID>> sets(G.number_of_nodes());
+    for (NodeID n = 0; n < G.number_of_nodes(); n++) {
+        for (auto neighbour : G.neighbours(n)) {
+            sets[n].insert(neighbour);
+        }
+        EXPECT_EQ(sets[n].size(), G.getNodeDegree(n));
+    }
+    return sets;
+}
+
+TEST(DynamicGraph, MatchesStaticGraph) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/miles250-sorted.graph");
+    dynamic_graph_access D(G);
+    EXPECT_EQ(D.number_of_nodes(), G.number_of_nodes());
+    EXPECT_EQ(D.number_of_edges(), G.number_of_edges());
+    EXPECT_EQ(adjacencySets(D), adjacencySets(G));
+    EXPECT_TRUE(D.has_edge(G.getEdgeTarget(0), 0));
+
+    graph_access copy;
+    D.to_graph_access(copy);
+    EXPECT_EQ(copy.number_of_edges(), G.number_of_edges());
+    EXPECT_EQ(adjacencySets(copy), adjacencySets(G));
+}
+
+TEST(DynamicGraph, OverflowBlocks) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/simple.graph");
+    dynamic_graph_access D(G, 0.0, 0);
+    auto edges = G.number_of_edges();
+
+    //skipped: self-loop, unknown node, existing edge, duplicate within the batch
+    EXPECT_EQ(D.insert_edges({{0, 3}, {0, 4}, {2, 2}, {0, 6}, {0, 1}, {3, 0}}), 2);
+    EXPECT_EQ(D.number_of_edges(), edges + 4);
+    EXPECT_TRUE(D.has_edge(3, 0));
+    EXPECT_TRUE(D.has_edge(0, 4));
+    EXPECT_GT(D.garbage(), 0);
+
+    EXPECT_EQ(D.remove_edges({{3, 0}, {3, 0}, {0, 6}}), 1);
+    EXPECT_FALSE(D.has_edge(0, 3));
+    EXPECT_EQ(D.number_of_edges(), edges + 2);
+
+    auto before = adjacencySets(D);
+    D.compact();
+    EXPECT_EQ(D.garbage(), 0);
+    EXPECT_EQ(adjacencySets(D), before);
+}
+
+TEST(DynamicGraph, RandomUpdates) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/DSJC250.1-sorted.graph");
+    dynamic_graph_access D(G);
+    auto expected = adjacencySets(G);
+
+    std::mt19937 generator(5);
+    std::uniform_int_distribution<NodeID> node(0, G.number_of_nodes() - 1);
+    for (int round = 0; round < 50; round++) {
+        std::vector<std::pair<NodeID, NodeID>> inserted;
+        std::vector<std::pair<NodeID, NodeID>> removed;
+        for (int i = 0; i < 40; i++) {
+            inserted.emplace_back(node(generator), node(generator));
+            removed.emplace_back(node(generator), node(generator));
+            auto n = node(generator);
+            if (!expected[n].empty()) {
+                removed.emplace_back(n, *expected[n].begin());
+            }
+        }
+        D.insert_edges(inserted);
+        for (auto &edge : inserted) {
+            if (edge.first != edge.second) {
+                expected[edge.first].insert(edge.second);
+                expected[edge.second].insert(edge.first);
+            }
+        }
+        D.remove_edges(removed);
+        for (auto &edge : removed) {
+            expected[edge.first].erase(edge.second);
+            expected[edge.second].erase(edge.first);
+        }
+        ASSERT_EQ(adjacencySets(D), expected);
+    }
+    EdgeID edges = 0;
+    for (auto &neighbours : expected) {
+        edges += neighbours.size();
+    }
+    EXPECT_EQ(D.number_of_edges(), edges);
+}
@@ -0,0 +1,85 @@
+#include "data_structure/graph_builder.h"
+#include "data_structure/io/graph_io.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <random>
+
+static std::vector<NodeID> sortedNeighbours(const graph_access &G, const NodeID n) {
+    std::vector<NodeID> neighbours;
+    for (auto neighbour : G.neighbours(n)) {
+        neighbours.push_back(neighbour);
+    }
+    std::sort(neighbours.begin(), neighbours.end());
+    return neighbours;
+}
+
+TEST(GraphBuilder, SymmetrizesAndRemovesDuplicates) {
+    graph_builder builder(6);
+    builder.add_edge(0, 5, 0);
+    builder.add_edge(0, 0, 1);
+    builder.add_edge(0, 1, 0);
+    builder.add_edge(0, 2, 2);
+    builder.add_edge(0, 3, 1);
+    builder.add_edge(0, 3, 1);
+
+    graph_access G;
+    builder.build(G, 2);
+    ASSERT_EQ(G.number_of_nodes(), 6);
+    ASSERT_EQ(G.number_of_edges(), 6);
+    EXPECT_THAT(sortedNeighbours(G, 0), testing::ElementsAre(1, 5));
+    EXPECT_THAT(sortedNeighbours(G, 1), testing::ElementsAre(0, 3));
+    EXPECT_THAT(sortedNeighbours(G, 2), testing::ElementsAre());
+    EXPECT_THAT(sortedNeighbours(G, 3), testing::ElementsAre(1));
+    EXPECT_THAT(sortedNeighbours(G, 4), testing::ElementsAre());
+    EXPECT_THAT(sortedNeighbours(G, 5), testing::ElementsAre(0));
+}
+
+TEST(GraphBuilder, InfersNodeCount) {
+    graph_builder builder;
+    builder.add_edge(0, 7, 2);
+
+    graph_access G;
+    builder.build(G, 1);
+    EXPECT_EQ(G.number_of_nodes(), 8);
+    EXPECT_EQ(G.number_of_edges(), 2);
+}
+
+TEST(GraphBuilder, ConcurrentProducers) {
+    graph_access expected;
+    graph_io::readGraphWeighted(expected, "../../input/DSJC250.5-sorted.graph");
+
+    //Every undirected edge is added once in each direction by random producers
+    const size_t producerCount = 4;
+    std::vector<std::pair<NodeID, NodeID>> edges;
+    for (NodeID n = 0; n < expected.number_of_nodes(); n++) {
+        for (auto neighbour : expected.neighbours(n)) {
+            edges.emplace_back(n, neighbour);
+        }
+    }
+    std::shuffle(edges.begin(), edges.end(), std::mt19937(0));
+
+    graph_builder builder(expected.number_of_nodes(), producerCount);
+    std::vector<std::thread> producers;
+    for (size_t producer = 0; producer < producerCount; producer++) {
+        producers.emplace_back([&, producer]() {
+            for (size_t i = producer; i < edges.size(); i += producerCount) {
+                builder.add_edge(producer, edges[i].first, edges[i].second);
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+
+    graph_access G;
+    builder.build(G, 3);
+    ASSERT_EQ(G.number_of_nodes(), expected.number_of_nodes());
+    ASSERT_EQ(G.number_of_edges(), expected.number_of_edges());
+    for (NodeID n = 0; n < G.number_of_nodes(); n++) {
+        EXPECT_EQ(sortedNeighbours(G, n), sortedNeighbours(expected, n));
+    }
+}
@@ -0,0 +1,114 @@
+#include "data_structure/io/dimacs_io.h"
+#include "data_structure/io/graph_io.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#ifdef COLOURING_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+static std::vector<NodeID> sortedNeighbours(const graph_access &G, const NodeID n) {
+    std::vector<NodeID> neighbours;
+    for (auto neighbour : G.neighbours(n)) {
+        neighbours.push_back(neighbour);
+    }
+    std::sort(neighbours.begin(), neighbours.end());
+    return neighbours;
+}
+
+/**
+ * @return the graph in DIMACS format (every edge is listed once)
+ */
+static std::string toDimacs(const graph_access &G) {
+    std::ostringstream out;
+    out << "c converted from METIS\n";
+    out << "p edge " << G.number_of_nodes() << " " << G.number_of_edges() / 2 << "\n";
+    for (NodeID u = 0; u < G.number_of_nodes(); u++) {
+        for (auto v : G.neighbours(u)) {
+            if (u < v) {
+                out << "e " << u + 1 << " " << v + 1 << "\n";
+            }
+        }
+    }
+    return out.str();
+}
+
+static void writeFile(const std::string &filename, const std::string &content) {
+    std::ofstream out(filename.c_str(), std::ios::binary | std::ios::trunc);
+    out << content;
+}
+
+static void expectEqualGraphs(const graph_access &expected, const graph_access &actual) {
+    ASSERT_EQ(expected.number_of_nodes(), actual.number_of_nodes());
+    ASSERT_EQ(expected.number_of_edges(), actual.number_of_edges());
+    for (NodeID n = 0; n < expected.number_of_nodes(); n++) {
+        EXPECT_EQ(sortedNeighbours(expected, n), sortedNeighbours(actual, n));
+    }
+}
+
+TEST(DimacsIO, ReadsPlainFile) {
+    writeFile("dimacs_io_test.col",
+              "c a small graph\n"
+              "p edge 5 4\n"
+              "e 1 2\n"
+              "\n"
+              "e 2 3\r\n"
+              "e 3 2\n"
+              "e  5   1");
+    graph_access G;
+    ASSERT_EQ(graph_io::readGraphDimacs(G, "dimacs_io_test.col", 2), 0);
+    ASSERT_EQ(G.number_of_nodes(), 5);
+    ASSERT_EQ(G.number_of_edges(), 6);
+    EXPECT_THAT(sortedNeighbours(G, 0), testing::ElementsAre(1, 4));
+    EXPECT_THAT(sortedNeighbours(G, 1), testing::ElementsAre(0, 2));
+    EXPECT_THAT(sortedNeighbours(G, 2), testing::ElementsAre(1));
+    EXPECT_THAT(sortedNeighbours(G, 3), testing::ElementsAre());
+    EXPECT_THAT(sortedNeighbours(G, 4), testing::ElementsAre(0));
+}
+
+TEST(DimacsIO, RejectsInvalidFiles) {
+    graph_access G;
+    EXPECT_EQ(graph_io::readGraphDimacs(G, "dimacs_io_test_missing.col"), 1);
+
+    writeFile("dimacs_io_test.col", "e 1 2\n");
+    EXPECT_EQ(graph_io::readGraphDimacs(G, "dimacs_io_test.col"), 1);
+
+    writeFile("dimacs_io_test.col", "p edge 2 1\ne 1 3\n");
+    EXPECT_EQ(graph_io::readGraphDimacs(G, "dimacs_io_test.col"), 1);
+
+    writeFile("dimacs_io_test.col", "p edge 2 1\ne 1 x\n");
+    EXPECT_EQ(graph_io::readGraphDimacs(G, "dimacs_io_test.col"), 1);
+}
+
+TEST(DimacsIO, MatchesMetisGraph) {
+    //The DIMACS representation is larger than one read block
+    graph_access expected;
+    graph_io::readGraphWeighted(expected, "../../input/DSJC1000.5-sorted.graph");
+    writeFile("dimacs_io_test.col", toDimacs(expected));
+
+    graph_access G;
+    ASSERT_EQ(graph_io::readGraphDimacs(G, "dimacs_io_test.col"), 0);
+    expectEqualGraphs(expected, G);
+}
+
+#ifdef COLOURING_HAVE_ZLIB
+TEST(DimacsIO, ReadsGzipFile) {
+    graph_access expected;
+    graph_io::readGraphWeighted(expected, "../../input/DSJC1000.5-sorted.graph");
+    auto content = toDimacs(expected);
+    gzFile out = gzopen("dimacs_io_test.col.gz", "wb");
+    ASSERT_NE(out, nullptr);
+    ASSERT_EQ(gzwrite(out, content.data(), static_cast<unsigned>(content.size())), static_cast<int>(content.size()));
+    gzclose(out);
+
+    graph_access G;
+    ASSERT_EQ(graph_io::readGraphDimacs(G, "dimacs_io_test.col.gz"), 0);
+    expectEqualGraphs(expected, G);
+}
+#endif
@@ -0,0 +1,207 @@
+#include "data_structure/io/graph_cache.h"
+#include "data_structure/io/graph_io.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+static void expectEqualGraphs(const graph_access &expected, const graph_access &actual) {
+    ASSERT_EQ(expected.number_of_nodes(), actual.number_of_nodes());
+    ASSERT_EQ(expected.number_of_edges(), actual.number_of_edges());
+    for (NodeID n = 0; n < expected.number_of_nodes(); n++) {
+        ASSERT_EQ(expected.get_first_edge(n), actual.get_first_edge(n));
+    }
+    for (EdgeID e = 0; e < expected.number_of_edges(); e++) {
+        ASSERT_EQ(expected.getEdgeTarget(e), actual.getEdgeTarget(e));
+    }
+}
+
+static void writeFile(const std::string &filename, const std::string &content) {
+    std::ofstream out(filename.c_str(), std::ios::binary | std::ios::trunc);
+    out << content;
+}
+
+TEST(GraphCache, BinaryRoundTrip) {
+    graph_access expected;
+    graph_io::readGraphWeighted(expected, "../../input/miles250-sorted.graph");
+    ASSERT_EQ(graph_io::writeGraphBinary(expected, "graph_cache_test.csr"), 0);
+
+    graph_access G;
+    ASSERT_EQ(graph_io::readGraphBinary(G, "graph_cache_test.csr"), 0);
+    expectEqualGraphs(expected, G);
+
+    writeFile("graph_cache_test.csr", "GCSR");
+    EXPECT_EQ(graph_io::readGraphBinary(G, "graph_cache_test.csr"), 1);
+}
+
+TEST(GraphCache, SharesParsedGraphs) {
+    graph_io::graph_cache cache;
+    auto G1 = cache.get("../../input/DSJC250.5-sorted.graph");
+    auto G2 = cache.get("../../input/DSJC250.5-sorted.graph");
+    ASSERT_NE(G1, nullptr);
+    EXPECT_EQ(G1, G2);
+    EXPECT_EQ(cache.size(), 1);
+
+    graph_access expected;
+    graph_io::readGraphWeighted(expected, "../../input/DSJC250.5-sorted.graph");
+    expectEqualGraphs(expected, *G1);
+
+    EXPECT_EQ(cache.get("graph_cache_test_missing.graph"), nullptr);
+    cache.release("../../input/DSJC250.5-sorted.graph");
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_NE(cache.get("../../input/DSJC250.5-sorted.graph"), G1);
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(G1->number_of_nodes(), 250);
+}
+
+TEST(GraphCache, ConcurrentRequests) {
+    graph_io::graph_cache cache;
+    const std::string files[] = {"../../input/DSJC250.5-sorted.graph", "../../input/miles250-sorted.graph"};
+    std::vector<std::shared_ptr<const graph_access>> graphs(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < graphs.size(); i++) {
+        threads.emplace_back([&, i] {
+            graphs[i] = cache.get(files[i % 2]);
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    //Every file is parsed once, the other requests wait for the parsed graph
+    EXPECT_EQ(cache.size(), 2);
+    for (size_t i = 0; i < graphs.size(); i++) {
+        ASSERT_NE(graphs[i], nullptr);
+        EXPECT_EQ(graphs[i], graphs[i % 2]);
+    }
+    EXPECT_NE(graphs[0], graphs[1]);
+    EXPECT_EQ(graphs[0]->number_of_nodes(), 250);
+}
+
+TEST(GraphCache, DetectsModifiedFiles) {
+    graph_io::graph_cache cache;
+    writeFile("graph_cache_test.col", "p edge 3 1\ne 1 2\n");
+    auto G1 = cache.get("graph_cache_test.col");
+    ASSERT_NE(G1, nullptr);
+    EXPECT_EQ(G1->number_of_edges(), 2);
+
+    writeFile("graph_cache_test.col", "p edge 3 2\ne 1 2\ne 2 3\n");
+    auto G2 = cache.get("graph_cache_test.col");
+    ASSERT_NE(G2, nullptr);
+    EXPECT_EQ(G2->number_of_edges(), 4);
+    EXPECT_EQ(G1->number_of_edges(), 2);
+}
+
+TEST(GraphCache, MalformedMetisFiles) {
+    graph_io::graph_cache cache;
+    const char *malformed[] = {
+            "x y\n",
+            "4000000000 1\n2\n1\n",
+            "2 1\n2\n1\n1\n",
+            "2 1\n3\n1\n",
+            "2 1\n2 1\n1\n",
+            "3 1\n2\n1\n",
+            "2 1 10\n4294967295 2\n4294967295 1\n"
+    };
+    for (auto content : malformed) {
+        writeFile("graph_cache_test.graph", content);
+        graph_access G;
+        EXPECT_EQ(graph_io::readGraphWeighted(G, "graph_cache_test.graph"), 1) << content;
+        EXPECT_EQ(cache.get("graph_cache_test.graph"), nullptr) << content;
+    }
+    writeFile("graph_cache_test.graph", "2 1\n2\n1\n");
+    auto G = cache.get("graph_cache_test.graph");
+    ASSERT_NE(G, nullptr);
+    EXPECT_EQ(G->number_of_edges(), 2);
+}
+
+static std::vector<std::string> listDirectory(const std::string &directory) {
+    std::vector<std::string> files;
+    DIR *dir = opendir(directory.c_str());
+    while (dirent *entry = readdir(dir)) {
+        if (entry->d_name[0] != '.') {
+            files.push_back(directory + "/" + entry->d_name);
+        }
+    }
+    closedir(dir);
+    return files;
+}
+
+TEST(GraphCache, PersistsBinaryGraphs) {
+    mkdir("graph_cache_test_dir", 0755);
+    for (auto &file : listDirectory("graph_cache_test_dir")) {
+        std::remove(file.c_str());
+    }
+    writeFile("graph_cache_test.col", "p edge 4 2\ne 1 2\ne 3 4\n");
+    {
+        graph_io::graph_cache cache("graph_cache_test_dir");
+        ASSERT_NE(cache.get("graph_cache_test.col"), nullptr);
+    }
+    auto files = listDirectory("graph_cache_test_dir");
+    ASSERT_EQ(files.size(), 1);
+
+    //Replacing the binary graph shows that a new cache does not parse the original file again
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/simple.graph");
+    ASSERT_EQ(graph_io::writeGraphBinary(G, files[0]), 0);
+
+    graph_io::graph_cache cache("graph_cache_test_dir");
+    auto cached = cache.get("graph_cache_test.col");
+    ASSERT_NE(cached, nullptr);
+    expectEqualGraphs(G, *cached);
+}
+
+static std::string readFile(const std::string &filename) {
+    std::ifstream in(filename.c_str(), std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+TEST(GraphCache, ParseMetis) {
+    graph_access expected;
+    graph_io::readGraphWeighted(expected, "../../input/miles250-sorted.graph");
+    graph_access G;
+    ASSERT_EQ(graph_io::parseGraphMetis(G, readFile("../../input/miles250-sorted.graph")), 0);
+    expectEqualGraphs(expected, G);
+
+    //weights are skipped, the last node has no edges
+    ASSERT_EQ(graph_io::parseGraphMetis(G, "% comment\n3 1 11\n5 2 7\n4 1 7\n1\n"), 0);
+    EXPECT_EQ(G.number_of_nodes(), 3);
+    EXPECT_EQ(G.number_of_edges(), 2);
+    EXPECT_EQ(G.getEdgeTarget(0), 1);
+
+    EXPECT_EQ(graph_io::parseGraphMetis(G, ""), 1);
+    EXPECT_EQ(graph_io::parseGraphMetis(G, "3 1\n2\n1\n"), 1);
+    EXPECT_EQ(graph_io::parseGraphMetis(G, "2 1\n3\n1\n"), 1);
+    EXPECT_EQ(graph_io::parseGraphMetis(G, "2 1\n1\n\n"), 1);
+    EXPECT_EQ(graph_io::parseGraphMetis(G, "2 1\n2 2\n1\n"), 1);
+    //G is unchanged by failed calls
+    EXPECT_EQ(G.number_of_nodes(), 3);
+}
+
+TEST(GraphCache, ParseBinary) {
+    graph_access expected;
+    graph_io::readGraphWeighted(expected, "../../input/miles250-sorted.graph");
+    ASSERT_EQ(graph_io::writeGraphBinary(expected, "graph_cache_test.csr"), 0);
+    auto data = readFile("graph_cache_test.csr");
+
+    graph_access G;
+    ASSERT_EQ(graph_io::parseGraphBinary(G, data), 0);
+    expectEqualGraphs(expected, G);
+
+    EXPECT_EQ(graph_io::parseGraphBinary(G, data.substr(0, data.size() - 1)), 1);
+    EXPECT_EQ(graph_io::parseGraphBinary(G, data + "x"), 1);
+    EXPECT_EQ(graph_io::parseGraphBinary(G, "GCSR"), 1);
+    //an edge target out of range
+    auto corrupted = data;
+    std::memset(&corrupted[corrupted.size() - sizeof(NodeID)], 0xff, sizeof(NodeID));
+    EXPECT_EQ(graph_io::parseGraphBinary(G, corrupted), 1);
+}
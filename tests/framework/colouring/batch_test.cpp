@@ -0,0 +1,101 @@
+#include "colouring/batch.h"
+#include "colouring/init/dsatur.h"
+#include "data_structure/io/graph_io.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+
+using namespace graph_colouring;
+
+static std::vector<std::unique_ptr<graph_access>> readSmallGraphs() {
+    std::vector<std::unique_ptr<graph_access>> graphs;
+    for (int n : {10, 20, 50}) {
+        for (int density : {1, 5, 9}) {
+            for (int i = 1; i <= 3; i++) {
+                graphs.emplace_back(new graph_access());
+                auto file = "../../input/xrlf/" + std::to_string(n) + "." + std::to_string(density) + "."
+                            + std::to_string(i) + ".graph";
+                EXPECT_EQ(graph_io::readGraphWeighted(*graphs.back(), file), 0) << file;
+            }
+        }
+    }
+    return graphs;
+}
+
+TEST(GraphColouringBatch, SmallGraph) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/miles250-sorted.graph");
+
+    BatchParameters parameters;
+    std::mt19937 generator(1);
+    auto result = colourSmallGraph(G, parameters, generator);
+    EXPECT_TRUE(result.isValid);
+    EXPECT_EQ(numberOfConflictingEdges(G, result.s), 0);
+    EXPECT_EQ(std::count(result.s.begin(), result.s.end(), UNCOLORED), 0);
+    //the chromatic number is 8
+    EXPECT_EQ(colorCount(result.s), 8);
+}
+
+TEST(GraphColouringBatch, ResultsInOrder) {
+    auto graphs = readSmallGraphs();
+    std::vector<const graph_access *> batch;
+    for (auto &G : graphs) {
+        batch.push_back(G.get());
+    }
+
+    BatchParameters parameters;
+    parameters.seed = 7;
+    auto single = colourBatch(batch, parameters, 1);
+    auto parallel = colourBatch(batch, parameters, 4);
+    ASSERT_EQ(single.size(), graphs.size());
+    ASSERT_EQ(parallel.size(), graphs.size());
+    for (size_t i = 0; i < graphs.size(); i++) {
+        ASSERT_EQ(single[i].s.size(), graphs[i]->number_of_nodes());
+        EXPECT_EQ(numberOfConflictingEdges(*graphs[i], single[i].s), 0);
+        EXPECT_LE(colorCount(single[i].s), colorCount(dsaturColouring(*graphs[i])));
+        //every task has its own generator, the thread count does not matter
+        EXPECT_EQ(single[i].s, parallel[i].s);
+    }
+}
+
+TEST(GraphColouringBatch, SharedPool) {
+    auto graphs = readSmallGraphs();
+    std::vector<const graph_access *> batch;
+    for (auto &G : graphs) {
+        batch.push_back(G.get());
+    }
+
+    ColouringPool pool(3);
+    EXPECT_EQ(pool.threadCount(), 3);
+    EXPECT_TRUE(pool.colourBatch({}, BatchParameters()).empty());
+
+    //batches submitted concurrently by several threads share the workers
+    std::vector<std::vector<ColouringResult>> results(4);
+    std::vector<std::thread> clients;
+    for (size_t c = 0; c < results.size(); c++) {
+        clients.emplace_back([&, c] { results[c] = pool.colourBatch(batch, BatchParameters()); });
+    }
+    for (auto &client : clients) {
+        client.join();
+    }
+    for (auto &result : results) {
+        ASSERT_EQ(result.size(), graphs.size());
+        for (size_t i = 0; i < graphs.size(); i++) {
+            EXPECT_EQ(result[i].s, results[0][i].s);
+        }
+    }
+}
+
+TEST(GraphColouringBatch, PoolFinishesTasks) {
+    std::atomic<int> executed(0);
+    {
+        ColouringPool pool(2);
+        for (int t = 0; t < 100; t++) {
+            pool.submit([&] { executed++; });
+        }
+    }
+    EXPECT_EQ(executed.load(), 100);
+}
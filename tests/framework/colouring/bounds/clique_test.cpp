@@ -0,0 +1,86 @@
+#include "colouring/bounds/clique.h"
+
+#include "data_structure/io/graph_io.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+
+using namespace graph_colouring;
+
+static bool isClique(const graph_access &G, const std::vector<NodeID> &clique) {
+    for (auto u : clique) {
+        for (auto v : clique) {
+            if (u == v) {
+                continue;
+            }
+            bool adjacent = false;
+            for (auto neighbour : G.neighbours(u)) {
+                adjacent = adjacent || neighbour == v;
+            }
+            if (!adjacent) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+TEST(Clique, SimpleGraph) {
+    graph_access G;
+    std::string graph_filename = "../../input/simple.graph";
+    graph_io::readGraphWeighted(G, graph_filename);
+
+    auto clique = findLargeClique(G, std::chrono::milliseconds(100));
+    std::sort(clique.begin(), clique.end());
+    EXPECT_THAT(clique, testing::ElementsAre(0, 1, 5));
+}
+
+TEST(Clique, Miles250) {
+    graph_access G;
+    std::string graph_filename = "../../input/miles250-sorted.graph";
+    graph_io::readGraphWeighted(G, graph_filename);
+
+    auto clique = findLargeClique(G, std::chrono::milliseconds(1000));
+    EXPECT_EQ(clique.size(), 8);
+    EXPECT_TRUE(isClique(G, clique));
+    EXPECT_EQ(cliqueLowerBound(G, std::chrono::milliseconds(1000)), 8);
+}
+
+TEST(Clique, DSJC250_5) {
+    graph_access G;
+    std::string graph_filename = "../../input/DSJC250.5-sorted.graph";
+    graph_io::readGraphWeighted(G, graph_filename);
+
+    auto clique = findLargeClique(G, std::chrono::milliseconds(2000));
+    EXPECT_GE(clique.size(), 11);
+    EXPECT_LE(clique.size(), 12);
+    EXPECT_TRUE(isClique(G, clique));
+}
+
+TEST(Clique, GreedyWithoutTimeLimit) {
+    graph_access G;
+    std::string graph_filename = "../../input/DSJC500.5-sorted.graph";
+    graph_io::readGraphWeighted(G, graph_filename);
+
+    auto clique = findLargeClique(G, std::chrono::milliseconds(0));
+    EXPECT_GE(clique.size(), 2);
+    EXPECT_TRUE(isClique(G, clique));
+}
+
+TEST(Clique, StepLimit) {
+    graph_access G;
+    std::string graph_filename = "../../input/DSJC250.5-sorted.graph";
+    graph_io::readGraphWeighted(G, graph_filename);
+
+    auto greedy = findLargeClique(G, size_t(0));
+    EXPECT_TRUE(isClique(G, greedy));
+    auto limited = findLargeClique(G, size_t(1000));
+    EXPECT_TRUE(isClique(G, limited));
+    EXPECT_GE(limited.size(), greedy.size());
+    //The result does not depend on the time needed for the search
+    EXPECT_EQ(findLargeClique(G, size_t(1000)), limited);
+    EXPECT_EQ(cliqueLowerBound(G, size_t(1000)), limited.size());
+}
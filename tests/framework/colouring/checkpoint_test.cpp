@@ -0,0 +1,191 @@
+#include "colouring/checkpoint.h"
+
+#include "data_structure/io/graph_io.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <colouring/init/greedy_saturation.h>
+#include <colouring/crossover/gpx.h>
+#include <colouring/ls/tabu_search.h>
+
+using namespace graph_colouring;
+
+static std::vector<std::unique_ptr<ColouringStrategy>> hcaStrategy() {
+    std::vector<std::unique_ptr<ColouringStrategy>> strategies;
+    strategies.emplace_back(new FixedKColouringStrategy());
+    strategies[0]->initOperators.emplace_back([](const graph_access &graph,
+                                                 const ColorCount colors,
+                                                 std::mt19937 &generator) {
+        return graph_colouring::initByGreedySaturation(graph, colors, generator);
+    });
+    strategies[0]->crossoverOperators.emplace_back([](const Colouring &s1,
+                                                      const Colouring &s2,
+                                                      const graph_access &graph,
+                                                      std::mt19937 &generator) {
+        return graph_colouring::gpxCrossover(s1, s2, generator);
+    });
+    strategies[0]->lsOperators.emplace_back([](const Colouring &s,
+                                               const graph_access &graph,
+                                               std::mt19937 &generator) {
+        return graph_colouring::tabuSearchOperator(s, graph, 5, 2, 0.6, generator);
+    });
+    return strategies;
+}
+
+TEST(Checkpoint, RoundTrip) {
+    Checkpoint checkpoint;
+    checkpoint.nodeCount = 3;
+    checkpoint.strategyCount = 1;
+    checkpoint.populationSize = 2;
+    checkpoint.target_k = 7;
+    checkpoint.strategyK = {8};
+    checkpoint.iterations = {Checkpoint::FINISHED, 3};
+    checkpoint.population = {{0, 1, UNCOLORED}, {1000, 2, 70000}};
+    checkpoint.bestColourings = {{}};
+    checkpoint.generators = {"1 2 3", ""};
+
+    const std::string filename = "checkpoint_roundtrip.ckpt";
+    ASSERT_EQ(writeCheckpoint(filename, checkpoint), 0);
+
+    Checkpoint restored;
+    ASSERT_EQ(readCheckpoint(filename, restored), 0);
+    std::remove(filename.c_str());
+
+    EXPECT_EQ(restored.nodeCount, checkpoint.nodeCount);
+    EXPECT_EQ(restored.strategyCount, checkpoint.strategyCount);
+    EXPECT_EQ(restored.populationSize, checkpoint.populationSize);
+    EXPECT_EQ(restored.target_k, checkpoint.target_k);
+    EXPECT_EQ(restored.strategyK, checkpoint.strategyK);
+    EXPECT_EQ(restored.iterations, checkpoint.iterations);
+    EXPECT_EQ(restored.population, checkpoint.population);
+    EXPECT_EQ(restored.bestColourings, checkpoint.bestColourings);
+    EXPECT_EQ(restored.generators, checkpoint.generators);
+}
+
+TEST(Checkpoint, RejectsCorruptFiles) {
+    Checkpoint checkpoint;
+    checkpoint.nodeCount = 3;
+    checkpoint.strategyCount = 1;
+    checkpoint.populationSize = 2;
+    checkpoint.target_k = 7;
+    checkpoint.strategyK = {8};
+    checkpoint.iterations = {Checkpoint::FINISHED, 3};
+    checkpoint.population = {{0, 1, UNCOLORED}, {1000, 2, 70000}};
+    checkpoint.bestColourings = {{}};
+    checkpoint.generators = {"1 2 3"};
+
+    const std::string filename = "checkpoint_corrupt.ckpt";
+    ASSERT_EQ(writeCheckpoint(filename, checkpoint), 0);
+    std::string data;
+    {
+        std::ifstream in(filename.c_str(), std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    auto readData = [&filename](const std::string &content) {
+        {
+            std::ofstream out(filename.c_str(), std::ios::binary | std::ios::trunc);
+            out << content;
+        }
+        Checkpoint restored;
+        return readCheckpoint(filename, restored);
+    };
+    ASSERT_EQ(readData(data), 0);
+
+    for (size_t size = 0; size < data.size(); size++) {
+        EXPECT_EQ(readData(data.substr(0, size)), 1) << size;
+    }
+    //The length of strategyK follows the magic, the version and four header values
+    auto hugeLength = data;
+    const uint64_t length = uint64_t(1) << 60;
+    std::memcpy(&hugeLength[4 + 4 + 4 * 8], &length, sizeof(length));
+    EXPECT_EQ(readData(hugeLength), 1);
+
+    auto inconsistent = checkpoint;
+    inconsistent.iterations = {3};
+    ASSERT_EQ(writeCheckpoint(filename, inconsistent), 0);
+    Checkpoint restored;
+    EXPECT_EQ(readCheckpoint(filename, restored), 1);
+
+    inconsistent = checkpoint;
+    inconsistent.bestColourings = {{0, 1}};
+    ASSERT_EQ(writeCheckpoint(filename, inconsistent), 0);
+    EXPECT_EQ(readCheckpoint(filename, restored), 1);
+
+    inconsistent = checkpoint;
+    inconsistent.strategyK = {8, 8};
+    ASSERT_EQ(writeCheckpoint(filename, inconsistent), 0);
+    EXPECT_EQ(readCheckpoint(filename, restored), 1);
+    std::remove(filename.c_str());
+}
+
+TEST(Checkpoint, RejectsMissingFile) {
+    Checkpoint checkpoint;
+    EXPECT_EQ(readCheckpoint("does_not_exist.ckpt", checkpoint), 1);
+}
+
+TEST(Checkpoint, ResumeWithLargerMaxItr) {
+    graph_access G;
+    std::string graph_filename = "../../input/miles250-sorted.graph";
+    graph_io::readGraphWeighted(G, graph_filename);
+
+    const std::string filename = "checkpoint_resume.ckpt";
+    const ColorCount k = 10;
+    const size_t populationSize = 20;
+
+    auto strategies = hcaStrategy();
+    ColouringAlgorithm first;
+    first.checkpointFile = filename;
+    first.checkpointInterval = std::chrono::milliseconds(1);
+    //Otherwise the run stops as soon as the chromatic number has been found
+    first.cliqueTimeLimit = std::chrono::milliseconds(0);
+    //The checkpoint describes the whole graph, not a kernel
+    first.reduceGraph = true;
+    auto firstResult = first.perform(strategies, G, k, populationSize, 5, 2);
+
+    Checkpoint checkpoint;
+    ASSERT_EQ(readCheckpoint(filename, checkpoint), 0);
+    EXPECT_EQ(checkpoint.nodeCount, G.number_of_nodes());
+    EXPECT_EQ(checkpoint.population.size(), populationSize);
+    EXPECT_EQ(checkpoint.generators.size(), 2);
+    for (auto itr : checkpoint.iterations) {
+        EXPECT_EQ(itr, Checkpoint::FINISHED);
+    }
+
+    ColouringAlgorithm second;
+    second.resumeFile = filename;
+    second.cliqueTimeLimit = std::chrono::milliseconds(0);
+    second.reduceGraph = true;
+    auto secondResult = second.perform(strategies, G, k, populationSize, 20, 2);
+    std::remove(filename.c_str());
+
+    ASSERT_TRUE(firstResult[0].isValid);
+    ASSERT_TRUE(secondResult[0].isValid);
+    EXPECT_EQ(numberOfConflictingEdges(G, secondResult[0].s), 0);
+    EXPECT_LE(colorCount(secondResult[0].s), colorCount(firstResult[0].s));
+}
+
+TEST(Checkpoint, ResumeRejectsMismatchingPopulation) {
+    graph_access G;
+    std::string graph_filename = "../../input/simple.graph";
+    graph_io::readGraphWeighted(G, graph_filename);
+
+    Checkpoint checkpoint;
+    checkpoint.nodeCount = G.number_of_nodes();
+    checkpoint.strategyCount = 1;
+    checkpoint.populationSize = 10;
+    const std::string filename = "checkpoint_mismatch.ckpt";
+    ASSERT_EQ(writeCheckpoint(filename, checkpoint), 0);
+
+    auto strategies = hcaStrategy();
+    ColouringAlgorithm algorithm;
+    algorithm.resumeFile = filename;
+    algorithm.reduceGraph = false;
+    EXPECT_ANY_THROW(algorithm.perform(strategies, G, 3, 20, 5, 1));
+    std::remove(filename.c_str());
+}
@@ -8,6 +8,14 @@
 
 #include <debug.h>
 
+#include <fstream>
+#include <sstream>
+
+#include <colouring/init/greedy_saturation.h>
+#include <colouring/crossover/gpx.h>
+#include <colouring/ls/tabu_search.h>
+#include <colouring/hca.h>
+
 using namespace graph_colouring;
 
 TEST(GraphColouringNumberOfConflictingEdges, SimpleGraph) {
@@ -40,44 +48,60 @@ TEST(GraphColouringNumberOfConflictingNodes, SimpleGraph) {
     EXPECT_EQ(graph_colouring::numberOfConflictingNodes(G, s_worst_score), 6);
 }
 
+TEST(GraphColouringSquaredColorClassSizes, SparseAndPartialColouring) {
+    graph_colouring::Colouring s = {0, 7, 7, UNCOLORED, 3, 7};
+    EXPECT_EQ(graph_colouring::colorCount(s), 3);
+    EXPECT_EQ(graph_colouring::squaredColorClassSizes(s), -(1 + 9 + 1));
+
+    graph_colouring::Colouring large(70000, 0);
+    EXPECT_EQ(graph_colouring::squaredColorClassSizes(large), -int64_t(70000) * 70000);
+}
+
 TEST(GraphColouring, parallelSchedule) {
 
 
     std::vector<std::unique_ptr<ColouringStrategy>> strategies;
     strategies.emplace_back(new FixedKColouringStrategy());
     strategies[0]->initOperators.emplace_back([](const graph_access &graph,
-                                                 const size_t colors) {
+                                                 const size_t colors,
+                                                 std::mt19937 &generator) {
         Colouring dummy(colors);
         return dummy;
     });
     strategies[0]->initOperators.emplace_back([](const graph_access &graph,
-                                                 const size_t colors) {
+                                                 const size_t colors,
+                                                 std::mt19937 &generator) {
         Colouring dummy(colors);
         return dummy;
     });
     strategies[0]->initOperators.emplace_back([](const graph_access &graph,
-                                                 const size_t colors) {
+                                                 const size_t colors,
+                                                 std::mt19937 &generator) {
         Colouring dummy(colors);
         return dummy;
     });
     strategies[0]->crossoverOperators.emplace_back([](const Colouring &s1,
                                                       const Colouring &s2,
-                                                      const graph_access &graph) {
+                                                      const graph_access &graph,
+                                                      std::mt19937 &generator) {
         return s1;
     });
     strategies[0]->crossoverOperators.emplace_back([](const Colouring &s1,
                                                       const Colouring &s2,
-                                                      const graph_access &graph) {
+                                                      const graph_access &graph,
+                                                      std::mt19937 &generator) {
         return s2;
     });
     strategies[0]->lsOperators.emplace_back([](const Colouring &s,
-                                               const graph_access &graph) {
+                                               const graph_access &graph,
+                                               std::mt19937 &generator) {
         return s;
     });
 
     strategies.emplace_back(new VariableColouringStrategy());
     strategies[1]->initOperators.emplace_back([](const graph_access &graph,
-                                                 const size_t colors) {
+                                                 const size_t colors,
+                                                 std::mt19937 &generator) {
         Colouring dummy(colors);
         return dummy;
     });
@@ -85,7 +109,8 @@ TEST(GraphColouring, parallelSchedule) {
     strategies[1]->crossoverOperators.emplace_back([&executionCounter](
             const Colouring &s1,
             const Colouring &s2,
-            const graph_access &graph) {
+            const graph_access &graph,
+            std::mt19937 &generator) {
         executionCounter++;
         if (executionCounter > 100) {
             Colouring solution(s1.size());
@@ -97,7 +122,8 @@ TEST(GraphColouring, parallelSchedule) {
         return s1;
     });
     strategies[1]->lsOperators.emplace_back([](const Colouring &s,
-                                               const graph_access &graph) {
+                                               const graph_access &graph,
+                                               std::mt19937 &generator) {
         return s;
     });
 
@@ -115,4 +141,274 @@ TEST(GraphColouring, parallelSchedule) {
                                  populationSize,
                                  maxItr);
     //ASSERT_TRUE(hcaCrossoverOp1Count > 0 && hcaCrossoverOp1Count < maxItr * population_size / 2);
-}
\ No newline at end of file
+}
+
+TEST(GraphColouring, DisconnectedGraph) {
+    graph_access G1;
+    graph_io::readGraphWeighted(G1, "../../input/miles250-sorted.graph");
+    graph_access G2;
+    graph_io::readGraphWeighted(G2, "../../input/simple.graph");
+
+    //Disjoint union of both graphs
+    graph_access G;
+    G.start_construction(G1.number_of_nodes() + G2.number_of_nodes(),
+                         G1.number_of_edges() + G2.number_of_edges());
+    for (NodeID n = 0; n < G1.number_of_nodes(); n++) {
+        G.new_node();
+        for (auto neighbour : G1.neighbours(n)) {
+            G.new_edge(n, neighbour);
+        }
+    }
+    for (NodeID n = 0; n < G2.number_of_nodes(); n++) {
+        G.new_node();
+        for (auto neighbour : G2.neighbours(n)) {
+            G.new_edge(G1.number_of_nodes() + n, G1.number_of_nodes() + neighbour);
+        }
+    }
+    G.finish_construction();
+
+    std::vector<std::unique_ptr<ColouringStrategy>> strategies;
+    strategies.emplace_back(new FixedKColouringStrategy());
+    strategies[0]->initOperators.emplace_back([](const graph_access &graph,
+                                                 const ColorCount colors,
+                                                 std::mt19937 &generator) {
+        return initByGreedySaturation(graph, colors, generator);
+    });
+    strategies[0]->crossoverOperators.emplace_back([](const Colouring &s1,
+                                                      const Colouring &s2,
+                                                      const graph_access &graph,
+                                                      std::mt19937 &generator) {
+        return gpxCrossover(s1, s2, generator);
+    });
+    strategies[0]->lsOperators.emplace_back([](const Colouring &s,
+                                               const graph_access &graph,
+                                               std::mt19937 &generator) {
+        return tabuSearchOperator(s, graph, 5, 2, 0.6, generator);
+    });
+
+    ColouringAlgorithm algorithm;
+    algorithm.decomposeComponents = true;
+    auto result = algorithm.perform(strategies, G, 9, 20, 20, 2)[0];
+    ASSERT_EQ(result.s.size(), G.number_of_nodes());
+    EXPECT_TRUE(result.isValid);
+    EXPECT_TRUE(isFullyColoured(result.s));
+    EXPECT_EQ(numberOfConflictingEdges(G, result.s), 0);
+    EXPECT_EQ(colorCount(result.s), 8);
+}
+
+TEST(GraphColouring, CliqueLowerBoundStopsSearch) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/miles250-sorted.graph");
+
+    std::vector<std::unique_ptr<ColouringStrategy>> strategies;
+    strategies.push_back(hcaStrategy(5, 2, 0.6));
+
+    ColouringAlgorithm algorithm;
+    algorithm.cliqueTimeLimit = std::chrono::milliseconds(1000);
+    //The search would only be stopped by the time limit without a lower bound
+    algorithm.timeLimit = std::chrono::milliseconds(20000);
+    auto start = std::chrono::steady_clock::now();
+    auto result = algorithm.perform(strategies, G, 9, 20, std::numeric_limits<size_t>::max(), 2)[0];
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(elapsed, std::chrono::seconds(10));
+    EXPECT_TRUE(result.isValid);
+    EXPECT_EQ(numberOfConflictingEdges(G, result.s), 0);
+    //the chromatic number of miles250 is 8, which is the size of its largest clique
+    EXPECT_EQ(colorCount(result.s), 8);
+}
+
+TEST(GraphColouring, ReducedGraph) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/miles250-sorted.graph");
+
+    std::vector<std::unique_ptr<ColouringStrategy>> strategies;
+    strategies.push_back(hcaStrategy(5, 2, 0.6));
+
+    ColouringAlgorithm algorithm;
+    algorithm.cliqueTimeLimit = std::chrono::milliseconds(1000);
+    algorithm.reduceGraph = true;
+    std::ostringstream log;
+    auto result = algorithm.perform(strategies, G, 9, 20, 20, 2, &log)[0];
+    EXPECT_THAT(log.str(), ::testing::HasSubstr("Reduced graph to "));
+    ASSERT_EQ(result.s.size(), G.number_of_nodes());
+    EXPECT_TRUE(isFullyColoured(result.s));
+    EXPECT_EQ(numberOfConflictingEdges(G, result.s), 0);
+    EXPECT_LE(colorCount(result.s), 9);
+}
+
+TEST(GraphColouring, TimeLimitAndCallback) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/DSJC250.5-sorted.graph");
+
+    std::vector<std::unique_ptr<ColouringStrategy>> strategies;
+    strategies.push_back(hcaStrategy(50, 10, 0.6));
+
+    ColouringAlgorithm algorithm;
+    algorithm.cliqueTimeLimit = std::chrono::milliseconds(0);
+    algorithm.timeLimit = std::chrono::milliseconds(1000);
+    algorithm.seed = 7;
+    std::vector<ColorCount> found;
+    algorithm.onColouringFound = [&found](ColorCount k, size_t) {
+        found.push_back(k);
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    auto result = algorithm.perform(strategies, G, 40, 20, std::numeric_limits<size_t>::max(), 2)[0];
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(elapsed, std::chrono::seconds(10));
+    ASSERT_FALSE(found.empty());
+    EXPECT_TRUE(std::is_sorted(found.rbegin(), found.rend()));
+    ASSERT_EQ(result.s.size(), G.number_of_nodes());
+    EXPECT_EQ(numberOfConflictingEdges(G, result.s), 0);
+    EXPECT_EQ(colorCount(result.s), found.back());
+}
+
+TEST(GraphColouring, ValidColouringCallbackAndStop) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/DSJC250.5-sorted.graph");
+
+    std::vector<std::unique_ptr<ColouringStrategy>> strategies;
+    strategies.push_back(hcaStrategy(50, 10, 0.6));
+
+    ColouringAlgorithm algorithm;
+    algorithm.seed = 7;
+    std::vector<ColorCount> found;
+    std::vector<Colouring> reported;
+    algorithm.onColouringFound = [&found](ColorCount k, size_t) {
+        found.push_back(k);
+    };
+    algorithm.onValidColouring = [&](const Colouring &s, size_t) {
+        reported.push_back(s);
+        algorithm.stop();
+    };
+
+    //Without the stop, the search would continue with ever smaller k
+    auto start = std::chrono::steady_clock::now();
+    auto result = algorithm.perform(strategies, G, 40, 20, std::numeric_limits<size_t>::max(), 2)[0];
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(elapsed, std::chrono::seconds(60));
+    ASSERT_FALSE(reported.empty());
+    ASSERT_EQ(reported.size(), found.size());
+    for (size_t i = 0; i < reported.size(); i++) {
+        ASSERT_EQ(reported[i].size(), G.number_of_nodes());
+        EXPECT_EQ(numberOfConflictingEdges(G, reported[i]), 0);
+        EXPECT_LE(colorCount(reported[i]), found[i]);
+    }
+    EXPECT_EQ(numberOfConflictingEdges(G, result.s), 0);
+    EXPECT_LE(colorCount(result.s), colorCount(reported[0]));
+}
+
+TEST(GraphColouring, InstrumentationStats) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/miles250-sorted.graph");
+
+    std::vector<std::unique_ptr<ColouringStrategy>> strategies;
+    strategies.push_back(hcaStrategy(5, 2, 0.6));
+
+    ColouringAlgorithm algorithm;
+    algorithm.cliqueTimeLimit = std::chrono::milliseconds(0);
+    algorithm.reduceGraph = false;
+    auto result = algorithm.perform(strategies, G, 9, 20, 5, 2)[0];
+    auto &stats = result.stats;
+#ifdef COLOURING_INSTRUMENTATION
+    EXPECT_TRUE(stats.enabled);
+    EXPECT_GE(stats.calls[REGION_INIT], 20);
+    EXPECT_GT(stats.calls[REGION_CROSSOVER], 0);
+    EXPECT_EQ(stats.calls[REGION_LOCAL_SEARCH], stats.calls[REGION_INIT] + stats.calls[REGION_CROSSOVER]);
+    EXPECT_EQ(stats.calls[REGION_COMPARE], stats.calls[REGION_CROSSOVER]);
+    EXPECT_EQ(stats.calls[REGION_IS_SOLUTION], stats.calls[REGION_LOCAL_SEARCH]);
+    EXPECT_EQ(stats.packages, stats.calls[REGION_LOCAL_SEARCH]);
+    EXPECT_EQ(stats.parentSelections, 2 * stats.calls[REGION_CROSSOVER]);
+    EXPECT_EQ(stats.calls[REGION_CHOOSE_PARENT], stats.parentSelections);
+    EXPECT_GE(stats.calls[REGION_QUEUE], stats.packages);
+    EXPECT_GT(stats.seconds[REGION_INIT], 0.0);
+#else
+    EXPECT_FALSE(stats.enabled);
+    EXPECT_EQ(stats.packages, 0);
+    EXPECT_EQ(stats.calls[REGION_INIT], 0);
+#endif
+}
+
+TEST(GraphColouring, TraceFile) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/miles250-sorted.graph");
+
+    std::vector<std::unique_ptr<ColouringStrategy>> strategies;
+    strategies.push_back(hcaStrategy(5, 2, 0.6));
+
+    ColouringAlgorithm algorithm;
+    algorithm.cliqueTimeLimit = std::chrono::milliseconds(0);
+    algorithm.reduceGraph = false;
+    algorithm.traceFile = "graph_colouring_test_trace.json";
+    algorithm.perform(strategies, G, 9, 20, 5, 2);
+
+    std::ifstream in(algorithm.traceFile.c_str());
+    std::stringstream ss;
+    ss << in.rdbuf();
+    auto trace = ss.str();
+    EXPECT_THAT(trace, ::testing::HasSubstr("\"traceEvents\""));
+    EXPECT_THAT(trace, ::testing::HasSubstr("\"name\": \"master\""));
+    EXPECT_THAT(trace, ::testing::HasSubstr("\"name\": \"worker 1\""));
+    EXPECT_THAT(trace, ::testing::HasSubstr("{\"name\": \"init\""));
+    EXPECT_THAT(trace, ::testing::HasSubstr("{\"name\": \"generation\""));
+    EXPECT_THAT(trace, ::testing::HasSubstr("{\"name\": \"choose_parents\""));
+}
+
+TEST(GraphColouring, PinnedThreads) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/miles250-sorted.graph");
+
+    std::vector<std::unique_ptr<ColouringStrategy>> strategies;
+    strategies.push_back(hcaStrategy(5, 2, 0.6));
+
+    ColouringAlgorithm algorithm;
+    algorithm.pinThreads = true;
+    auto result = algorithm.perform(strategies, G, 9, 20, 5, 3)[0];
+    EXPECT_TRUE(result.isValid);
+    EXPECT_EQ(numberOfConflictingEdges(G, result.s), 0);
+    EXPECT_LE(colorCount(result.s), 9);
+}
+
+TEST(GraphColouring, NumaAwareReplicatedGraph) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/miles250-sorted.graph");
+
+    std::vector<std::unique_ptr<ColouringStrategy>> strategies;
+    strategies.push_back(hcaStrategy(5, 2, 0.6));
+
+    ColouringAlgorithm algorithm;
+    algorithm.numaAware = true;
+    algorithm.replicateGraph = true;
+    algorithm.reduceGraph = false;
+    auto result = algorithm.perform(strategies, G, 9, 20, 5, 3)[0];
+    EXPECT_TRUE(result.isValid);
+    EXPECT_EQ(numberOfConflictingEdges(G, result.s), 0);
+    EXPECT_LE(colorCount(result.s), 9);
+}
+
+TEST(GraphColouring, DeterministicRuns) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/miles250-sorted.graph");
+
+    std::vector<std::unique_ptr<ColouringStrategy>> strategies;
+    strategies.push_back(hcaStrategy(5, 2, 0.6));
+
+    auto run = [&](std::vector<ColorCount> &found) {
+        ColouringAlgorithm algorithm;
+        algorithm.deterministic = true;
+        algorithm.seed = 3;
+        //The clique search is limited by cliqueStepLimit instead
+        algorithm.cliqueTimeLimit = std::chrono::milliseconds(1);
+        algorithm.onColouringFound = [&found](ColorCount k, size_t) {
+            found.push_back(k);
+        };
+        return algorithm.perform(strategies, G, 12, 20, 10, 4)[0];
+    };
+    std::vector<ColorCount> firstFound, secondFound;
+    auto first = run(firstFound);
+    auto second = run(secondFound);
+    EXPECT_TRUE(first.isValid);
+    EXPECT_FALSE(firstFound.empty());
+    EXPECT_EQ(firstFound, secondFound);
+    EXPECT_EQ(first.s, second.s);
+}
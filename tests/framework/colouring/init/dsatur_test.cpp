@@ -0,0 +1,45 @@
+#include "colouring/init/dsatur.h"
+#include "data_structure/io/graph_io.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+using namespace graph_colouring;
+
+TEST(GraphColouringDSatur, SimpleGraph) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/simple.graph");
+
+    //Order: 1 (highest degree), 5, 0 (saturation 2), 2, 3, 4. The triangle 0 1 5 needs three colours.
+    EXPECT_EQ(dsaturColouring(G), Colouring({2, 0, 1, 0, 2, 1}));
+}
+
+TEST(GraphColouringDSatur, EvenCycle) {
+    //DSatur is optimal on bipartite graphs
+    graph_access G;
+    G.start_construction(8, 16);
+    for (NodeID n = 0; n < 8; n++) {
+        G.new_node();
+        G.new_edge(n, (n + 7) % 8);
+        G.new_edge(n, (n + 1) % 8);
+    }
+    G.finish_construction();
+
+    auto s = dsaturColouring(G);
+    EXPECT_EQ(numberOfConflictingEdges(G, s), 0);
+    EXPECT_EQ(colorCount(s), 2);
+}
+
+TEST(GraphColouringDSatur, DSJC250) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/DSJC250.5-sorted.graph");
+
+    auto s = dsaturColouring(G);
+    ASSERT_EQ(s.size(), G.number_of_nodes());
+    EXPECT_EQ(std::count(s.begin(), s.end(), UNCOLORED), 0);
+    EXPECT_EQ(numberOfConflictingEdges(G, s), 0);
+    //The chromatic number is 28, DSatur typically needs about 40 colours
+    EXPECT_GE(colorCount(s), 28);
+    EXPECT_LE(colorCount(s), 45);
+}
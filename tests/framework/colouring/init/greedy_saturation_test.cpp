@@ -19,4 +19,18 @@ TEST(GraphColouringGreedySaturation, SimpleGraph) {
     ASSERT_EQ(s_init[3], 1);
     ASSERT_EQ(s_init[4], 0);
     ASSERT_EQ(s_init[5], 2);
-}
\ No newline at end of file
+}
+
+TEST(GraphColouringGreedySaturation, SeededGenerator) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/DSJC250.5-sorted.graph");
+
+    //With too few colours, the remaining nodes are coloured randomly
+    std::mt19937 generator(42);
+    auto first = graph_colouring::initByGreedySaturation(G, 10, generator);
+    auto second = graph_colouring::initByGreedySaturation(G, 10, generator);
+    EXPECT_NE(first, second);
+
+    std::mt19937 reseeded(42);
+    EXPECT_EQ(graph_colouring::initByGreedySaturation(G, 10, reseeded), first);
+}
@@ -401,8 +401,8 @@ TEST(XRLF, SubgraphInit) {
     ASSERT_EQ(s.getNumberOfNodes(), G.number_of_nodes());
     ASSERT_EQ(s.getNodes().size(), G.number_of_nodes());
     auto nodes = s.getNodes();
-    NodeID minDegree = std::numeric_limits<NodeID>::max();
-    NodeID maxDegree = 0;
+    EdgeID minDegree = std::numeric_limits<EdgeID>::max();
+    EdgeID maxDegree = 0;
     for (auto n_ = nodes.begin(); n_ != nodes.end(); ++n_) {
         NodeID node = *n_;
         ASSERT_TRUE(node < G.number_of_nodes());
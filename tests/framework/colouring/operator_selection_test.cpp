@@ -0,0 +1,73 @@
+#include "colouring/operator_selection.h"
+#include "colouring/graph_colouring.h"
+
+#include "data_structure/io/graph_io.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+using namespace graph_colouring;
+
+TEST(OperatorSelector, UniformWithoutRewards) {
+    OperatorSelector selector(4);
+    for (size_t i = 0; i < selector.size(); i++) {
+        EXPECT_DOUBLE_EQ(selector.probability(i), 0.25);
+    }
+
+    std::mt19937 generator(1);
+    std::vector<size_t> selections(selector.size());
+    for (size_t i = 0; i < 4000; i++) {
+        selections[selector.select(generator)]++;
+    }
+    for (auto count : selections) {
+        EXPECT_GT(count, 800);
+    }
+}
+
+TEST(OperatorSelector, PrefersProductiveOperators) {
+    OperatorSelector selector(3, 0.05, 0.5);
+    for (size_t i = 0; i < 10; i++) {
+        selector.reward(0, 10, std::chrono::milliseconds(1));
+        selector.reward(1, 10, std::chrono::milliseconds(10));
+        selector.reward(2, -5, std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(selector.applications(0), 10);
+    EXPECT_GT(selector.quality(0), selector.quality(1));
+    EXPECT_DOUBLE_EQ(selector.quality(2), 0);
+
+    EXPECT_GT(selector.probability(0), selector.probability(1));
+    EXPECT_DOUBLE_EQ(selector.probability(2), 0.05);
+    EXPECT_NEAR(selector.probability(0) + selector.probability(1) + selector.probability(2), 1.0, 1e-9);
+
+    std::mt19937 generator(1);
+    std::vector<size_t> selections(selector.size());
+    for (size_t i = 0; i < 1000; i++) {
+        selections[selector.select(generator)]++;
+    }
+    EXPECT_GT(selections[0], selections[1]);
+    EXPECT_GT(selections[2], 0);
+}
+
+TEST(OperatorSelector, RewardScoreAgainstBaseline) {
+    OperatorSelector selector(2, 0.0, 0.5);
+    selector.rewardScore(0, -100, std::chrono::milliseconds(1));
+    selector.rewardScore(1, -10, std::chrono::milliseconds(1));
+    EXPECT_DOUBLE_EQ(selector.quality(0), 0);
+    EXPECT_GT(selector.quality(1), 0);
+    EXPECT_DOUBLE_EQ(selector.probability(1), 1.0);
+}
+
+TEST(ColouringStrategy, ScoreMatchesCompare) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/simple.graph");
+
+    Colouring valid = {0, 1, 0, 1, 0, 2};
+    Colouring invalid = {0, 0, 0, 0, 0, 1};
+
+    FixedKColouringStrategy fixedK;
+    EXPECT_EQ(fixedK.score(G, valid), 0);
+    EXPECT_EQ(fixedK.score(G, invalid), -4);
+    EXPECT_EQ(fixedK.compare(G, invalid, valid), fixedK.score(G, invalid) < fixedK.score(G, valid));
+    EXPECT_EQ(fixedK.compare(G, valid, invalid), fixedK.score(G, valid) < fixedK.score(G, invalid));
+}
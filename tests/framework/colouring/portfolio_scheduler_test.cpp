@@ -0,0 +1,81 @@
+#include "colouring/portfolio_scheduler.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+using namespace graph_colouring;
+
+TEST(PortfolioScheduler, RoundRobinWithoutMeasurements) {
+    PortfolioScheduler scheduler(3, 6);
+    EXPECT_EQ(scheduler.threadsOf(0), 2);
+    EXPECT_EQ(scheduler.threadsOf(1), 2);
+    EXPECT_EQ(scheduler.threadsOf(2), 2);
+
+    scheduler.rebalance({true, true, true});
+    EXPECT_EQ(scheduler.threadsOf(0), 2);
+    EXPECT_EQ(scheduler.threadsOf(1), 2);
+    EXPECT_EQ(scheduler.threadsOf(2), 2);
+}
+
+TEST(PortfolioScheduler, StarvesStalledStrategies) {
+    PortfolioScheduler scheduler(3, 8);
+    for (size_t i = 0; i < 100; i++) {
+        scheduler.recordGeneration(0, true, std::chrono::milliseconds(1));
+        scheduler.recordGeneration(1, i % 4 == 0, std::chrono::milliseconds(1));
+        scheduler.recordGeneration(2, false, std::chrono::milliseconds(1));
+    }
+    scheduler.rebalance({true, true, true});
+    EXPECT_GT(scheduler.improvementRate(0), scheduler.improvementRate(1));
+    EXPECT_EQ(scheduler.threadsOf(0) + scheduler.threadsOf(1) + scheduler.threadsOf(2), 8);
+    EXPECT_GT(scheduler.threadsOf(0), scheduler.threadsOf(1));
+    EXPECT_GT(scheduler.threadsOf(1), 0);
+    EXPECT_EQ(scheduler.threadsOf(2), 0);
+}
+
+TEST(PortfolioScheduler, RemeasuresStarvedStrategies) {
+    PortfolioScheduler scheduler(2, 4);
+    for (size_t i = 0; i < 100; i++) {
+        scheduler.recordGeneration(0, true, std::chrono::milliseconds(1));
+        scheduler.recordGeneration(1, false, std::chrono::milliseconds(1));
+    }
+    scheduler.rebalance({true, true});
+    ASSERT_EQ(scheduler.threadsOf(1), 0);
+
+    //Strategy 1 does not run without threads, while strategy 0 keeps improving
+    size_t rounds = 0;
+    while (scheduler.threadsOf(1) == 0 && rounds < 10) {
+        scheduler.recordGeneration(0, true, std::chrono::milliseconds(1));
+        scheduler.rebalance({true, true});
+        rounds++;
+    }
+    EXPECT_GT(scheduler.threadsOf(1), 0);
+    EXPECT_GT(scheduler.threadsOf(0), 0);
+
+    //Once it has been measured without improvements again, it is starved again
+    for (size_t i = 0; i < 3; i++) {
+        scheduler.recordGeneration(0, true, std::chrono::milliseconds(1));
+        scheduler.recordGeneration(1, false, std::chrono::milliseconds(1));
+        scheduler.rebalance({true, true});
+    }
+    EXPECT_EQ(scheduler.threadsOf(1), 0);
+}
+
+TEST(PortfolioScheduler, PrefersStrategyLoweringK) {
+    PortfolioScheduler scheduler(2, 4);
+    for (size_t i = 0; i < 10; i++) {
+        scheduler.recordGeneration(0, true, std::chrono::milliseconds(1));
+        scheduler.recordGeneration(1, true, std::chrono::milliseconds(1));
+    }
+    scheduler.reportColouring(1);
+    scheduler.rebalance({true, true});
+    EXPECT_GT(scheduler.threadsOf(1), scheduler.threadsOf(0));
+}
+
+TEST(PortfolioScheduler, IgnoresInactiveStrategies) {
+    PortfolioScheduler scheduler(2, 4);
+    scheduler.recordGeneration(0, true, std::chrono::milliseconds(1));
+    scheduler.rebalance({false, true});
+    EXPECT_EQ(scheduler.threadsOf(0), 0);
+    EXPECT_EQ(scheduler.threadsOf(1), 4);
+}
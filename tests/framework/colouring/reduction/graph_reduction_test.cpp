@@ -0,0 +1,65 @@
+#include "colouring/reduction/graph_reduction.h"
+
+#include "data_structure/io/graph_io.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+#include <colouring/init/xrlf.h>
+
+using namespace graph_colouring;
+
+TEST(GraphReduction, PeelsLowDegreeNodes) {
+    graph_access G;
+    std::string graph_filename = "../../input/simple.graph";
+    graph_io::readGraphWeighted(G, graph_filename);
+
+    GraphReduction reduction(G, 3);
+    EXPECT_EQ(reduction.removedNodes(), 6);
+    EXPECT_EQ(reduction.kernel().number_of_nodes(), 0);
+
+    auto s = reduction.lift(Colouring());
+    EXPECT_TRUE(isFullyColoured(s));
+    EXPECT_EQ(numberOfConflictingEdges(G, s), 0);
+    EXPECT_EQ(colorCount(s), 3);
+}
+
+TEST(GraphReduction, RemovesDominatedNodes) {
+    //Path 0 - 1 - 2: N(0) is a subset of N(2)
+    graph_access G;
+    G.start_construction(3, 4);
+    G.new_node();
+    G.new_edge(0, 1);
+    G.new_node();
+    G.new_edge(1, 0);
+    G.new_edge(1, 2);
+    G.new_node();
+    G.new_edge(2, 1);
+    G.finish_construction();
+
+    GraphReduction reduction(G, 0);
+    EXPECT_EQ(reduction.removedNodes(), 1);
+    EXPECT_EQ(reduction.kernel().number_of_nodes(), 2);
+
+    auto s = reduction.lift({4, 7});
+    EXPECT_THAT(s, testing::ElementsAre(1, 0, 1));
+}
+
+TEST(GraphReduction, Miles250) {
+    graph_access G;
+    std::string graph_filename = "../../input/miles250-sorted.graph";
+    graph_io::readGraphWeighted(G, graph_filename);
+
+    GraphReduction reduction(G, 8);
+    auto &kernel = reduction.kernel();
+    EXPECT_GT(reduction.removedNodes(), 0);
+    EXPECT_EQ(reduction.removedNodes() + kernel.number_of_nodes(), G.number_of_nodes());
+
+    auto kernelColouring = initByXRLFIgnored(kernel, 0);
+    ASSERT_EQ(numberOfConflictingEdges(kernel, kernelColouring), 0);
+    auto s = reduction.lift(kernelColouring);
+    EXPECT_TRUE(isFullyColoured(s));
+    EXPECT_EQ(numberOfConflictingEdges(G, s), 0);
+    EXPECT_LE(colorCount(s), std::max<ColorCount>(colorCount(kernelColouring), 8));
+}
@@ -0,0 +1,115 @@
+#include "colouring/repair.h"
+#include "colouring/init/dsatur.h"
+#include "data_structure/io/graph_io.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+#include <random>
+
+using namespace graph_colouring;
+
+static void expectValid(const dynamic_graph_access &D, const IncrementalColouring &colouring) {
+    graph_access G;
+    D.to_graph_access(G);
+    auto &s = colouring.colouring();
+    ASSERT_EQ(s.size(), G.number_of_nodes());
+    EXPECT_EQ(numberOfConflictingEdges(G, s), 0);
+    EXPECT_EQ(std::count(s.begin(), s.end(), UNCOLORED), 0);
+    //the colours are 0, ..., k - 1
+    EXPECT_EQ(colorCount(s), colouring.colours());
+    EXPECT_LT(*std::max_element(s.begin(), s.end()), colouring.colours());
+}
+
+TEST(IncrementalColouring, CompleteGraph) {
+    //K5 without the edges of node 4
+    graph_access G;
+    G.start_construction(5, 12);
+    for (NodeID n = 0; n < 5; n++) {
+        G.new_node();
+        for (NodeID m = 0; m < 4; m++) {
+            if (n < 4 && m != n) {
+                G.new_edge(n, m);
+            }
+        }
+    }
+    G.finish_construction();
+
+    dynamic_graph_access D(G);
+    IncrementalColouring colouring(D, {0, 1, 2, 3, 0});
+    EXPECT_EQ(colouring.colours(), 4);
+
+    auto stats = colouring.insertEdges({{4, 0}, {4, 1}, {4, 2}, {4, 3}});
+    EXPECT_EQ(stats.conflictingNodes, 1);
+    EXPECT_EQ(stats.k, 5);
+    expectValid(D, colouring);
+
+    stats = colouring.removeEdges({{4, 0}, {4, 1}});
+    EXPECT_EQ(stats.k, 4);
+    EXPECT_GE(stats.recolouredNodes, 1);
+    expectValid(D, colouring);
+}
+
+TEST(IncrementalColouring, Triangle) {
+    graph_access G;
+    G.start_construction(4, 6);
+    for (NodeID n = 0; n < 4; n++) {
+        G.new_node();
+    }
+    G.new_edge(0, 1);
+    G.new_edge(1, 0);
+    G.new_edge(1, 2);
+    G.new_edge(2, 1);
+    G.new_edge(2, 3);
+    G.new_edge(3, 2);
+    G.finish_construction();
+
+    //path 0 - 1 - 2 - 3 coloured 0 1 0 1: the edge {0, 2} closes the triangle 0 1 2
+    dynamic_graph_access D(G);
+    IncrementalColouring colouring(D, {0, 1, 0, 1});
+    auto stats = colouring.insertEdges({{0, 2}});
+    EXPECT_EQ(stats.conflictingNodes, 1);
+    EXPECT_EQ(stats.k, 3);
+    expectValid(D, colouring);
+
+    //the path is bipartite again
+    stats = colouring.removeEdges({{0, 2}});
+    EXPECT_EQ(stats.k, 2);
+    expectValid(D, colouring);
+}
+
+TEST(IncrementalColouring, RandomUpdates) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/DSJC250.5-sorted.graph");
+    dynamic_graph_access D(G);
+    auto initial = dsaturColouring(G);
+    IncrementalColouring colouring(D, initial);
+    EXPECT_EQ(colouring.colours(), colorCount(initial));
+
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<NodeID> node(0, G.number_of_nodes() - 1);
+    std::vector<std::pair<NodeID, NodeID>> added;
+    for (int round = 0; round < 30; round++) {
+        std::vector<std::pair<NodeID, NodeID>> edges;
+        for (int i = 0; i < 10; i++) {
+            edges.emplace_back(node(generator), node(generator));
+        }
+        auto before = colouring.colours();
+        auto stats = colouring.insertEdges(edges);
+        //at most one new colour per conflicting node
+        EXPECT_LE(stats.k, before + stats.conflictingNodes);
+        EXPECT_LE(stats.conflictingNodes, 10);
+        expectValid(D, colouring);
+        added.insert(added.end(), edges.begin(), edges.end());
+    }
+    auto grown = colouring.colours();
+    //removing the inserted edges must not need more colours
+    for (size_t i = 0; i < added.size(); i += 20) {
+        std::vector<std::pair<NodeID, NodeID>> edges(added.begin() + i,
+                                                     added.begin() + std::min(added.size(), i + 20));
+        colouring.removeEdges(edges);
+        expectValid(D, colouring);
+        EXPECT_LE(colouring.colours(), grown);
+    }
+}
@@ -0,0 +1,55 @@
+#include "colouring/tracing.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+#include <fstream>
+#include <sstream>
+
+using namespace graph_colouring;
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+static std::string readFile(const std::string &filename) {
+    std::ifstream in(filename.c_str());
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+TEST(Tracer, WritesChromeTraceEvents) {
+    Tracer tracer(16);
+    auto *buffer = tracer.createBuffer(tracer.newProcess(), 3, "worker 3");
+    {
+        TraceScope scope(&tracer, buffer, "generation", 1, 42);
+    }
+    TraceScope disabled(&tracer, nullptr, "ignored");
+
+    ASSERT_EQ(tracer.write("tracing_test.json"), 0);
+    auto trace = readFile("tracing_test.json");
+    EXPECT_THAT(trace, HasSubstr("\"traceEvents\""));
+    EXPECT_THAT(trace, HasSubstr("\"args\": {\"name\": \"worker 3\"}"));
+    EXPECT_THAT(trace, HasSubstr("{\"name\": \"generation\", \"ph\": \"X\", \"pid\": 0, \"tid\": 3"));
+    EXPECT_THAT(trace, HasSubstr("\"args\": {\"strategy\": 1, \"value\": 42}"));
+    EXPECT_THAT(trace, Not(HasSubstr("ignored")));
+}
+
+TEST(Tracer, KeepsNewestEvents) {
+    Tracer tracer(4);
+    auto *buffer = tracer.createBuffer(tracer.newProcess(), 0, "worker 0");
+    for (uint64_t i = 0; i < 10; i++) {
+        buffer->record({"event", i, i + 1, 0, i});
+    }
+
+    ASSERT_EQ(tracer.write("tracing_test.json"), 0);
+    auto trace = readFile("tracing_test.json");
+    for (uint64_t i = 0; i < 10; i++) {
+        auto args = "\"value\": " + std::to_string(i) + "}";
+        if (i < 6) {
+            EXPECT_THAT(trace, Not(HasSubstr(args)));
+        } else {
+            EXPECT_THAT(trace, HasSubstr(args));
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#include "colouring/verification.h"
+
+#include "data_structure/io/graph_io.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+#include <random>
+
+using namespace graph_colouring;
+
+TEST(AnalyzeColouring, SimpleGraph) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/simple.graph");
+
+    auto stats = analyzeColouring(G, {0, 1, 0, 1, 0, 2});
+    EXPECT_EQ(stats.conflictingEdges, 0);
+    EXPECT_EQ(stats.conflictingNodes, 0);
+    EXPECT_EQ(stats.uncolouredNodes, 0);
+    EXPECT_EQ(stats.k, 3);
+    EXPECT_THAT(stats.classSizes, testing::ElementsAre(3, 2, 1));
+    EXPECT_EQ(stats.squaredClassSizes, 14);
+    EXPECT_TRUE(stats.isValid());
+
+    stats = analyzeColouring(G, {0, 0, 0, 0, 0, 1});
+    EXPECT_EQ(stats.conflictingEdges, 4);
+    EXPECT_EQ(stats.conflictingNodes, 5);
+    EXPECT_FALSE(stats.isValid());
+}
+
+TEST(AnalyzeColouring, PartialSparseColouring) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/simple.graph");
+
+    //Uncoloured neighbours do not conflict
+    auto stats = analyzeColouring(G, {UNCOLORED, UNCOLORED, 9, 4, UNCOLORED, 9});
+    EXPECT_EQ(stats.conflictingEdges, 0);
+    EXPECT_EQ(stats.uncolouredNodes, 3);
+    EXPECT_EQ(stats.k, 2);
+    EXPECT_EQ(stats.classSizes.size(), 10);
+    EXPECT_EQ(stats.classSizes[9], 2);
+    EXPECT_FALSE(stats.isValid());
+}
+
+TEST(AnalyzeColouring, MatchesSeparatePasses) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/DSJC1000.5-sorted.graph");
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<Color> distribution(0, 99);
+    Colouring s(G.number_of_nodes());
+    for (auto &color : s) {
+        color = distribution(generator);
+    }
+    for (size_t threadCount : {1, 3, 8}) {
+        auto stats = analyzeColouring(G, s, threadCount);
+        EXPECT_EQ(stats.conflictingEdges, numberOfConflictingEdges(G, s));
+        EXPECT_EQ(stats.conflictingNodes, numberOfConflictingNodes(G, s));
+        EXPECT_EQ(stats.k, colorCount(s));
+        EXPECT_EQ(-stats.squaredClassSizes, squaredColorClassSizes(s));
+        EXPECT_EQ(stats.uncolouredNodes, 0);
+    }
+}
@@ -0,0 +1,227 @@
+#include "service/colouring_service.h"
+#include "data_structure/io/graph_cache.h"
+#include "data_structure/io/graph_io.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+using namespace graph_colouring;
+
+static std::string readFile(const std::string &filename) {
+    std::ifstream in(filename.c_str(), std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+/**
+ * Runs a service on a socket in the working directory until the end of the scope
+ */
+class ColouringServiceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(service.listen(socketPath), 0);
+        server = std::thread([this] { service.serve(); });
+    }
+
+    void TearDown() override {
+        service.stop();
+        if (server.joinable()) {
+            server.join();
+        }
+    }
+
+    std::vector<ServiceMessage> request(const ServiceRequest &request, int expectedStatus = 0) {
+        std::vector<ServiceMessage> messages;
+        EXPECT_EQ(requestColouring(socketPath, request, [&](const ServiceMessage &message) {
+            messages.push_back(message);
+        }), expectedStatus);
+        return messages;
+    }
+
+    const std::string socketPath = "colouring_service_test.sock";
+    ColouringService service{2, 2};
+    std::thread server;
+};
+
+TEST_F(ColouringServiceTest, StreamsColourings) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/miles250-sorted.graph");
+
+    ServiceRequest hca;
+    hca.payload = readFile("../../input/miles250-sorted.graph");
+    hca.k = 10;
+    hca.maxItr = 20;
+    hca.L = 20;
+    hca.threadCount = 2;
+    hca.deadline = 10000;
+    auto messages = request(hca);
+    ASSERT_GE(messages.size(), 3);
+    EXPECT_EQ(messages.front().type, "GRAPH");
+    EXPECT_EQ(messages.front().nodes, G.number_of_nodes());
+    EXPECT_EQ(messages.front().edges, G.number_of_edges() / 2);
+    EXPECT_EQ(messages.back().type, "DONE");
+
+    ColorCount lastK = std::numeric_limits<ColorCount>::max();
+    //the colouring of every improving FOUND message is streamed right after it
+    ColorCount pendingK = lastK;
+    for (auto &message : messages) {
+        if (message.type == "FOUND" && message.k < lastK) {
+            pendingK = std::min(pendingK, message.k);
+        }
+        if (message.type == "COLOURING") {
+            ASSERT_EQ(message.s.size(), G.number_of_nodes());
+            EXPECT_EQ(numberOfConflictingEdges(G, message.s), 0);
+            EXPECT_EQ(colorCount(message.s), message.k);
+            EXPECT_LT(message.k, lastK);
+            lastK = message.k;
+            EXPECT_LE(lastK, pendingK);
+            pendingK = std::numeric_limits<ColorCount>::max();
+        }
+    }
+    EXPECT_EQ(pendingK, std::numeric_limits<ColorCount>::max());
+    EXPECT_EQ(messages.back().k, lastK);
+    //the chromatic number of miles250 is 8
+    EXPECT_GE(lastK, 8);
+
+    //the graph is kept by the service
+    ServiceRequest dsatur;
+    dsatur.algorithm = "dsatur";
+    dsatur.graphId = messages.front().graphId;
+    auto cached = request(dsatur);
+    ASSERT_EQ(cached.size(), 3);
+    EXPECT_EQ(cached[0].graphId, dsatur.graphId);
+    EXPECT_EQ(cached[1].type, "COLOURING");
+    EXPECT_EQ(service.cachedGraphs(), 1);
+}
+
+TEST_F(ColouringServiceTest, StreamsImprovementsDuringSearch) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/xrlf/50.5.1.graph");
+
+    ServiceRequest hca;
+    hca.payload = readFile("../../input/xrlf/50.5.1.graph");
+    hca.maxItr = 100;
+    hca.L = 200;
+    hca.threadCount = 2;
+    hca.seed = 1;
+    hca.deadline = 3000;
+    auto messages = request(hca);
+    ASSERT_GE(messages.size(), 3);
+    EXPECT_EQ(messages.back().type, "DONE");
+
+    //the DSatur colouring is improved by hca, which streams its colourings before the deadline ends the search
+    std::vector<ServiceMessage> colourings;
+    for (auto &message : messages) {
+        if (message.type == "COLOURING") {
+            colourings.push_back(message);
+        }
+    }
+    ASSERT_GE(colourings.size(), 2);
+    EXPECT_LT(colourings[1].k, colourings[0].k);
+    EXPECT_LT(colourings[1].milliseconds, hca.deadline);
+    EXPECT_EQ(numberOfConflictingEdges(G, colourings[1].s), 0);
+}
+
+TEST_F(ColouringServiceTest, BinaryGraphs) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/xrlf/50.5.1.graph");
+    ASSERT_EQ(graph_io::writeGraphBinary(G, "colouring_service_test.csr"), 0);
+
+    ServiceRequest batch;
+    batch.algorithm = "batch";
+    batch.format = "csr";
+    batch.payload = readFile("colouring_service_test.csr");
+    auto messages = request(batch);
+    ASSERT_EQ(messages.size(), 3);
+    EXPECT_EQ(messages[1].type, "COLOURING");
+    EXPECT_EQ(numberOfConflictingEdges(G, messages[1].s), 0);
+    EXPECT_EQ(messages[2].type, "DONE");
+
+    ServiceRequest file;
+    file.algorithm = "dsatur";
+    file.format = "file";
+    file.payload = "../../input/miles250-sorted.graph";
+    EXPECT_EQ(request(file).back().type, "DONE");
+
+    ServiceRequest metis;
+    metis.algorithm = "dsatur";
+    metis.payload = "2 1\n2\n1\n";
+    EXPECT_EQ(request(metis).back().k, 2);
+    //at most two graphs are kept
+    EXPECT_EQ(service.cachedGraphs(), 2);
+}
+
+TEST_F(ColouringServiceTest, Errors) {
+    ServiceRequest malformed;
+    malformed.payload = "3 1\n2\n";
+    auto messages = request(malformed, 1);
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_EQ(messages[0].type, "ERROR");
+    EXPECT_EQ(messages[0].error, "malformed metis graph");
+
+    ServiceRequest unknownGraph;
+    unknownGraph.graphId = 42;
+    EXPECT_EQ(request(unknownGraph, 1)[0].error, "unknown graph 42");
+
+    ServiceRequest unknownAlgorithm;
+    unknownAlgorithm.algorithm = "foo";
+    unknownAlgorithm.payload = "2 1\n2\n1\n";
+    EXPECT_EQ(request(unknownAlgorithm, 1)[0].error, "unknown algorithm foo");
+
+    ServiceRequest malformedFile;
+    malformedFile.format = "file";
+    malformedFile.payload = "colouring_service_test.graph";
+    std::ofstream("colouring_service_test.graph") << "3 1\n2\n1\n";
+    EXPECT_EQ(request(malformedFile, 1)[0].error, "cannot read colouring_service_test.graph");
+
+    ServiceRequest longLine;
+    longLine.algorithm = std::string(1 << 13, 'a');
+    longLine.payload = "2 1\n2\n1\n";
+    EXPECT_EQ(request(longLine, 1)[0].type, "ERROR");
+
+    //the service is still running
+    ServiceRequest valid;
+    valid.algorithm = "dsatur";
+    valid.payload = "2 1\n2\n1\n";
+    EXPECT_EQ(request(valid).back().type, "DONE");
+
+    EXPECT_EQ(requestColouring("colouring_service_test_missing.sock", valid, [](const ServiceMessage &) {}), 1);
+}
+
+TEST(ColouringService, LimitsConnections) {
+    const std::string socketPath = "colouring_service_test_limit.sock";
+    ColouringService service(1, 1, 1);
+    ASSERT_EQ(service.listen(socketPath), 0);
+    std::thread server([&] { service.serve(); });
+
+    //an idle client occupies the only connection
+    int idle = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    ASSERT_EQ(connect(idle, reinterpret_cast<sockaddr *>(&address), sizeof(address)), 0);
+
+    ServiceRequest valid;
+    valid.algorithm = "dsatur";
+    valid.payload = "2 1\n2\n1\n";
+    std::vector<ServiceMessage> messages;
+    EXPECT_EQ(requestColouring(socketPath, valid, [&](const ServiceMessage &message) {
+        messages.push_back(message);
+    }), 1);
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_EQ(messages[0].error, "too many connections");
+
+    //closing the idle connection ends its request
+    close(idle);
+    service.stop();
+    server.join();
+}
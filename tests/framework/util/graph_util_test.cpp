@@ -3,6 +3,9 @@
 #include "util/graph_util.h"
 #include "data_structure/io/graph_io.h"
 
+#include <fstream>
+#include <sstream>
+
 TEST(GraphUtilToGraphvizStrig, SimpleGraph) {
     graph_access G;
     std::string graph_filename = "../../input/simple.graph";
@@ -81,4 +84,211 @@ TEST(GraphUtilToGraphvizStrigWithConfiguration, SimpleGraphWithPartitionFlag) {
             "}\n";
 
     EXPECT_EQ(graph_util::toGraphvizStrig(G, s, true), expected_graphviz_str);
-}
\ No newline at end of file
+}
+
+static std::string readFile(const std::string &filename) {
+    std::ifstream in(filename.c_str());
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+TEST(GraphUtilWriteGraphviz, MatchesGraphvizString) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/DSJC250.5-sorted.graph");
+    graph_colouring::Colouring s(G.number_of_nodes());
+    for (NodeID n = 0; n < G.number_of_nodes(); n++) {
+        s[n] = n % 7;
+    }
+
+    ASSERT_EQ(graph_util::writeGraphviz("graph_util_test.dot", G), 0);
+    EXPECT_EQ(readFile("graph_util_test.dot"), graph_util::toGraphvizStrig(G));
+
+    graph_util::GraphvizOptions options;
+    options.partitioned = true;
+    ASSERT_EQ(graph_util::writeGraphviz("graph_util_test.dot", G, s, options), 0);
+    EXPECT_EQ(readFile("graph_util_test.dot"), graph_util::toGraphvizStrig(G, s, true));
+}
+
+TEST(GraphUtilWriteGraphviz, ColourClassAndSample) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/simple.graph");
+
+    graph_colouring::Colouring s = {0, 0, 1, 1, UNCOLORED, 0};
+    graph_util::GraphvizOptions options;
+    options.label = "C";
+    options.colourClass = 0;
+    ASSERT_EQ(graph_util::writeGraphviz("graph_util_test.dot", G, s, options), 0);
+    const char *expected_graphviz_str =
+            "graph C {\n" \
+            "    0 [penwidth=3 color=\"0 0.5 0.5\"];\n" \
+            "    1 [penwidth=3 color=\"0 0.5 0.5\"];\n" \
+            "    5 [penwidth=3 color=\"0 0.5 0.5\"];\n" \
+            "    0 -- 1;\n" \
+            "    0 -- 5;\n" \
+            "    1 -- 5;\n" \
+            "}\n";
+    EXPECT_EQ(readFile("graph_util_test.dot"), expected_graphviz_str);
+
+    options = graph_util::GraphvizOptions();
+    options.sampleRate = 0.0;
+    ASSERT_EQ(graph_util::writeGraphviz("graph_util_test.dot", G, s, options), 0);
+    EXPECT_EQ(readFile("graph_util_test.dot"), "graph G {\n}\n");
+
+    options.sampleRate = 0.5;
+    ASSERT_EQ(graph_util::writeGraphviz("graph_util_test.dot", G, s, options), 0);
+    auto first = readFile("graph_util_test.dot");
+    ASSERT_EQ(graph_util::writeGraphviz("graph_util_test.dot", G, s, options), 0);
+    EXPECT_EQ(readFile("graph_util_test.dot"), first);
+}
+
+TEST(GraphUtilCopyGraph, DSJC250) {
+    graph_access G;
+    graph_io::readGraphWeighted(G, "../../input/DSJC250.5-sorted.graph");
+
+    graph_access copy;
+    graph_util::copyGraph(G, copy);
+    ASSERT_EQ(copy.number_of_nodes(), G.number_of_nodes());
+    ASSERT_EQ(copy.number_of_edges(), G.number_of_edges());
+    EXPECT_EQ(graph_util::toGraphvizStrig(copy), graph_util::toGraphvizStrig(G));
+}
+
+TEST(GraphUtilInducedSubgraph, SimpleGraph) {
+    graph_access G;
+    std::string graph_filename = "../../input/simple.graph";
+    graph_io::readGraphWeighted(G, graph_filename);
+
+    graph_access subgraph;
+    graph_util::inducedSubgraph(G, {5, 0, 1, 3}, subgraph);
+
+    const char *expected_graphviz_str =
+            "graph G {\n" \
+            "    0 -- 1;\n" \
+            "    0 -- 2;\n" \
+            "    1 -- 2;\n" \
+            "}\n";
+
+    EXPECT_EQ(subgraph.number_of_nodes(), 4);
+    EXPECT_EQ(subgraph.number_of_edges(), 6);
+    EXPECT_EQ(graph_util::toGraphvizStrig(subgraph), expected_graphviz_str);
+}
+
+
+TEST(GraphUtilConnectedComponents, SimpleGraph) {
+    graph_access G;
+    std::string graph_filename = "../../input/simple.graph";
+    graph_io::readGraphWeighted(G, graph_filename);
+
+    std::vector<NodeID> component;
+    EXPECT_EQ(graph_util::connectedComponents(G, component, 2), 1);
+    EXPECT_EQ(component, std::vector<NodeID>(6, 0));
+}
+
+
+TEST(GraphUtilConnectedComponents, DisconnectedGraph) {
+    //0 - 4 - 5    1 - 2    3    6
+    graph_access G;
+    G.start_construction(7, 6);
+    G.new_node();
+    G.new_edge(0, 4);
+    G.new_node();
+    G.new_edge(1, 2);
+    G.new_node();
+    G.new_edge(2, 1);
+    G.new_node();
+    G.new_node();
+    G.new_edge(4, 0);
+    G.new_edge(4, 5);
+    G.new_node();
+    G.new_edge(5, 4);
+    G.new_node();
+    G.finish_construction();
+
+    std::vector<NodeID> component;
+    EXPECT_EQ(graph_util::connectedComponents(G, component, 3), 4);
+    EXPECT_EQ(component, std::vector<NodeID>({0, 1, 1, 2, 0, 0, 3}));
+}
+
+
+TEST(GraphUtilNodeOrdering, SimpleGraph) {
+    graph_access G;
+    std::string graph_filename = "../../input/simple.graph";
+    graph_io::readGraphWeighted(G, graph_filename);
+
+    EXPECT_EQ(graph_util::nodeOrdering(G, graph_util::NodeOrdering::DEGREE_DESCENDING),
+              std::vector<NodeID>({1, 5, 0, 2, 3, 4}));
+    EXPECT_EQ(graph_util::nodeOrdering(G, graph_util::NodeOrdering::BREADTH_FIRST),
+              std::vector<NodeID>({1, 0, 2, 5, 3, 4}));
+    EXPECT_EQ(graph_util::nodeOrdering(G, graph_util::NodeOrdering::REVERSE_CUTHILL_MCKEE),
+              std::vector<NodeID>({1, 0, 2, 5, 3, 4}));
+}
+
+
+TEST(GraphUtilRelabel, SimpleGraph) {
+    graph_access G;
+    std::string graph_filename = "../../input/simple.graph";
+    graph_io::readGraphWeighted(G, graph_filename);
+
+    std::vector<NodeID> order = {5, 4, 3, 2, 1, 0};
+    graph_access relabeled;
+    graph_util::relabel(G, order, relabeled);
+
+    const char *expected_graphviz_str =
+            "graph G {\n" \
+            "    0 -- 1;\n" \
+            "    0 -- 4;\n" \
+            "    0 -- 5;\n" \
+            "    1 -- 2;\n" \
+            "    2 -- 3;\n" \
+            "    3 -- 4;\n" \
+            "    4 -- 5;\n" \
+            "}\n";
+    EXPECT_EQ(graph_util::toGraphvizStrig(relabeled), expected_graphviz_str);
+
+    graph_colouring::Colouring s = {2, 0, 1, 0, 1, 0};
+    EXPECT_EQ(graph_colouring::numberOfConflictingEdges(relabeled, s), 0);
+    auto original = graph_util::restoreOrder(s, order);
+    EXPECT_EQ(original, graph_colouring::Colouring({0, 1, 0, 1, 0, 2}));
+    EXPECT_EQ(graph_colouring::numberOfConflictingEdges(G, original), 0);
+}
+
+
+TEST(GraphUtilReadGraphReordered, Miles250) {
+    graph_access G;
+    std::string graph_filename = "../../input/miles250-sorted.graph";
+    graph_io::readGraphWeighted(G, graph_filename);
+
+    graph_access reordered;
+    std::vector<NodeID> order;
+    ASSERT_EQ(graph_util::readGraphReordered(reordered, graph_filename,
+                                             graph_util::NodeOrdering::REVERSE_CUTHILL_MCKEE, order), 0);
+    ASSERT_EQ(reordered.number_of_nodes(), G.number_of_nodes());
+    ASSERT_EQ(reordered.number_of_edges(), G.number_of_edges());
+    for (NodeID i = 0; i < order.size(); i++) {
+        EXPECT_EQ(reordered.getNodeDegree(i), G.getNodeDegree(order[i]));
+    }
+}
+
+
+TEST(Graph64BitEdges, SimpleGraph) {
+    graph_access G;
+    graph_access64 G64;
+    std::string graph_filename = "../../input/simple.graph";
+    ASSERT_EQ(graph_io::readGraphWeighted(G, graph_filename), 0);
+    ASSERT_EQ(graph_io::readGraphWeighted(G64, graph_filename), 0);
+
+    static_assert(sizeof(graph_access64::EdgeID) == 8, "graph_access64 must use 64 bit edge ids");
+    ASSERT_EQ(G64.number_of_nodes(), G.number_of_nodes());
+    ASSERT_EQ(G64.number_of_edges(), G.number_of_edges());
+    for (NodeID n = 0; n < G.number_of_nodes(); n++) {
+        std::vector<NodeID> neighbours;
+        std::vector<NodeID> neighbours64;
+        for (auto neighbour : G.neighbours(n)) {
+            neighbours.push_back(neighbour);
+        }
+        for (auto neighbour : G64.neighbours(n)) {
+            neighbours64.push_back(neighbour);
+        }
+        EXPECT_EQ(neighbours64, neighbours);
+    }
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include "util/thread_util.h"
+
+#include <algorithm>
+#include <thread>
+
+TEST(ThreadUtilAvailableCpus, SortedAndNotEmpty) {
+    auto cpus = thread_util::availableCpus();
+    ASSERT_FALSE(cpus.empty());
+    EXPECT_TRUE(std::is_sorted(cpus.begin(), cpus.end()));
+    EXPECT_EQ(std::adjacent_find(cpus.begin(), cpus.end()), cpus.end());
+}
+
+TEST(ThreadUtilPinCurrentThread, RestrictsAffinity) {
+    auto cpus = thread_util::availableCpus();
+    std::vector<int> pinnedCpus;
+    int status = 1;
+    std::thread thread([&] {
+        status = thread_util::pinCurrentThread(cpus.back());
+        pinnedCpus = thread_util::availableCpus();
+    });
+    thread.join();
+#ifdef __linux__
+    ASSERT_EQ(status, 0);
+    EXPECT_EQ(pinnedCpus, std::vector<int>({cpus.back()}));
+#endif
+    //Pinning another thread does not change the CPUs of the calling thread
+    EXPECT_EQ(thread_util::availableCpus(), cpus);
+}
+
+TEST(ThreadUtilParseCpuList, Ranges) {
+    EXPECT_EQ(thread_util::parseCpuList("0-3,8,10-11\n"), std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(thread_util::parseCpuList("5"), std::vector<int>({5}));
+    EXPECT_TRUE(thread_util::parseCpuList("\n").empty());
+    EXPECT_TRUE(thread_util::parseCpuList("3-1").empty());
+    EXPECT_TRUE(thread_util::parseCpuList("0-a").empty());
+}
+
+TEST(ThreadUtilNumaNodes, CoverAvailableCpus) {
+    auto nodes = thread_util::numaNodes();
+    ASSERT_FALSE(nodes.empty());
+    std::vector<int> cpus;
+    for (auto &node : nodes) {
+        EXPECT_FALSE(node.empty());
+        cpus.insert(cpus.end(), node.begin(), node.end());
+    }
+    std::sort(cpus.begin(), cpus.end());
+    EXPECT_EQ(cpus, thread_util::availableCpus());
+}